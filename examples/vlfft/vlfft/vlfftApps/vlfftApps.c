@@ -80,8 +80,9 @@ extern STMHandle *pSTMHandle;
 void     genFFTTestData( float *inData );
 void     TSC_enable();
 unsigned long long TSC_read();
-void     dft(Uint32 fftSize, float *pIn, float *pOut, Uint32 numSamplesToCompare);
-Uint32   compare_float( Uint32 n, float *pIn0, float *pIn1 );
+
+#define VLFFT_ENERGY_TOLERANCE 1e-4
+#define VLFFT_MIN_SNR_DB       60.0
 
 
 
@@ -116,6 +117,11 @@ float fftOutBuf[1024*2];
 //float fftOutBuf[512*2];
 
 
+/* the cores hand the passes off here, see vlfftBarrier.c */
+#pragma DATA_ALIGN(vlfftBarrier, VLFFT_CACHE_LINE_BYTES);
+#pragma DATA_SECTION(vlfftBarrier, ".sharedMEM");
+vlfftBarrier_t vlfftBarrier;
+
 #pragma DATA_ALIGN(inData, 8);
 #pragma DATA_SECTION(inData, ".externalMEM");
 float inData[VLFFT_N1*VLFFT_N2*2];
@@ -129,9 +135,12 @@ float outData[VLFFT_N1*VLFFT_N2*2];
 #pragma DATA_SECTION(workBufExternal, ".externalMEM");
 float workBufExternal[VLFFT_N1*VLFFT_N2*2];
 
-#pragma DATA_ALIGN(testData, 8);
-#pragma DATA_SECTION(testData, ".externalMEM");
-float testData[VLFFT_N1*VLFFT_N2*2];
+/* double precision reference FFT of inData and its twiddles, 4N     */
+/* doubles: with inData, outData and workBufExternal 56 MB at 1M     */
+/* points, inside the 64 MB DDR_1 segment .externalMEM is mapped to  */
+#pragma DATA_ALIGN(validateWork, 8);
+#pragma DATA_SECTION(validateWork, ".externalMEM");
+double validateWork[VLFFT_REFERENCE_WORK_SIZE(VLFFT_N1*VLFFT_N2)];
 
 
 
@@ -241,7 +250,8 @@ Void vlfft_master(UArg arg0, UArg arg1)
     vlfftMessageQParams_t messageQParams;
 
 
-    Uint32           fftLoop;
+    Uint32           fftLoop, numFFTs, indexCore;
+    Uint32           barrierSense = 0;
 
     VLFFTparams_t    VLFFTparams;
     DMAparams_t      DMAparams;
@@ -249,7 +259,9 @@ Void vlfft_master(UArg arg0, UArg arg1)
     float            *ptrIn, *ptrOut;
  
 
-    double           fftTime;
+    double           fftTime, energyErr;
+    vlfftErrorStats_t errorStats;
+    Int32            status;
     unsigned long long timer0, timer1;
 
 
@@ -299,6 +311,9 @@ Void vlfft_master(UArg arg0, UArg arg1)
     }
     initMessageQueues( &messageQParams, VLFFTparams.maxNumCores );
 
+    /* ready before the sync below lets the other cores go */
+    vlfftBarrierInit( &vlfftBarrier, VLFFTparams.numCoresForFftCompute );
+
 //System_printf("Ques initiated! \n");
 
 
@@ -340,9 +355,19 @@ Void vlfft_master(UArg arg0, UArg arg1)
     System_printf("The test is starting! \n");
 #endif
 
+    /********************************************************************/
+    /*    one message starts all the FFTs on the other cores, the       */
+    /*    passes are then handed off at the barrier, not by messages    */
+    /********************************************************************/
+    numFFTs = 1;    // or NUM_FFT_TO_COMPUTE
+    if( VLFFTparams.numCoresForFftCompute > 1 ) {
+        for(indexCore=1; indexCore<VLFFTparams.numCoresForFftCompute; indexCore++)
+            messageQParams.msg[indexCore]->numFFTs = numFFTs;
+        broadcastMessages(  &messageQParams, VLFFTparams.numCoresForFftCompute, VLFFTparams.numCoresForFftCompute, VLFFT_PROCESS_1stITER );
+    }
+
 fftTime = 0.0;
-//for(fftLoop=0; fftLoop<NUM_FFT_TO_COMPUTE; fftLoop++)
-for(fftLoop=0; fftLoop<1; fftLoop++)
+for(fftLoop=0; fftLoop<numFFTs; fftLoop++)
    {
 #ifdef ENABLE_PRINTF
     System_printf("   start of loop: %d \n", fftLoop);
@@ -359,12 +384,6 @@ for(fftLoop=0; fftLoop<1; fftLoop++)
     timer0 = TSC_read();
 #endif
 
-    /********************************************************************/
-    /*    send messages to others cores to start 1st iteration of ffts  */
-    /********************************************************************/
-    if( VLFFTparams.numCoresForFftCompute > 1 )
-        broadcastMessages(  &messageQParams, VLFFTparams.numCoresForFftCompute, VLFFTparams.numCoresForFftCompute, VLFFT_PROCESS_1stITER );
-
     /***************************/
     /* 1st iter of FFT         */
     /***************************/
@@ -377,17 +396,10 @@ for(fftLoop=0; fftLoop<1; fftLoop++)
 #endif // #if ENABLE_VLFFT_PROCESSIN
 
     /******************************************************/
-    /*         receive messages from other cores          */
+    /*         wait for the other cores' 1st iteration    */
     /******************************************************/
     if( VLFFTparams.numCoresForFftCompute > 1 )
-        getAllMessages( &messageQParams, VLFFTparams.numCoresForFftCompute, VLFFTparams.numCoresForFftCompute );
-
-
-    /**************************************************************/
-    /*    send messages to others cores to start 2nd iteration    */
-    /**************************************************************/
-    if( VLFFTparams.numCoresForFftCompute > 1 )
-        broadcastMessages(  &messageQParams, VLFFTparams.numCoresForFftCompute, VLFFTparams.numCoresForFftCompute, VLFFT_PROCESS_2ndITER );
+        vlfftBarrierWait( &vlfftBarrier, 0, &barrierSense );
 
     /***************************/
     /* 2nd iter of FFT         */
@@ -401,7 +413,7 @@ for(fftLoop=0; fftLoop<1; fftLoop++)
 #endif  // #if ENABLE_VLFFT_PROCESSING
 
     if( VLFFTparams.numCoresForFftCompute > 1 )
-        getAllMessages( &messageQParams, VLFFTparams.numCoresForFftCompute, VLFFTparams.numCoresForFftCompute );
+        vlfftBarrierWait( &vlfftBarrier, 0, &barrierSense );
 
 #if ENABLE_BENCHMARKING
     timer1 = TSC_read();
@@ -415,6 +427,10 @@ for(fftLoop=0; fftLoop<1; fftLoop++)
 
    }    //end of fftLoop
 
+    /* the other cores return their messages when done */
+    if( VLFFTparams.numCoresForFftCompute > 1 )
+        getAllMessages( &messageQParams, VLFFTparams.numCoresForFftCompute, VLFFTparams.numCoresForFftCompute );
+
     /**************************************************************/
     /*    send messages to others cores to exit fft               */
     /**************************************************************/
@@ -428,19 +444,28 @@ for(fftLoop=0; fftLoop<1; fftLoop++)
     /***********************************/
 #ifdef ENABLE_PRINTF
     System_printf("The test is complete\n");
+    System_printf("  Avg timer per fft  =    %f ms \n",  fftTime  );
 #endif
-    printf("  Avg timer per fft  =    %f ms \n",  fftTime  );
 
 
     // compare vlfft result
 #ifdef ENABLE_SYSTEM_TRACE_LOGS
 	STMXport_logMsg(pSTMHandle, STM_CHAN_BENCHMARK, "Begin Library FFT for Comparison\0");
 #endif
-    dft(VLFFT_SIZE, inData, testData, 20);
+    energyErr = vlfftEnergyCheck( VLFFT_SIZE, inData, outData, 1.0 );
+    status    = vlfftReferenceFFT( VLFFT_SIZE, inData, VLFFT_FORWARD, 1.0, validateWork );
 #ifdef ENABLE_SYSTEM_TRACE_LOGS
 	STMXport_logMsg(pSTMHandle, STM_CHAN_BENCHMARK, "End Library FFT for Comparison\0");
 #endif
-    if( compare_float( 20*2, outData, testData) == 0 ){
+    vlfftCompareReference( VLFFT_SIZE, outData, validateWork, &errorStats );
+#ifdef ENABLE_PRINTF
+    // System_printf() has no %e: the energy error in parts per million
+    System_printf("  Energy check       =    %f ppm relative error \n", energyErr*1e6 );
+    System_printf("  Reference check    =    max abs error %f at bin %d, RMS %f, SNR %f dB \n",
+                  errorStats.maxAbsError, errorStats.maxErrorBin, errorStats.rmsError, errorStats.snrDb );
+#endif
+
+    if( status == 0 && energyErr <= VLFFT_ENERGY_TOLERANCE && errorStats.snrDb >= VLFFT_MIN_SNR_DB ){
 #ifdef ENABLE_PRINTF
          System_printf("   Success!!!   \n\n\n"  );
 #endif
@@ -479,6 +504,8 @@ Void vlfft_slave(UArg arg0, UArg arg1)
 
 
     Uint32           coreNum;
+    Uint32           fftLoop;
+    Uint32           barrierSense = 0;
 
     float            *ptrIn, *ptrOut;
 
@@ -579,9 +606,11 @@ while(1)
 #endif
       }
 
-    // 1st iteration processing
+    // both iterations of msg->numFFTs FFTs, handed off at the barrier
     if(mode == VLFFT_PROCESS_1stITER)
       {
+        for(fftLoop=0; fftLoop<msg->numFFTs; fftLoop++)
+          {
 #if ENABLE_VLFFT_PROCESSING
             /******************************************************/
             /*      configure EDMA for 1st iteration of FFTs      */
@@ -591,14 +620,9 @@ while(1)
             ptrIn  = inData;
             ptrOut = workBufExternal;
             VLFFT_1stIter( ptrIn, ptrOut, &VLFFTparams, &VLFFTbuffers, &DMAparams, coreNum);
-#endif 
-            msg->mode = VLFFT_OK;
-       }  // if(msg.mode == VLFFT_PROCESS_1stITER)
-
+#endif
+            vlfftBarrierWait( &vlfftBarrier, coreNum, &barrierSense );
 
-    // 2nd iteration processing
-    if(mode == VLFFT_PROCESS_2ndITER)
-      {
            /******************************************************/
            /*      configure EDMA for 2nd iteration of FFTs      */
            /******************************************************/
@@ -609,8 +633,10 @@ while(1)
             ptrOut = outData;
             VLFFT_2ndIter( ptrIn, ptrOut, &VLFFTparams, &VLFFTbuffers, &DMAparams, coreNum);
 #endif
+            vlfftBarrierWait( &vlfftBarrier, coreNum, &barrierSense );
+          }
             msg->mode = VLFFT_OK;
-     }  // if(msg.mode == VLFFT_PROCESS_2ndITER)
+       }  // if(msg.mode == VLFFT_PROCESS_1stITER)
 
 
     if(mode == VLFFT_EXIT){
@@ -0,0 +1,178 @@
+/*
+ * vlfftBluesteinSize()
+ * vlfftBluesteinInit()
+ * vlfftBluesteinExecute()
+ *
+ *    N-point FFTs for the N the N1 x N2 passes cannot split, with a prime
+ *    factor above VLFFT_BATCH_MAX_RADIX or no two factors of 8 or more, as
+ *    Bluestein's chirp-z convolution.  With nk = (n^2 + k^2 - (k-n)^2)/2 and the chirp
+ *    c[n] = W_N^(n^2/2),
+ *
+ *       X[k] = c[k] * sum_n ( x[n]*c[n] ) * conj( c[k-n] )
+ *
+ *    a convolution of length 2N-1, computed circularly through M-point
+ *    plans, M >= 2N-1 any size the passes take.  The spectrum of conj(c),
+ *    over M, is computed once per plan.  The chirp products run on the
+ *    calling thread, the M-point FFTs on the cores
+ *
+ * Copyright (C) {2011} Texas Instruments Incorporated - http://www.ti.com/
+ *
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *    Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ *    Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the
+ *    distribution.
+ *
+ *    Neither the name of Texas Instruments Incorporated nor the names of
+ *    its contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ *  A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ *  OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *  SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *  LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ *  DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ *  THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ *  (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ *  OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+*/
+
+
+#include <string.h>
+#include <math.h>
+
+#include "vlfftHostStd.h"
+
+/* vlfft.h */
+#include "../vlfftInc/vlfftDebug.h"
+#include "../vlfftInc/vlfftMessgQ.h"
+#include "../vlfftInc/vlfft.h"
+#include "../vlfftInc/vlfftconfig.h"
+#include "vlfftHost.h"
+
+
+/****************************************/
+/*  smallest M >= 2N-1 the passes take  */
+/*  on numCores cores, 0 if none        */
+/****************************************/
+Uint32 vlfftBluesteinSize( Uint32 N, Uint32 numCores ) {
+	VLFFTconfig_t VLFFTconfig;
+	Uint32 M;
+
+	if( N > (1U<<(VLFFT_MAX_LOG2_SIZE-1)) )
+		return 0;
+
+	// multiples of 16 only, to keep the search short
+	for( M=(2*N+14)&~15U; M<=(1U<<VLFFT_MAX_LOG2_SIZE); M+=16 )
+		if( vlfftConfigSelect( &VLFFTconfig, M, numCores ) == 0 )
+			return M;
+	return 0;
+}
+
+
+/* a*b of complex samples, imag first */
+static inline void cmul( float *pOut, const float *a, const float *b ) {
+	float re, im;
+
+	re = a[1]*b[1] - a[0]*b[0];
+	im = a[1]*b[0] + a[0]*b[1];
+	pOut[0] = im;
+	pOut[1] = re;
+}
+
+
+/****************************************/
+/*  chirp and its spectrum for the      */
+/*  plan's N and direction, and the     */
+/*  convolution buffers; convFwd and    */
+/*  convInv are the unscaled M-point    */
+/*  plans.  Returns 0, -1 if out of     */
+/*  memory                              */
+/****************************************/
+Int32 vlfftBluesteinInit( vlfft_plan_t *plan, vlfft_plan_t *convFwd, vlfft_plan_t *convInv ) {
+	Uint32 N, M, n;
+	unsigned long long nn;
+	double theta;
+	const double PI = 3.141592654;
+	const double sign = (plan->VLFFTconfig.direction == VLFFT_INVERSE) ? -1.0 : 1.0;
+
+	N = plan->VLFFTconfig.N;
+	M = convFwd->VLFFTconfig.N;
+
+	plan->convFwd    = convFwd;
+	plan->convInv    = convInv;
+	plan->pChirp     = (float *)vlfftHostAlloc( (size_t)N*BYTES_PER_COMPLEX_SAMPLE );
+	plan->pChirpSpec = (float *)vlfftHostAlloc( (size_t)M*BYTES_PER_COMPLEX_SAMPLE );
+	plan->pConv      = (float *)vlfftHostAlloc( (size_t)M*BYTES_PER_COMPLEX_SAMPLE );
+	plan->pConvSpec  = (float *)vlfftHostAlloc( (size_t)M*BYTES_PER_COMPLEX_SAMPLE );
+	if( plan->pChirp == NULL || plan->pChirpSpec == NULL || plan->pConv == NULL || plan->pConvSpec == NULL )
+		return -1;
+
+	// n^2 mod 2N keeps the angle exact
+	for( n=0; n<N; n++ ) {
+		nn    = ((unsigned long long)n*n) % (2*(unsigned long long)N);
+		theta = PI * (double)nn / N;
+		plan->pChirp[2*n  ] = (float)(-sign*sin( theta ));
+		plan->pChirp[2*n+1] = (float)  cos( theta );
+	}
+
+	// conj(c) at -(N-1) .. N-1, wrapped around M
+	memset( plan->pConv, 0, (size_t)M*BYTES_PER_COMPLEX_SAMPLE );
+	for( n=0; n<N; n++ ) {
+		plan->pConv[2*n  ] = -plan->pChirp[2*n];
+		plan->pConv[2*n+1] =  plan->pChirp[2*n+1];
+		if( n != 0 ) {
+			plan->pConv[2*(M-n)  ] = -plan->pChirp[2*n];
+			plan->pConv[2*(M-n)+1] =  plan->pChirp[2*n+1];
+		}
+	}
+	vlfft_execute( convFwd, plan->pConv, plan->pChirpSpec );
+
+	// the 1/M of the inverse
+	for( n=0; n<2*M; n++ )
+		plan->pChirpSpec[n] /= (float)M;
+
+	return 0;
+}
+
+
+/****************************************/
+/*  pIn -> pOut, N points, through the  */
+/*  plan's convolution buffers          */
+/****************************************/
+void vlfftBluesteinExecute( vlfft_plan_t *plan, const float *pIn, float *pOut ) {
+	Uint32 N, M, n;
+	float  scale;
+
+	N = plan->VLFFTconfig.N;
+	M = plan->convFwd->VLFFTconfig.N;
+	scale = 1.0f;
+	if( plan->VLFFTconfig.direction == VLFFT_INVERSE && plan->VLFFTconfig.scaleInverse )
+		scale = 1.0f/(float)N;
+
+	for( n=0; n<N; n++ )
+		cmul( &plan->pConv[2*n], &pIn[2*n], &plan->pChirp[2*n] );
+	memset( &plan->pConv[2*N], 0, (size_t)(M-N)*BYTES_PER_COMPLEX_SAMPLE );
+
+	vlfft_execute( plan->convFwd, plan->pConv, plan->pConvSpec );
+	for( n=0; n<M; n++ )
+		cmul( &plan->pConvSpec[2*n], &plan->pConvSpec[2*n], &plan->pChirpSpec[2*n] );
+	vlfft_execute( plan->convInv, plan->pConvSpec, plan->pConv );
+
+	for( n=0; n<N; n++ ) {
+		cmul( &pOut[2*n], &plan->pConv[2*n], &plan->pChirp[2*n] );
+		pOut[2*n  ] *= scale;
+		pOut[2*n+1] *= scale;
+	}
+}
@@ -0,0 +1,251 @@
+/*
+ * vlfftSpectrumMultiply()
+ * vlfftConvInit()
+ * vlfftConvExecute()
+ * vlfft_conv_stream()
+ * vlfft_conv_reset()
+ * vlfft_conv_stats()
+ *
+ *    Fast convolution and correlation on the host.  A convolution plan is
+ *    an out of place N-point forward plan whose 2nd iteration multiplies
+ *    each block by the filter spectrum before it leaves for DDR, so a
+ *    filtered window takes one forward and one inverse run and no pass of
+ *    its own for the multiply.  vlfft_conv_stream() filters an unbounded
+ *    input by overlap-save, N-filterLen+1 new outputs per window
+ *
+ * Copyright (C) {2011} Texas Instruments Incorporated - http://www.ti.com/
+ *
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *    Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ *    Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the
+ *    distribution.
+ *
+ *    Neither the name of Texas Instruments Incorporated nor the names of
+ *    its contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ *  A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ *  OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *  SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *  LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ *  DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ *  THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ *  (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ *  OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+*/
+
+
+#include <string.h>
+
+#include "vlfftHostStd.h"
+
+/* vlfft.h */
+#include "../vlfftInc/vlfftDebug.h"
+#include "../vlfftInc/vlfftMessgQ.h"
+#include "../vlfftInc/vlfft.h"
+#include "../vlfftInc/vlfftconfig.h"
+#include "vlfftHost.h"
+
+
+/****************************************/
+/*  pInOut[n] *= pH[n], complex samples */
+/*  imag first                          */
+/****************************************/
+void vlfftSpectrumMultiply( float *restrict pInOut, const float *restrict pH, size_t numSamples ) {
+	size_t n;
+	float  re, im;
+
+	for( n=0; n<numSamples; n++ ) {
+		re = pInOut[2*n+1]*pH[2*n+1] - pInOut[2*n]*pH[2*n];
+		im = pInOut[2*n+1]*pH[2*n] + pInOut[2*n]*pH[2*n+1];
+		pInOut[2*n  ] = im;
+		pInOut[2*n+1] = re;
+	}
+}
+
+
+/****************************************/
+/*  filter spectrum of the plan's       */
+/*  engine, permuted to the order the   */
+/*  2nd iteration writes its blocks in, */
+/*  and handed to every core; the       */
+/*  unscaled inverse and the window     */
+/*  buffers.  Correlating takes the     */
+/*  conjugate filter reversed.  Returns */
+/*  0, -1 if out of memory              */
+/****************************************/
+Int32 vlfftConvInit( vlfft_plan_t *plan, const float *pFilter, Uint32 filterLen, Bool correlate ) {
+	VLFFTparams_t *VLFFTparams;
+	size_t N, N1, N2, spb, blk, k2, b, src, dst, n;
+	Uint32 coreNum;
+	const float invN = 1.0f/(float)plan->VLFFTconfig.N;
+
+	N   = plan->VLFFTconfig.N;
+	N1  = plan->VLFFTconfig.N1;
+	N2  = plan->VLFFTconfig.N2;
+	spb = plan->VLFFTconfig.samplesPerBlock;
+
+	plan->convInv     = vlfft_plan_create_inverse( (Uint32)N, plan->engine.numCores, FALSE );
+	plan->filterLen   = filterLen;
+	plan->pFilterSpec = (float *)vlfftHostAlloc( N*BYTES_PER_COMPLEX_SAMPLE );
+	plan->pConv       = (float *)vlfftHostAlloc( N*BYTES_PER_COMPLEX_SAMPLE );
+	plan->pConvSpec   = (float *)vlfftHostAlloc( N*BYTES_PER_COMPLEX_SAMPLE );
+	plan->pHistory    = (float *)vlfftHostAlloc( (size_t)filterLen*BYTES_PER_COMPLEX_SAMPLE );
+	if( plan->convInv == NULL || plan->pFilterSpec == NULL || plan->pConv == NULL ||
+	    plan->pConvSpec == NULL || plan->pHistory == NULL )
+		return -1;
+
+	memset( plan->pConv, 0, N*BYTES_PER_COMPLEX_SAMPLE );
+	if( correlate ) {
+		for( n=0; n<filterLen; n++ ) {
+			plan->pConv[2*n  ] = -pFilter[2*(filterLen-1-n)  ];
+			plan->pConv[2*n+1] =  pFilter[2*(filterLen-1-n)+1];
+		}
+	} else {
+		memcpy( plan->pConv, pFilter, (size_t)filterLen*BYTES_PER_COMPLEX_SAMPLE );
+	}
+
+	// no spectrum handed out yet: a plain forward FFT
+	vlfftHostEngineRun( &plan->engine, plan->pConv, plan->pWork, plan->pConvSpec );
+
+	// block blk of pass 2 holds k1 = blk*spb+b, k2 = 0 .. N2-1 as [k2][b]
+	for( blk=0; blk<N1/spb; blk++ ) {
+		for( k2=0; k2<N2; k2++ ) {
+			for( b=0; b<spb; b++ ) {
+				src = blk*spb + b + N1*k2;
+				dst = (blk*N2 + k2)*spb + b;
+				plan->pFilterSpec[2*dst  ] = plan->pConvSpec[2*src  ]*invN;
+				plan->pFilterSpec[2*dst+1] = plan->pConvSpec[2*src+1]*invN;
+			}
+		}
+	}
+
+	// each core's pass 2 output starts at its offset2ndIterOut
+	for( coreNum=0; coreNum<plan->engine.numCores; coreNum++ ) {
+		VLFFTparams = &plan->engine.core[coreNum].VLFFTparams;
+		VLFFTparams->pFilterSpec = plan->pFilterSpec +
+		                           2*(VLFFTparams->offset2ndIterOut/BYTES_PER_COMPLEX_SAMPLE)*N2;
+	}
+
+	vlfft_conv_reset( plan );
+	return 0;
+}
+
+
+/****************************************/
+/*  circular convolution of the N       */
+/*  samples of pIn with the filter into */
+/*  pOut, which may be pIn              */
+/****************************************/
+void vlfftConvExecute( vlfft_plan_t *plan, float *pIn, float *pOut ) {
+	vlfftHostEngineRun( &plan->engine, pIn, plan->pWork, plan->pConvSpec );
+	vlfft_execute( plan->convInv, plan->pConvSpec, pOut );
+}
+
+
+
+/****************************************/
+/*  next numSamples outputs of the      */
+/*  filter into pOut, which must not    */
+/*  overlap pIn, from the next          */
+/*  numSamples inputs in pIn.  Every    */
+/*  window is the filterLen-1 samples   */
+/*  before its outputs and N-filterLen  */
+/*  +1 new ones, read in place when     */
+/*  they are all in pIn, else staged    */
+/*  with the history and zero padded.   */
+/*  Correlations come out filterLen-1   */
+/*  samples late.  Returns 0, -1 if not */
+/*  a convolution plan                  */
+/****************************************/
+Int32 vlfft_conv_stream( vlfft_plan_t *plan, float *pIn, Uint32 numSamples, float *pOut ) {
+	size_t N, L1, hop, pos, num, n;
+	long long idx;
+	float  *pWin;
+	unsigned long long startNs;
+
+	if( plan->type != VLFFT_PLAN_CONV )
+		return -1;
+
+	N       = plan->VLFFTconfig.N;
+	L1      = plan->filterLen - 1;
+	hop     = N - L1;
+	startNs = vlfftProfileNowNs();
+
+	for( pos=0; pos<numSamples; pos+=num ) {
+		num = numSamples - pos < hop ? numSamples - pos : hop;
+
+		if( pos >= L1 && num == hop ) {
+			pWin = pIn + 2*(pos - L1);
+		} else {
+			pWin = plan->pConv;
+			for( n=0; n<N; n++ ) {
+				idx = (long long)(pos + n) - (long long)L1;
+				if( idx < 0 ) {
+					pWin[2*n  ] = plan->pHistory[2*(L1+idx)  ];
+					pWin[2*n+1] = plan->pHistory[2*(L1+idx)+1];
+				} else if( idx < (long long)numSamples ) {
+					pWin[2*n  ] = pIn[2*idx  ];
+					pWin[2*n+1] = pIn[2*idx+1];
+				} else {
+					pWin[2*n  ] = 0.0f;
+					pWin[2*n+1] = 0.0f;
+				}
+			}
+		}
+
+		// the first L1 outputs of the window wrap around
+		vlfftConvExecute( plan, pWin, plan->pConvSpec );
+		memcpy( pOut + 2*pos, plan->pConvSpec + 2*L1, num*BYTES_PER_COMPLEX_SAMPLE );
+		plan->convStats.numBlocks++;
+	}
+
+	// the last L1 inputs, part of them from the history if this was short
+	if( numSamples >= L1 ) {
+		memcpy( plan->pHistory, pIn + 2*((size_t)numSamples - L1), L1*BYTES_PER_COMPLEX_SAMPLE );
+	} else {
+		memmove( plan->pHistory, plan->pHistory + 2*(size_t)numSamples, (L1 - numSamples)*BYTES_PER_COMPLEX_SAMPLE );
+		memcpy( plan->pHistory + 2*(L1 - numSamples), pIn, (size_t)numSamples*BYTES_PER_COMPLEX_SAMPLE );
+	}
+
+	plan->convStats.numSamples += numSamples;
+	plan->convStats.totalMs    += (vlfftProfileNowNs() - startNs)/1e6;
+
+	return 0;
+}
+
+
+/****************************************/
+/*  start a new stream: zero history,   */
+/*  zero statistics                     */
+/****************************************/
+void vlfft_conv_reset( vlfft_plan_t *plan ) {
+	if( plan->filterLen > 1 )
+		memset( plan->pHistory, 0, ((size_t)plan->filterLen - 1)*BYTES_PER_COMPLEX_SAMPLE );
+	memset( &plan->convStats, 0, sizeof(plan->convStats) );
+}
+
+
+/****************************************/
+/*  samples filtered, windows and time  */
+/*  since the plan was made or the last */
+/*  reset, and the throughput           */
+/****************************************/
+void vlfft_conv_stats( vlfft_plan_t *plan, vlfftConvStats_t *pStats, Bool reset ) {
+	*pStats = plan->convStats;
+	pStats->samplesPerSec = pStats->totalMs > 0.0 ? pStats->numSamples/(pStats->totalMs/1000.0) : 0.0;
+	if( reset )
+		memset( &plan->convStats, 0, sizeof(plan->convStats) );
+}
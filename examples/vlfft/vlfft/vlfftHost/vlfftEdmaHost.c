@@ -0,0 +1,332 @@
+/*
+ * vlfftEdmaHostCreate()
+ * vlfftEdmaHostDelete()
+ * vlfftEdmaHostStats()
+ * vlfftEdmaTransfer()
+ * EDMA3_DRV_setPaRAM()
+ * vlfftEdmaConfig_srcAddrdstAddr_aCntbCntcCnt()
+ * vlfftEdmaConfig_srcAddrdstAddr()
+ * edmaTrigger()
+ * edmaPoll()
+ * vlfftHostDmaInit()
+ * vlfftHostDmaDelete()
+ * vlfftEdmaHostEnabled()
+ *
+ *    Software EDMA3 for the host build: one copy thread per emulated
+ *    controller plays the transfer controller.  PaRAM sets are 3D
+ *    aCnt x bCnt x cCnt transfers with BIDX/CIDX, A or AB synchronized,
+ *    a trigger is one sync event.  On completion (intermediate or final)
+ *    the TCC is either chained to the channel of the same number or
+ *    latched for edmaPoll(), as the OPT bits select.  Linking is not
+ *    emulated.  Addresses are host pointers (UArg) instead of the 32 bit
+ *    DSP addresses, and the counts and indexes are not limited to the 16
+ *    bits of a PaRAM field.
+ *
+ *    edmaPoll() times how long the caller is blocked and the copy thread
+ *    times its transfers, see vlfftEdmaHostStats()
+ *
+ * Copyright (C) {2011} Texas Instruments Incorporated - http://www.ti.com/
+ *
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *    Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ *    Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the
+ *    distribution.
+ *
+ *    Neither the name of Texas Instruments Incorporated nor the names of
+ *    its contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ *  A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ *  OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *  SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *  LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ *  DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ *  THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ *  (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ *  OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+*/
+
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "vlfftHostStd.h"
+
+/* vlfft.h */
+#include "../vlfftInc/vlfftDebug.h"
+#include "../vlfftInc/vlfftMessgQ.h"
+#include "../vlfftInc/vlfft.h"
+#include "../vlfftInc/vlfftconfig.h"
+#include "vlfftHost.h"
+
+
+static double edmaNowMs( void ) {
+	struct timespec ts;
+
+	clock_gettime( CLOCK_MONOTONIC, &ts );
+	return ts.tv_sec*1000.0 + ts.tv_nsec/1000000.0;
+}
+
+
+/*********************************************************/
+/*  one sync event on a PaRAM set: a frame of bCnt       */
+/*  arrays (AB sync) or a single array (A sync); the set */
+/*  is updated as the hardware does, returns 1 once the  */
+/*  last event of the transfer has been done             */
+/*********************************************************/
+static int edmaSyncEvent( EDMA3_DRV_PaRAMRegs *p ) {
+	Uint32 b;
+
+	if( p->opt & (1 << OPT_SYNCDIM_SHIFT) ) {
+		for( b=0; b<p->bCnt; b++ )
+			memcpy( (char *)p->destAddr + (intptr_t)b*p->destBIdx, (const char *)p->srcAddr + (intptr_t)b*p->srcBIdx, p->aCnt );
+		p->srcAddr  += p->srcCIdx;
+		p->destAddr += p->destCIdx;
+		return --p->cCnt == 0;
+	}
+
+	memcpy( (char *)p->destAddr, (const char *)p->srcAddr, p->aCnt );
+	if( --p->bCnt != 0 ) {
+		p->srcAddr  += p->srcBIdx;
+		p->destAddr += p->destBIdx;
+		return 0;
+	}
+	// CIDX is from the last array of a frame to the first of the next
+	p->bCnt      = p->bCntReload;
+	p->srcAddr  += p->srcCIdx;
+	p->destAddr += p->destCIdx;
+	return --p->cCnt == 0;
+}
+
+
+static size_t edmaEventBytes( const EDMA3_DRV_PaRAMRegs *p ) {
+	return (p->opt & (1 << OPT_SYNCDIM_SHIFT)) ? (size_t)p->aCnt*p->bCnt : p->aCnt;
+}
+
+
+static void *edmaCopyThread( void *arg ) {
+	EDMA3_DRV_Handle    hEdma = (EDMA3_DRV_Handle)arg;
+	EDMA3_DRV_PaRAMRegs p;
+	Uint32              chId, tcc;
+	size_t              numBytes;
+	double              t0;
+	int                 last;
+
+	pthread_mutex_lock( &hEdma->lock );
+
+	while( 1 ) {
+		while( !hEdma->exit && hEdma->pending == 0 )
+			pthread_cond_wait( &hEdma->trigger, &hEdma->lock );
+		if( hEdma->exit )
+			break;
+
+		// lowest channel first, as the queue priority would
+		for( chId=0; !(hEdma->pending & (1U << chId)); chId++ );
+		hEdma->pending &= ~(1U << chId);
+		p = hEdma->paRAM[chId];
+		pthread_mutex_unlock( &hEdma->lock );
+
+		t0       = edmaNowMs();
+		numBytes = edmaEventBytes( &p );
+		last     = edmaSyncEvent( &p );
+		t0       = edmaNowMs() - t0;
+
+		pthread_mutex_lock( &hEdma->lock );
+		hEdma->paRAM[chId] = p;
+		hEdma->stats.busyMs   += t0;
+		hEdma->stats.numBytes += numBytes;
+		hEdma->stats.numEvents++;
+
+		tcc = (p.opt & OPT_TCC_MASK) >> OPT_TCC_SHIFT;
+		if( p.opt & (1 << (last ? OPT_TCCHEN_SHIFT : OPT_ITCCHEN_SHIFT)) )
+			hEdma->pending |= 1U << tcc;
+		if( p.opt & (1 << (last ? OPT_TCINTEN_SHIFT : OPT_ITCINTEN_SHIFT)) ) {
+			hEdma->ipr |= 1U << tcc;
+			pthread_cond_broadcast( &hEdma->complete );
+		}
+	}
+
+	pthread_mutex_unlock( &hEdma->lock );
+	return NULL;
+}
+
+
+/****************************************************************/
+/*    returns 0 on success, -1 if the copy thread could not be  */
+/*    created                                                   */
+/****************************************************************/
+Int32 vlfftEdmaHostCreate( EDMA3_DRV_Handle *phEdma ) {
+	EDMA3_DRV_Handle hEdma;
+
+	hEdma = (EDMA3_DRV_Handle)calloc( 1, sizeof(*hEdma) );
+	if( hEdma == NULL )
+		return -1;
+
+	pthread_mutex_init( &hEdma->lock, NULL );
+	pthread_cond_init( &hEdma->trigger, NULL );
+	pthread_cond_init( &hEdma->complete, NULL );
+
+	if( pthread_create( &hEdma->thread, NULL, edmaCopyThread, hEdma ) != 0 ) {
+		free( hEdma );
+		return -1;
+	}
+
+	*phEdma = hEdma;
+	return 0;
+}
+
+
+void vlfftEdmaHostDelete( EDMA3_DRV_Handle hEdma ) {
+	pthread_mutex_lock( &hEdma->lock );
+	hEdma->exit = TRUE;
+	pthread_cond_signal( &hEdma->trigger );
+	pthread_mutex_unlock( &hEdma->lock );
+
+	pthread_join( hEdma->thread, NULL );
+	pthread_mutex_destroy( &hEdma->lock );
+	pthread_cond_destroy( &hEdma->trigger );
+	pthread_cond_destroy( &hEdma->complete );
+	free( hEdma );
+}
+
+
+/* statistics since the last reset */
+void vlfftEdmaHostStats( EDMA3_DRV_Handle hEdma, vlfftEdmaStats_t *pStats, Bool reset ) {
+	pthread_mutex_lock( &hEdma->lock );
+	*pStats = hEdma->stats;
+	if( reset )
+		memset( &hEdma->stats, 0, sizeof(hEdma->stats) );
+	pthread_mutex_unlock( &hEdma->lock );
+}
+
+
+/*********************************************************/
+/*  a whole PaRAM set at once by the calling thread, for */
+/*  running without a copy thread                        */
+/*********************************************************/
+void vlfftEdmaTransfer( const EDMA3_DRV_PaRAMRegs *pParamSet ) {
+	EDMA3_DRV_PaRAMRegs p = *pParamSet;
+
+	if( p.aCnt == 0 || p.bCnt == 0 || p.cCnt == 0 )
+		return;
+	while( !edmaSyncEvent( &p ) );
+}
+
+
+Int32 EDMA3_DRV_setPaRAM( EDMA3_DRV_Handle hEdma, Uint32 chId, const EDMA3_DRV_PaRAMRegs *pParamSet ) {
+	if( chId >= VLFFT_EDMA_NUM_CHANNELS )
+		return -1;
+
+	pthread_mutex_lock( &hEdma->lock );
+	hEdma->paRAM[chId] = *pParamSet;
+	pthread_mutex_unlock( &hEdma->lock );
+	return 0;
+}
+
+
+void vlfftEdmaConfig_srcAddrdstAddr_aCntbCntcCnt( EDMA3_DRV_Handle    hEdma,
+    EDMA3_DRV_PaRAMRegs *pParamSet,
+    Uint32              chId,
+    UArg                srcAddr,
+    UArg                dstAddr,
+    Uint32              aCnt,
+    Uint32              bCnt,
+    Uint32              cCnt ) {
+	pParamSet->srcAddr    = srcAddr;
+	pParamSet->destAddr   = dstAddr;
+	pParamSet->aCnt       = aCnt;
+	pParamSet->bCnt       = bCnt;
+	pParamSet->cCnt       = cCnt;
+
+	EDMA3_DRV_setPaRAM( hEdma, chId, pParamSet );
+}
+
+
+void vlfftEdmaConfig_srcAddrdstAddr( EDMA3_DRV_Handle hEdma, EDMA3_DRV_PaRAMRegs *pParamSet, Uint32 chId, UArg srcAddr, UArg dstAddr ) {
+	pParamSet->srcAddr    = srcAddr;
+	pParamSet->destAddr   = dstAddr;
+
+	EDMA3_DRV_setPaRAM( hEdma, chId, pParamSet );
+}
+
+
+void edmaTrigger( EDMA3_DRV_Handle hEdma, Uint32 chId ) {
+	pthread_mutex_lock( &hEdma->lock );
+	hEdma->pending |= 1U << chId;
+	pthread_cond_signal( &hEdma->trigger );
+	pthread_mutex_unlock( &hEdma->lock );
+}
+
+
+void edmaPoll( EDMA3_DRV_Handle hEdma, Uint32 tcc ) {
+	double t0 = edmaNowMs();
+
+	pthread_mutex_lock( &hEdma->lock );
+	while( !(hEdma->ipr & (1U << tcc)) )
+		pthread_cond_wait( &hEdma->complete, &hEdma->lock );
+	hEdma->ipr &= ~(1U << tcc);
+
+	hEdma->stats.pollWaitMs += edmaNowMs() - t0;
+	hEdma->stats.numPolls++;
+	pthread_mutex_unlock( &hEdma->lock );
+}
+
+
+/*********************************************************/
+/*  the two channels of a worker, as vlfftEdmaInit() and */
+/*  vlfftEdmaConfig_1stIter() set them up on the DSP:    */
+/*  ch0 moves a block in and chains to ch1, which moves  */
+/*  a block out and latches tcc1.  Without emulation     */
+/*  hEdma stays NULL and the worker copies the blocks    */
+/*********************************************************/
+Int32 vlfftHostDmaInit( vlfftHostDma_t *dma, Bool emulate ) {
+	memset( dma, 0, sizeof(*dma) );
+
+	dma->chId0 = 0;
+	dma->chId1 = 1;
+	dma->tcc1  = dma->chId1;
+
+	dma->paramSet0.opt  = (dma->chId1 << OPT_TCC_SHIFT) & OPT_TCC_MASK;
+	dma->paramSet0.opt |= 1 << OPT_TCCHEN_SHIFT;
+	dma->paramSet0.opt |= 1 << OPT_SYNCDIM_SHIFT;
+
+	dma->paramSet1.opt  = (dma->tcc1 << OPT_TCC_SHIFT) & OPT_TCC_MASK;
+	dma->paramSet1.opt |= 1 << OPT_TCINTEN_SHIFT;
+	dma->paramSet1.opt |= 1 << OPT_SYNCDIM_SHIFT;
+
+	dma->paramSet0.cCnt = dma->paramSet1.cCnt = 1;
+	dma->paramSet0.linkAddr = dma->paramSet1.linkAddr = 0xFFFFu;
+
+	if( emulate )
+		return vlfftEdmaHostCreate( &dma->hEdma );
+	return 0;
+}
+
+
+void vlfftHostDmaDelete( vlfftHostDma_t *dma ) {
+	if( dma->hEdma != NULL )
+		vlfftEdmaHostDelete( dma->hEdma );
+	dma->hEdma = NULL;
+}
+
+
+/* VLFFT_EDMA=1 in the environment runs the workers on emulated EDMA */
+Bool vlfftEdmaHostEnabled( void ) {
+	const char *env = getenv( "VLFFT_EDMA" );
+
+	return env != NULL && atoi( env ) != 0;
+}
@@ -0,0 +1,493 @@
+/*
+ * vlfft_execute_file()
+ *
+ *    Out-of-core FFT for captures larger than memory, 2^6 to 2^32 points.
+ *    Same four steps as the in-memory FFT: pass 1 reads slabs of whole
+ *    columns of the N1 x N2 input from its mmap'd file and writes rows of
+ *    the N2 x N1 intermediate file, pass 2 reads slabs of columns of the
+ *    intermediate and writes them to the same places in the output file.
+ *    The calling thread does the file I/O: while the workers compute slab
+ *    s it stores slab s-1 and loads slab s+1, so with enough cores the
+ *    disk is the limit.  The slab buffers are the only memory used, about
+ *    4 x VLFFT_FILE_SLAB_BYTES
+ *
+ * Copyright (C) {2011} Texas Instruments Incorporated - http://www.ti.com/
+ *
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *    Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ *    Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the
+ *    distribution.
+ *
+ *    Neither the name of Texas Instruments Incorporated nor the names of
+ *    its contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ *  A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ *  OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *  SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *  LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ *  DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ *  THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ *  (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ *  OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+*/
+
+
+#define _GNU_SOURCE
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <time.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <pthread.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+#include "vlfftHostStd.h"
+
+/* vlfft.h */
+#include "../vlfftInc/vlfftDebug.h"
+#include "../vlfftInc/vlfftMessgQ.h"
+#include "../vlfftInc/vlfft.h"
+#include "../vlfftInc/vlfftconfig.h"
+#include "vlfftHost.h"
+
+
+typedef struct {
+	struct vlfftFile *ff;
+	pthread_t  thread;
+	Uint32     coreNum;
+
+	float      *pWork0;
+	float      *pWork1;
+	float      *pAnchor;    // W_N^(n2*k1), k1 = 0, K, 2K .. of the FFT at hand
+} vlfftFileCore_t;
+
+typedef struct vlfftFile {
+	Uint32            numCores;
+	size_t            N;
+	Uint32            N1;
+	Uint32            N2;
+	Uint32            radix_1stIter;
+	Uint32            log4N_1stIter;
+	Uint32            radix_2ndIter;
+	Uint32            log4N_2ndIter;
+	float             *pW1;
+	float             *pW2;
+
+	const char        *pInMap;
+	char              *pWorkMap;
+	char              *pOutMap;
+
+	/* slab the workers compute between the barriers, */
+	/* pass 0 tells them to exit                       */
+	pthread_barrier_t startBarrier;
+	pthread_barrier_t doneBarrier;
+	volatile Uint32   pass;
+	float             *pSlabIn;
+	float             *pSlabOut;
+	size_t            col0;
+	Uint32            width;
+
+	vlfftFileCore_t   *core;
+} vlfftFile_t;
+
+typedef void (*vlfftFileIo_t)( vlfftFile_t *ff, float *pSlab, Uint32 slab );
+
+
+static double timeNowMs( void ) {
+	struct timespec ts;
+
+	clock_gettime( CLOCK_MONOTONIC, &ts );
+	return ts.tv_sec*1000.0 + ts.tv_nsec/1000000.0;
+}
+
+
+/*********************************************************/
+/*  inter-pass twiddles of input column n2: the step     */
+/*  W_N^n2 and the anchors W_N^(n2*k1) every             */
+/*  VLFFT_TWIDDLE_ANCHOR_STEP outputs, from a recurrence */
+/*  in double.  An N1 of 64K is too long for the float   */
+/*  recurrence of multTwiddle_vec_1_sa() alone           */
+/*********************************************************/
+static void fileTwiddles( const vlfftFile_t *ff, float *pAnchor, size_t n2, float *pWStepRe, float *pWStepIm ) {
+	const double PI = 3.14159265358979323846;
+	double theta, sRe, sIm, aRe, aIm, t;
+	Uint32 k1;
+
+	theta = 2.0*PI*(double)n2/(double)ff->N;
+	*pWStepRe = (float)cos( theta );
+	*pWStepIm = (float)-sin( theta );
+
+	theta = 2.0*PI*(double)((n2*VLFFT_TWIDDLE_ANCHOR_STEP) % ff->N)/(double)ff->N;
+	sRe = cos( theta );
+	sIm = -sin( theta );
+	aRe = 1.0;
+	aIm = 0.0;
+	for( k1=0; k1<ff->N1; k1+=VLFFT_TWIDDLE_ANCHOR_STEP ) {
+		*pAnchor++ = (float)aIm;
+		*pAnchor++ = (float)aRe;
+		t   = aRe*sRe - aIm*sIm;
+		aIm = aRe*sIm + aIm*sRe;
+		aRe = t;
+	}
+}
+
+
+/*********************************************************/
+/*  pass 1 on a slab of width input columns, N1 rows:    */
+/*  blocks of samplesPerBlock columns are transposed,    */
+/*  FFTed and twiddled into rows of the output slab      */
+/*********************************************************/
+static void filePass1( vlfftFile_t *ff, vlfftFileCore_t *core ) {
+	Uint32 blk, numBlks, col, fftIdx, N1 = ff->N1;
+	float  wStepRe, wStepIm, *pOut;
+
+	numBlks = ff->width/SAMPLES_PER_TRANSFER_BLOCK;
+
+	for( blk=core->coreNum; blk<numBlks; blk+=ff->numCores ) {
+		col = blk*SAMPLES_PER_TRANSFER_BLOCK;
+		vlfftTransposeStrided( ff->pSlabIn + 2*col, ff->width, core->pWork0, N1, N1, SAMPLES_PER_TRANSFER_BLOCK );
+
+		for( fftIdx=0; fftIdx<SAMPLES_PER_TRANSFER_BLOCK; fftIdx++ ) {
+			fileTwiddles( ff, core->pAnchor, ff->col0+col+fftIdx, &wStepRe, &wStepIm );
+			pOut = ff->pSlabOut + (size_t)2*N1*(col+fftIdx);
+
+			if( ff->radix_1stIter == 4 )
+				DSPF_sp_radix4_fftTwSPxSP( N1, &core->pWork0[2*N1*fftIdx], ff->pW1, pOut, ff->log4N_1stIter,
+				                           wStepRe, wStepIm, core->pAnchor, VLFFT_TWIDDLE_ANCHOR_STEP );
+			else
+				DSPF_sp_mixedRadix_fftTwSPxSP( N1, &core->pWork0[2*N1*fftIdx], ff->pW1, pOut,
+				                               wStepRe, wStepIm, core->pAnchor, VLFFT_TWIDDLE_ANCHOR_STEP );
+		}
+	}
+}
+
+
+/*********************************************************/
+/*  pass 2 on a slab of width intermediate columns, N2   */
+/*  rows, in place: transpose -> FFT -> transpose back   */
+/*********************************************************/
+static void filePass2( vlfftFile_t *ff, vlfftFileCore_t *core ) {
+	Uint32 blk, numBlks, col, fftIdx, N2 = ff->N2;
+
+	numBlks = ff->width/SAMPLES_PER_TRANSFER_BLOCK;
+
+	for( blk=core->coreNum; blk<numBlks; blk+=ff->numCores ) {
+		col = blk*SAMPLES_PER_TRANSFER_BLOCK;
+		vlfftTransposeStrided( ff->pSlabIn + 2*col, ff->width, core->pWork0, N2, N2, SAMPLES_PER_TRANSFER_BLOCK );
+
+		for( fftIdx=0; fftIdx<SAMPLES_PER_TRANSFER_BLOCK; fftIdx++ ) {
+			if( ff->radix_2ndIter == 4 )
+				DSPF_sp_radix4_fftSPxSP( N2, &core->pWork0[2*N2*fftIdx], ff->pW2, &core->pWork1[2*N2*fftIdx], ff->log4N_2ndIter );
+			else
+				DSPF_sp_mixedRadix_fftSPxSP( N2, &core->pWork0[2*N2*fftIdx], ff->pW2, &core->pWork1[2*N2*fftIdx] );
+		}
+
+		vlfftTransposeStrided( core->pWork1, N2, ff->pSlabIn + 2*col, ff->width, SAMPLES_PER_TRANSFER_BLOCK, N2 );
+	}
+}
+
+
+static void *fileWorker( void *arg ) {
+	vlfftFileCore_t *core = (vlfftFileCore_t *)arg;
+	vlfftFile_t     *ff   = core->ff;
+
+	vlfftHostPinToCpu( core->coreNum );
+
+	while(1) {
+		pthread_barrier_wait( &ff->startBarrier );
+		if( ff->pass == 0 )
+			break;
+
+		if( ff->pass == 1 )
+			filePass1( ff, core );
+		else
+			filePass2( ff, core );
+
+		pthread_barrier_wait( &ff->doneBarrier );
+	}
+
+	return NULL;
+}
+
+
+/* N1 rows of width samples, row pitch N2, from the input */
+static void fileLoad1( vlfftFile_t *ff, float *pSlab, Uint32 slab ) {
+	vlfftHostCopy2D( pSlab, (size_t)ff->width*BYTES_PER_COMPLEX_SAMPLE,
+	                 ff->pInMap + (size_t)slab*ff->width*BYTES_PER_COMPLEX_SAMPLE, (size_t)ff->N2*BYTES_PER_COMPLEX_SAMPLE,
+	                 (size_t)ff->width*BYTES_PER_COMPLEX_SAMPLE, ff->N1 );
+}
+
+/* width whole rows of the intermediate */
+static void fileStore1( vlfftFile_t *ff, float *pSlab, Uint32 slab ) {
+	size_t numBytes = (size_t)ff->width*ff->N1*BYTES_PER_COMPLEX_SAMPLE;
+
+	memcpy( ff->pWorkMap + (size_t)slab*numBytes, pSlab, numBytes );
+}
+
+/* N2 rows of width samples, row pitch N1, from the intermediate ... */
+static void fileLoad2( vlfftFile_t *ff, float *pSlab, Uint32 slab ) {
+	vlfftHostCopy2D( pSlab, (size_t)ff->width*BYTES_PER_COMPLEX_SAMPLE,
+	                 ff->pWorkMap + (size_t)slab*ff->width*BYTES_PER_COMPLEX_SAMPLE, (size_t)ff->N1*BYTES_PER_COMPLEX_SAMPLE,
+	                 (size_t)ff->width*BYTES_PER_COMPLEX_SAMPLE, ff->N2 );
+}
+
+/* ... and back to the same place in the output */
+static void fileStore2( vlfftFile_t *ff, float *pSlab, Uint32 slab ) {
+	vlfftHostCopy2D( ff->pOutMap + (size_t)slab*ff->width*BYTES_PER_COMPLEX_SAMPLE, (size_t)ff->N1*BYTES_PER_COMPLEX_SAMPLE,
+	                 pSlab, (size_t)ff->width*BYTES_PER_COMPLEX_SAMPLE,
+	                 (size_t)ff->width*BYTES_PER_COMPLEX_SAMPLE, ff->N2 );
+}
+
+
+/*********************************************************/
+/*  one pass over numSlabs slabs, the I/O of the slabs   */
+/*  before and after overlapping the compute of slab s;  */
+/*  pOut == pIn for the in place 2nd pass                */
+/*********************************************************/
+static void filePass( vlfftFile_t *ff, Uint32 pass, Uint32 width, Uint32 numSlabs, vlfftFileIo_t load, vlfftFileIo_t store,
+                      float *pIn[2], float *pOut[2], vlfftFileStats_t *pStats ) {
+	Uint32 slab, cur;
+	size_t slabBytes;
+	double timer0;
+
+	ff->width = width;
+	slabBytes = (size_t)width*(pass == 1 ? ff->N1 : ff->N2)*BYTES_PER_COMPLEX_SAMPLE;
+
+	timer0 = timeNowMs();
+	load( ff, pIn[0], 0 );
+	pStats->readMs += timeNowMs() - timer0;
+
+	for( slab=0; slab<numSlabs; slab++ ) {
+		cur = slab&0x1;
+		ff->pass     = pass;
+		ff->pSlabIn  = pIn[cur];
+		ff->pSlabOut = pOut[cur];
+		ff->col0     = (size_t)slab*width;
+		pthread_barrier_wait( &ff->startBarrier );
+
+		timer0 = timeNowMs();
+		if( slab > 0 )
+			store( ff, pOut[cur^1], slab-1 );
+		pStats->writeMs += timeNowMs() - timer0;
+
+		timer0 = timeNowMs();
+		if( slab+1 < numSlabs )
+			load( ff, pIn[cur^1], slab+1 );
+		pStats->readMs += timeNowMs() - timer0;
+
+		timer0 = timeNowMs();
+		pthread_barrier_wait( &ff->doneBarrier );
+		pStats->computeWaitMs += timeNowMs() - timer0;
+	}
+
+	timer0 = timeNowMs();
+	store( ff, pOut[(numSlabs-1)&0x1], numSlabs-1 );
+	pStats->writeMs += timeNowMs() - timer0;
+
+	pStats->numBytes += 2ULL*numSlabs*slabBytes;
+}
+
+
+/*********************************************************/
+/*  columns per slab: rows of at least                   */
+/*  VLFFT_FILE_MIN_ROW_BYTES so every page read is used  */
+/*  in full, more while the slab fits in                 */
+/*  VLFFT_FILE_SLAB_BYTES, at most numCols               */
+/*********************************************************/
+static Uint32 fileSlabWidth( Uint32 numRows, Uint32 numCols ) {
+	Uint32 width;
+
+	width = VLFFT_FILE_MIN_ROW_BYTES/BYTES_PER_COMPLEX_SAMPLE;
+	if( width < SAMPLES_PER_TRANSFER_BLOCK )
+		width = SAMPLES_PER_TRANSFER_BLOCK;
+	while( width < numCols && (size_t)2*width*numRows*BYTES_PER_COMPLEX_SAMPLE <= VLFFT_FILE_SLAB_BYTES )
+		width <<= 1;
+	return width < numCols ? width : numCols;
+}
+
+
+/* numBytes of path mapped for writing, created or truncated */
+static char *fileMapOut( const char *path, size_t numBytes ) {
+	int  fd;
+	void *p;
+
+	fd = open( path, O_RDWR | O_CREAT | O_TRUNC, 0644 );
+	if( fd < 0 )
+		return NULL;
+	if( ftruncate( fd, (off_t)numBytes ) != 0 ) {
+		close( fd );
+		return NULL;
+	}
+	p = mmap( NULL, numBytes, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0 );
+	close( fd );
+	return p == MAP_FAILED ? NULL : (char *)p;
+}
+
+
+/*********************************************************/
+/*  FFT of the file inPath, N complex samples in the     */
+/*  usual layout with N a power of two, into outPath.    */
+/*  workPath holds the N2 x N1 intermediate; if NULL     */
+/*  the output file does, pass 2 works in place.         */
+/*  Forward, unscaled, on numCores worker threads.       */
+/*                                                       */
+/*  returns 0, or -1 if the input size is not supported  */
+/*  or a file or buffer cannot be set up                 */
+/*********************************************************/
+Int32 vlfft_execute_file( const char *inPath, const char *workPath, const char *outPath, Uint32 numCores,
+                          vlfftFileStats_t *pStats ) {
+	vlfftFile_t      ff;
+	vlfftFileStats_t stats;
+	struct stat      st;
+	float   *pSlab[4], *pIn[2], *pOut[2];
+	size_t  fileBytes, slabBytes, maxN;
+	Uint32  log2N, log2N1, log2N2, width1, width2, coreNum, numAnchors, i;
+	Int32   status = -1;
+	double  timer0;
+	int     fd;
+
+	memset( &ff, 0, sizeof(ff) );
+	memset( &stats, 0, sizeof(stats) );
+	memset( pSlab, 0, sizeof(pSlab) );
+	timer0 = timeNowMs();
+
+	if( numCores == 0 )
+		return -1;
+
+	fd = open( inPath, O_RDONLY );
+	if( fd < 0 )
+		return -1;
+	if( fstat( fd, &st ) != 0 ) {
+		close( fd );
+		return -1;
+	}
+
+	/* a power of two number of samples in the supported range */
+	fileBytes = (size_t)st.st_size;
+	ff.N = fileBytes/BYTES_PER_COMPLEX_SAMPLE;
+	for( log2N=0; ((size_t)1<<log2N) < ff.N; log2N++ )
+		;
+	if( fileBytes % BYTES_PER_COMPLEX_SAMPLE != 0 || ((size_t)1<<log2N) != ff.N ||
+	    log2N < VLFFT_MIN_LOG2_SIZE || log2N > VLFFT_FILE_MAX_LOG2_SIZE ) {
+		close( fd );
+		return -1;
+	}
+
+	ff.pInMap = (const char *)mmap( NULL, fileBytes, PROT_READ, MAP_SHARED, fd, 0 );
+	close( fd );
+	if( ff.pInMap == MAP_FAILED )
+		return -1;
+
+	/* same split and radices as vlfftConfigSelect() */
+	log2N1 = (log2N+1)>>1;
+	log2N2 = log2N>>1;
+	ff.N1  = 1U<<log2N1;
+	ff.N2  = 1U<<log2N2;
+	ff.radix_1stIter = (log2N1&0x1) ? 2 : 4;
+	ff.log4N_1stIter = ff.radix_1stIter == 4 ? (log2N1>>1)-2 : 0;
+	ff.radix_2ndIter = (log2N2&0x1) ? 2 : 4;
+	ff.log4N_2ndIter = ff.radix_2ndIter == 4 ? (log2N2>>1)-2 : 0;
+	ff.numCores = numCores;
+
+	ff.pOutMap  = fileMapOut( outPath, fileBytes );
+	ff.pWorkMap = ff.pOutMap;
+	if( workPath != NULL && strcmp( workPath, outPath ) != 0 )
+		ff.pWorkMap = fileMapOut( workPath, fileBytes );
+	if( ff.pOutMap == NULL || ff.pWorkMap == NULL )
+		goto unmap;
+
+	/* pass 1 slabs are width1 x N1, pass 2 slabs width2 x N2 */
+	width1    = fileSlabWidth( ff.N1, ff.N2 );
+	width2    = fileSlabWidth( ff.N2, ff.N1 );
+	slabBytes = (size_t)width1*ff.N1 > (size_t)width2*ff.N2 ? (size_t)width1*ff.N1 : (size_t)width2*ff.N2;
+	slabBytes *= BYTES_PER_COMPLEX_SAMPLE;
+	for( i=0; i<4; i++ )
+		pSlab[i] = (float *)vlfftHostAlloc( slabBytes );
+
+	ff.pW1  = (float *)vlfftHostAlloc( (size_t)ff.N1*BYTES_PER_COMPLEX_SAMPLE );
+	ff.pW2  = (float *)vlfftHostAlloc( (size_t)ff.N2*BYTES_PER_COMPLEX_SAMPLE );
+	ff.core = (vlfftFileCore_t *)calloc( numCores, sizeof(vlfftFileCore_t) );
+	if( !pSlab[0] || !pSlab[1] || !pSlab[2] || !pSlab[3] || !ff.pW1 || !ff.pW2 || !ff.core )
+		goto unmap;
+
+	tw_gen( ff.pW1, ff.N1, VLFFT_FORWARD );
+	tw_gen( ff.pW2, ff.N2, VLFFT_FORWARD );
+
+	maxN       = ff.N1 > ff.N2 ? ff.N1 : ff.N2;
+	numAnchors = (ff.N1+VLFFT_TWIDDLE_ANCHOR_STEP-1)/VLFFT_TWIDDLE_ANCHOR_STEP;
+	for( coreNum=0; coreNum<numCores; coreNum++ ) {
+		ff.core[coreNum].ff      = &ff;
+		ff.core[coreNum].coreNum = coreNum;
+		ff.core[coreNum].pWork0  = (float *)vlfftHostAlloc( maxN*SAMPLES_PER_TRANSFER_BLOCK*BYTES_PER_COMPLEX_SAMPLE );
+		ff.core[coreNum].pWork1  = (float *)vlfftHostAlloc( maxN*SAMPLES_PER_TRANSFER_BLOCK*BYTES_PER_COMPLEX_SAMPLE );
+		ff.core[coreNum].pAnchor = (float *)vlfftHostAlloc( (size_t)numAnchors*BYTES_PER_COMPLEX_SAMPLE );
+		if( !ff.core[coreNum].pWork0 || !ff.core[coreNum].pWork1 || !ff.core[coreNum].pAnchor )
+			goto cleanup;
+	}
+
+	pthread_barrier_init( &ff.startBarrier, NULL, numCores+1 );
+	pthread_barrier_init( &ff.doneBarrier,  NULL, numCores+1 );
+
+	for( coreNum=0; coreNum<numCores; coreNum++ ) {
+		if( pthread_create( &ff.core[coreNum].thread, NULL, fileWorker, &ff.core[coreNum] ) != 0 ) {
+			fprintf( stderr, "vlfft: cannot create worker thread %u\n", coreNum );
+			exit( 1 );
+		}
+	}
+
+	pIn[0]  = pSlab[0];
+	pIn[1]  = pSlab[1];
+	pOut[0] = pSlab[2];
+	pOut[1] = pSlab[3];
+	filePass( &ff, 1, width1, ff.N2/width1, fileLoad1, fileStore1, pIn, pOut, &stats );
+	filePass( &ff, 2, width2, ff.N1/width2, fileLoad2, fileStore2, pIn, pIn, &stats );
+
+	ff.pass = 0;
+	pthread_barrier_wait( &ff.startBarrier );
+	for( coreNum=0; coreNum<numCores; coreNum++ )
+		pthread_join( ff.core[coreNum].thread, NULL );
+
+	pthread_barrier_destroy( &ff.startBarrier );
+	pthread_barrier_destroy( &ff.doneBarrier );
+	status = 0;
+
+cleanup:
+	for( coreNum=0; ff.core != NULL && coreNum<numCores; coreNum++ ) {
+		vlfftHostFree( ff.core[coreNum].pWork0 );
+		vlfftHostFree( ff.core[coreNum].pWork1 );
+		vlfftHostFree( ff.core[coreNum].pAnchor );
+	}
+unmap:
+	free( ff.core );
+	vlfftHostFree( ff.pW1 );
+	vlfftHostFree( ff.pW2 );
+	for( i=0; i<4; i++ )
+		vlfftHostFree( pSlab[i] );
+
+	if( ff.pWorkMap != NULL && ff.pWorkMap != ff.pOutMap )
+		munmap( ff.pWorkMap, fileBytes );
+	if( ff.pOutMap != NULL )
+		munmap( ff.pOutMap, fileBytes );
+	munmap( (void *)ff.pInMap, fileBytes );
+
+	stats.totalMs = timeNowMs() - timer0;
+	if( pStats != NULL )
+		*pStats = stats;
+	return status;
+}
@@ -0,0 +1,183 @@
+/*
+ * vlfftPackIntermediate()
+ * vlfftUnpackIntermediate()
+ *
+ *    Float <-> packed 16 bit conversion of the out of place intermediate:
+ *    IEEE half, rounded to nearest even and optionally scaled, with F16C
+ *    when the compiler targets it, or bfloat16, the upper half of the
+ *    float rounded to nearest even
+ *
+ * Copyright (C) {2011} Texas Instruments Incorporated - http://www.ti.com/
+ *
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *    Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ *    Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the
+ *    distribution.
+ *
+ *    Neither the name of Texas Instruments Incorporated nor the names of
+ *    its contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ *  A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ *  OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *  SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *  LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ *  DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ *  THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ *  (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ *  OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+*/
+
+
+#include <string.h>
+#if defined(__F16C__)
+#include <immintrin.h>
+#endif
+
+#include "vlfftHostStd.h"
+
+/* vlfft.h */
+#include "../vlfftInc/vlfftDebug.h"
+#include "../vlfftInc/vlfftMessgQ.h"
+#include "../vlfftInc/vlfft.h"
+#include "../vlfftInc/vlfftconfig.h"
+#include "vlfftHost.h"
+
+
+/****************************************/
+/*  float -> half, nearest even;        */
+/*  overflow gives inf, NaN stays NaN   */
+/****************************************/
+static inline Uint16 floatToHalf( float f ) {
+	const float denormMagic = 0.5f;		// 2^-1: its ulp is the smallest half denormal
+	Uint32 u, sign, mantOdd;
+	Uint16 h;
+
+	memcpy( &u, &f, sizeof(u) );
+	sign = (u >> 16) & 0x8000;
+	u   &= 0x7fffffff;
+
+	if( u >= 0x47800000 ) {
+		// 2^16 and up, inf or NaN
+		h = u > 0x7f800000 ? 0x7e00 : 0x7c00;
+	} else if( u < 0x38800000 ) {
+		// below 2^-14, denormal or zero: the add rounds to the ulp
+		memcpy( &f, &u, sizeof(f) );
+		f += denormMagic;
+		memcpy( &u, &f, sizeof(u) );
+		h = (Uint16)(u - 0x3f000000);
+	} else {
+		mantOdd = (u >> 13) & 1;
+		u += ((Uint32)(15 - 127) << 23) + 0xfff + mantOdd;
+		h = (Uint16)(u >> 13);
+	}
+
+	return h | sign;
+}
+
+
+static inline float halfToFloat( Uint16 h ) {
+	const float denormMagic = 6.103515625e-05f;	// 2^-14
+	Uint32 u, exp;
+	float  f;
+
+	u   = (Uint32)(h & 0x7fff) << 13;
+	exp = u & (0x7c00 << 13);
+	u  += (Uint32)(127 - 15) << 23;
+
+	if( exp == (0x7c00 << 13) ) {
+		u += (Uint32)(128 - 16) << 23;
+		memcpy( &f, &u, sizeof(f) );
+	} else if( exp == 0 ) {
+		u += 1 << 23;
+		memcpy( &f, &u, sizeof(f) );
+		f -= denormMagic;
+	} else {
+		memcpy( &f, &u, sizeof(f) );
+	}
+
+	return (h & 0x8000) ? -f : f;
+}
+
+
+static inline Uint16 floatToBf16( float f ) {
+	Uint32 u;
+
+	memcpy( &u, &f, sizeof(u) );
+	return (Uint16)((u + 0x7fff + ((u >> 16) & 1)) >> 16);
+}
+
+
+static inline float bf16ToFloat( Uint16 b ) {
+	Uint32 u = (Uint32)b << 16;
+	float  f;
+
+	memcpy( &f, &u, sizeof(f) );
+	return f;
+}
+
+
+/*********************************************************/
+/*  numFloats floats of pIn times scale into 16 bit      */
+/*  format (VLFFT_INTERMEDIATE_FP16 or _BF16) at pOut,   */
+/*  same order; bfloat16 ignores scale                   */
+/*********************************************************/
+void vlfftPackIntermediate( const float *pIn, Uint16 *pOut, size_t numFloats, Uint32 format, float scale ) {
+	size_t i = 0;
+
+	if( format == VLFFT_INTERMEDIATE_BF16 ) {
+		for( ; i<numFloats; i++ )
+			pOut[i] = floatToBf16( pIn[i] );
+		return;
+	}
+
+#if defined(__F16C__)
+	{
+		__m256 s = _mm256_set1_ps( scale );
+
+		for( ; i+8<=numFloats; i+=8 )
+			_mm_storeu_si128( (__m128i *)&pOut[i],
+			                  _mm256_cvtps_ph( _mm256_mul_ps( _mm256_loadu_ps( &pIn[i] ), s ), _MM_FROUND_TO_NEAREST_INT ) );
+	}
+#endif
+	for( ; i<numFloats; i++ )
+		pOut[i] = floatToHalf( pIn[i]*scale );
+}
+
+
+/*********************************************************/
+/*  inverse of vlfftPackIntermediate(), scale being the  */
+/*  reciprocal of the one packed with                    */
+/*********************************************************/
+void vlfftUnpackIntermediate( const Uint16 *pIn, float *pOut, size_t numFloats, Uint32 format, float scale ) {
+	size_t i = 0;
+
+	if( format == VLFFT_INTERMEDIATE_BF16 ) {
+		for( ; i<numFloats; i++ )
+			pOut[i] = bf16ToFloat( pIn[i] );
+		return;
+	}
+
+#if defined(__F16C__)
+	{
+		__m256 s = _mm256_set1_ps( scale );
+
+		for( ; i+8<=numFloats; i+=8 )
+			_mm256_storeu_ps( &pOut[i], _mm256_mul_ps( _mm256_cvtph_ps( _mm_loadu_si128( (const __m128i *)&pIn[i] ) ), s ) );
+	}
+#endif
+	for( ; i<numFloats; i++ )
+		pOut[i] = halfToFloat( pIn[i] )*scale;
+}
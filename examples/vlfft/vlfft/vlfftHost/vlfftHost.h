@@ -0,0 +1,502 @@
+/*
+ * vlfftHost.h
+ *
+ *    This file contains definitions for running the multicore FFT on a
+ *    Linux host, with one pinned worker thread per DSP core
+ *
+ * Copyright (C) {2011} Texas Instruments Incorporated - http://www.ti.com/
+ *
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *    Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ *    Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the
+ *    distribution.
+ *
+ *    Neither the name of Texas Instruments Incorporated nor the names of
+ *    its contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ *  A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ *  OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *  SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *  LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ *  DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ *  THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ *  (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ *  OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+*/
+
+
+#ifndef _VLFFT_HOST_H
+#define _VLFFT_HOST_H
+
+#include <stdio.h>
+#include <pthread.h>
+
+#include "vlfftHostStd.h"
+
+#define VLFFT_HOST_ALIGN  64
+
+/* side in complex samples of the blocks the transposes recurse down to */
+#define VLFFT_TRANSPOSE_TILE 32
+
+#define VLFFT_WISDOM_FILE "vlfft.wisdom"
+#define VLFFT_MAX_WISDOM  256
+#define VLFFT_TUNE_RUNS   3
+
+/* vlfft_execute_file(): up to 4G points, slabs of */
+/* VLFFT_FILE_SLAB_BYTES but rows of at least a page */
+#define VLFFT_FILE_MAX_LOG2_SIZE  32
+#define VLFFT_FILE_SLAB_BYTES     (64U<<20)
+#define VLFFT_FILE_MIN_ROW_BYTES  4096
+
+/* vlfft_stft_push(): frames per core in a batch, computed */
+/* VLFFT_STFT_GROUP at a time by the batched kernels       */
+#define VLFFT_STFT_FRAMES_PER_CORE 32
+#define VLFFT_STFT_GROUP           8
+
+/* vlfft_profile_start(): phases timed in every block a core moves, */
+/* records per core unless asked otherwise                          */
+#define VLFFT_PROFILE_DMA         0     // waiting for and issuing transfers
+#define VLFFT_PROFILE_FFT         1     // batched FFTs, 2nd iteration: rows reordered, filter
+#define VLFFT_PROFILE_TWIDDLE     2     // 1st iteration's twiddle multiply into the rows out, in FFT
+                                        // with the recurrence (vlfftBatchFFTStagesTw())
+#define VLFFT_PROFILE_PACK        3     // 16 bit intermediate
+#define VLFFT_PROFILE_BARRIER     4
+#define VLFFT_PROFILE_NUM_PHASES  5
+#define VLFFT_PROFILE_PASS_SYNC   2     // record of a barrier, after pass 0 or 1
+#define VLFFT_PROFILE_NO_BLOCK    0xFFFFFFFFu   // ring drain or barrier
+#define VLFFT_PROFILE_BLOCKS      65536
+
+/* vlfft_plan_t.type */
+#define VLFFT_PLAN_C2C    0
+#define VLFFT_PLAN_R2C    1     // N real -> N/2+1 bins
+#define VLFFT_PLAN_C2R    2     // N/2+1 bins -> N real
+#define VLFFT_PLAN_CONV   3     // N-point fast convolution with a filter
+
+
+/****************************************/
+/*  emulated EDMA3, vlfftEdmaHost.c;    */
+/*  OPT bits as in vlfftEdmaLLD.h       */
+/****************************************/
+#define VLFFT_EDMA_NUM_CHANNELS 32
+
+#define OPT_SYNCDIM_SHIFT     (0x00000002u)
+#define OPT_TCC_MASK          (0x0003F000u)
+#define OPT_TCC_SHIFT         (0x0000000Cu)
+#define OPT_ITCINTEN_SHIFT    (0x00000015u)
+#define OPT_TCINTEN_SHIFT     (0x00000014u)
+#define OPT_ITCCHEN_SHIFT     (0x00000017u)
+#define OPT_TCCHEN_SHIFT      (0x00000016u)
+
+/* same fields as the LLD's, host pointers and unlimited counts */
+typedef struct {
+	Uint32  opt;
+	UArg    srcAddr;
+	Uint32  aCnt;
+	Uint32  bCnt;
+	UArg    destAddr;
+	Int32   srcBIdx;
+	Int32   destBIdx;
+	Uint32  linkAddr;
+	Uint32  bCntReload;
+	Int32   srcCIdx;
+	Int32   destCIdx;
+	Uint32  cCnt;
+} EDMA3_DRV_PaRAMRegs;
+
+typedef struct {
+	double             pollWaitMs;  // caller blocked in edmaPoll()
+	double             busyMs;      // copy thread moving data
+	Uint32             numPolls;
+	Uint32             numEvents;
+	unsigned long long numBytes;
+} vlfftEdmaStats_t;
+
+typedef struct vlfftEdmaHost {
+	pthread_t           thread;
+	pthread_mutex_t     lock;
+	pthread_cond_t      trigger;
+	pthread_cond_t      complete;
+	Bool                exit;
+
+	EDMA3_DRV_PaRAMRegs paRAM[VLFFT_EDMA_NUM_CHANNELS];
+	Uint32              pending;    // event register, one bit per channel
+	Uint32              ipr;        // completed TCCs not yet polled
+
+	vlfftEdmaStats_t    stats;
+} *EDMA3_DRV_Handle;
+
+/* a worker's in/out channel pairs, DMAparams_t on the DSP; */
+/* buffer ring slot k transfers on chId0+2k chained to      */
+/* chId1+2k, which latches tcc1+2k                          */
+typedef struct {
+	EDMA3_DRV_Handle    hEdma;      // NULL: the worker copies the blocks itself
+	EDMA3_DRV_PaRAMRegs paramSet0;  // block in, chained to ch1
+	EDMA3_DRV_PaRAMRegs paramSet1;  // block out, latches tcc1
+	Uint32              chId0;
+	Uint32              chId1;
+	Uint32              tcc1;
+	Uint32              dummy[2];   // source and target of empty transfers
+} vlfftHostDma_t;
+
+
+/* time the caller spent on the files and waiting for the workers */
+typedef struct {
+	double             readMs;
+	double             writeMs;
+	double             computeWaitMs;   // workers slower than the disk
+	double             totalMs;
+	unsigned long long numBytes;        // read and written
+} vlfftFileStats_t;
+
+
+/* vlfft_stft_push() since the engine was made or reset */
+typedef struct {
+	unsigned long long numSamples;
+	unsigned long long numFrames;
+	double             totalMs;
+	double             samplesPerSec;
+} vlfftStftStats_t;
+
+
+/* vlfft_conv_stream() since the plan was made or reset */
+typedef struct {
+	unsigned long long numSamples;
+	unsigned long long numBlocks;       // N-point FFT pairs
+	double             totalMs;
+	double             samplesPerSec;
+} vlfftConvStats_t;
+
+
+/* one block of a pass, or one barrier */
+typedef struct {
+	Uint32             pass;        // 0, 1 or VLFFT_PROFILE_PASS_SYNC
+	Uint32             block;
+	unsigned long long startNs;
+	Uint32             ns[VLFFT_PROFILE_NUM_PHASES];
+} vlfftProfileBlock_t;
+
+typedef struct {
+	vlfftProfileBlock_t *pBlock;    // NULL until profiled
+	Uint32             numBlocks;
+	Uint32             maxBlocks;
+	Uint32             numDropped;  // blocks past maxBlocks
+	vlfftProfileBlock_t *pCur;      // NULL when dropped
+	unsigned long long lastNs;
+} vlfftProfileCore_t;
+
+
+/****************************************/
+/*  per core state: on the DSP each     */
+/*  core owns these in its own L2       */
+/****************************************/
+typedef struct {
+	struct vlfftHostEngine *engine;
+	pthread_t      thread;
+	Uint32         coreNum;
+	Uint32         startSense;	// of the engine's barriers
+	Uint32         doneSense;
+	Uint32         phaseSense;
+
+	VLFFTparams_t  VLFFTparams;
+	VLFFTbuffers_t VLFFTbuffers;
+	vlfftHostDma_t dma;
+	vlfftProfileCore_t profile;
+
+	float          *pW1;
+	float          *pW2;
+	float          *pTwiddle;
+	float          *pTwiddleTable;	// NULL unless twiddleMode != VLFFT_TWIDDLE_RECURSIVE
+	float          *pInBuf;
+	float          *pOutBuf;
+	float          *pWorkBuf0;
+	float          *pfftInBuf;
+	float          *pfftOutBuf;
+} vlfftHostCore_t;
+
+
+/* extra step each worker runs on its share of the data */
+typedef void (*vlfftHostPhase_t)( void *arg, Uint32 coreNum, Uint32 numCores );
+
+typedef struct vlfftHostEngine {
+	Uint32            numCores;
+	VLFFTconfig_t     VLFFTconfig;
+
+	/* start/done rendezvous with the caller, and the */
+	/* 1st -> 2nd iteration hand-off between workers; */
+	/* the caller's senses of the first two           */
+	vlfftBarrier_t    *startBarrier;
+	vlfftBarrier_t    *doneBarrier;
+	vlfftBarrier_t    *phaseBarrier;
+	Uint32            startSense;
+	Uint32            doneSense;
+	volatile vlfftMode mode;
+
+	float             *pIn;
+	float             *pWork;
+	float             *pOut;
+
+	/* stream of frames, numFrames is 0 for a single FFT */
+	Uint32            numFrames;
+	float             **ppIn;
+	float             **ppOut;
+	float             *pWorkStream[2];
+
+	/* dynamic schedule: next unclaimed block of each pass, */
+	/* one per frame parity for streams                     */
+	Uint32            nextBlock[2][2];
+
+	/* optional, before the 1st and after the 2nd iteration */
+	vlfftHostPhase_t  prePhase;
+	vlfftHostPhase_t  postPhase;
+	void              *phaseArg;
+
+	/* vlfft_profile_start() .. vlfft_profile_stop() */
+	Bool              profiling;
+	unsigned long long profileStartNs;
+
+	vlfftHostCore_t   *core;
+} vlfftHostEngine_t;
+
+
+/****************************************/
+/*  run time FFT plan: everything an    */
+/*  N-point FFT on numCores cores needs */
+/*  besides its input and output.       */
+/*  A real plan runs an N/2-point       */
+/*  complex FFT, VLFFTconfig.N is N/2   */
+/****************************************/
+typedef struct vlfft_plan {
+	VLFFTconfig_t      VLFFTconfig;
+	vlfftHostEngine_t  engine;
+	float              *pWork;     // N1 x N2 intermediate, workBufExternal on the DSP; NULL in place,
+	                               // half the size when packed to 16 bits
+	float              *pWorkNext; // second intermediate for streams, allocated on first use
+	Uint32             type;
+
+	// real plans only
+	float              *pHalf;     // N/2-point complex spectrum
+	float              *pSplit;    // W_N^k, k = 0 .. N/4
+	float              splitScale;
+	float              *pRealIn;
+	float              *pRealOut;
+
+	// natural order in-place plans: one row of each cycle of the row
+	// permutation, see vlfftInPlace.c
+	Uint32             *pCycles;
+	Uint32             numCycles;
+
+	// Bluestein plans, N the passes cannot split: no engine, the
+	// unscaled M-point plans of the convolution, see vlfftBluestein.c
+	struct vlfft_plan  *convFwd;
+	struct vlfft_plan  *convInv;
+	float              *pChirp;     // W_N^(n^2/2), n = 0 .. N-1
+	float              *pChirpSpec; // M-point FFT of the conjugate chirp, over M
+	float              *pConv;      // M-point convolution in and out
+	float              *pConvSpec;
+
+	// 3D plans, N1 x N2 x N3: no engine, the N1-point FFTs down the
+	// N2*N3 columns, then the N2 x N3 2D FFTs of the N1 planes
+	struct vlfft_plan  *columns;
+	struct vlfft_plan  *planes;
+	float              **ppPlane;   // N1 planes in, N1 out
+
+	// convolution plans: the engine's 2nd iteration multiplies its
+	// blocks by the filter spectrum, convInv is the unscaled inverse
+	// and pConv, pConvSpec the overlap-save window and its spectrum,
+	// see vlfftConv.c
+	float              *pFilterSpec; // H[k]/N in pass 2 block order
+	float              *pHistory;    // last filterLen-1 input samples
+	Uint32             filterLen;
+	vlfftConvStats_t   convStats;
+
+	struct vlfft_plan  *next;
+} vlfft_plan_t;
+
+
+/* called after each batch of frames, whose rows are in the ring */
+typedef void (*vlfftStftRows_t)( void *arg, unsigned long long firstFrame, Uint32 numFrames );
+
+/****************************************/
+/*  short-time FFT of a stream of       */
+/*  complex samples: windowLen-point    */
+/*  frames every hop samples, windowed  */
+/*  as they are gathered, FFTed by      */
+/*  numCores pinned workers, each on a  */
+/*  run of consecutive frames, into a   */
+/*  ring of numRows spectrogram rows    */
+/****************************************/
+typedef struct vlfftStftCore {
+	struct vlfft_stft  *stft;
+	pthread_t          thread;
+	Uint32             coreNum;
+	Uint32             startSense;
+	Uint32             doneSense;
+	float              *pBatch;      // VLFFT_STFT_GROUP frames interleaved
+	float              *pBatchOut;   // mixed radix result
+} vlfftStftCore_t;
+
+typedef struct vlfft_stft {
+	Uint32             windowLen;
+	Uint32             hop;
+	Uint32             radix;        // 4, 2 or VLFFT_RADIX_MIXED
+	Uint32             numCores;
+	Uint32             numRows;
+	Uint32             batchFrames;  // most frames in one batch
+	float              *pWindow;
+	float              *pW;          // twiddles of windowLen
+	float              *pRing;       // numRows x windowLen bins
+	vlfftStftRows_t    onRows;
+	void               *rowsArg;
+
+	// samples not yet consumed by a frame, up to one batch
+	float              *pSamples;
+	size_t             numSamples;
+	size_t             maxSamples;
+
+	// batch the workers run: frames firstFrame .. + numFrames
+	// starting at pSamples
+	unsigned long long firstFrame;
+	Uint32             numFrames;
+	volatile Bool      exit;
+
+	vlfftBarrier_t     *startBarrier;
+	vlfftBarrier_t     *doneBarrier;
+	Uint32             startSense;
+	Uint32             doneSense;
+	vlfftStftCore_t    *core;
+
+	unsigned long long framesDone;
+	vlfftStftStats_t   stats;
+} vlfft_stft_t;
+
+
+void  *vlfftHostAlloc( size_t numBytes );
+void  vlfftHostFree( void *p );
+void  vlfftHostPinToCpu( Uint32 coreNum );
+void  vlfftHostCopy2D( void *pDst, size_t dstStride, const void *pSrc, size_t srcStride, size_t numBytes, Uint32 numRows );
+
+void  DSPF_sp_radix4_fftTwSPxSP( Uint32 n, float *pIn, float *pTwiddle, float *pOut, Uint32 log4NMinus1,
+                                 float wStepRe, float wStepIm, const float *pAnchor, Uint32 anchorStep );
+void  DSPF_sp_mixedRadix_fftTwSPxSP( Uint32 n, float *pIn, float *pTwiddle, float *pOut,
+                                     float wStepRe, float wStepIm, const float *pAnchor, Uint32 anchorStep );
+void  multTwiddle_vec_batch( const float *pBatch, Uint32 numFFTs, Uint32 fftIdx, Bool bitReversed, float wStepRe, float wStepIm,
+                             int fftSize, float *pOutTwiddle, Uint32 outStride, const float *pAnchor, Uint32 anchorStep );
+
+void  vlfftPackIntermediate( const float *pIn, Uint16 *pOut, size_t numFloats, Uint32 format, float scale );
+void  vlfftUnpackIntermediate( const Uint16 *pIn, float *pOut, size_t numFloats, Uint32 format, float scale );
+
+void  vlfftTransposeStrided( const float *pIn, size_t inStride, float *pOut, size_t outStride, Uint32 rows, Uint32 cols );
+void  vlfftTransposeSquareBand( float *p, size_t ld, Uint32 n, Uint32 row0, Uint32 row1 );
+
+Int32 vlfftEdmaHostCreate( EDMA3_DRV_Handle *phEdma );
+void  vlfftEdmaHostDelete( EDMA3_DRV_Handle hEdma );
+void  vlfftEdmaHostStats( EDMA3_DRV_Handle hEdma, vlfftEdmaStats_t *pStats, Bool reset );
+void  vlfftEdmaTransfer( const EDMA3_DRV_PaRAMRegs *pParamSet );
+Int32 EDMA3_DRV_setPaRAM( EDMA3_DRV_Handle hEdma, Uint32 chId, const EDMA3_DRV_PaRAMRegs *pParamSet );
+void  vlfftEdmaConfig_srcAddrdstAddr_aCntbCntcCnt( EDMA3_DRV_Handle hEdma, EDMA3_DRV_PaRAMRegs *pParamSet, Uint32 chId,
+                                                   UArg srcAddr, UArg dstAddr, Uint32 aCnt, Uint32 bCnt, Uint32 cCnt );
+void  vlfftEdmaConfig_srcAddrdstAddr( EDMA3_DRV_Handle hEdma, EDMA3_DRV_PaRAMRegs *pParamSet, Uint32 chId, UArg srcAddr, UArg dstAddr );
+void  edmaTrigger( EDMA3_DRV_Handle hEdma, Uint32 chId );
+void  edmaPoll( EDMA3_DRV_Handle hEdma, Uint32 tcc );
+Int32 vlfftHostDmaInit( vlfftHostDma_t *dma, Bool emulate );
+void  vlfftHostDmaDelete( vlfftHostDma_t *dma );
+Bool  vlfftEdmaHostEnabled( void );
+
+void  VLFFT_1stIter_host( float          *pIn,
+                          float          *pOut,
+                          VLFFTparams_t  *VLFFTparams,
+                          VLFFTbuffers_t *VLFFTbuffers,
+                          vlfftHostDma_t *dma,
+                          Uint32         *pNextBlk,
+                          vlfftProfileCore_t *prof,
+                          Uint32         coreNum );
+
+void  VLFFT_2ndIter_host( float          *pIn,
+                          float          *pOut,
+                          VLFFTparams_t  *VLFFTparams,
+                          VLFFTbuffers_t *VLFFTbuffers,
+                          vlfftHostDma_t *dma,
+                          Uint32         *pNextBlk,
+                          vlfftProfileCore_t *prof,
+                          Uint32         coreNum );
+
+unsigned long long vlfftProfileNowNs( void );
+void  vlfftProfileBegin( vlfftProfileCore_t *prof, Uint32 pass, Uint32 block );
+void  vlfftProfileMark( vlfftProfileCore_t *prof, Uint32 phase );
+
+Int32 vlfftHostEngineCreate( vlfftHostEngine_t *engine, const VLFFTconfig_t *VLFFTconfig );
+void  vlfftHostEngineRun( vlfftHostEngine_t *engine, float *pIn, float *pWork, float *pOut );
+void  vlfftHostEngineRunStream( vlfftHostEngine_t *engine, float **ppIn, float **ppOut, float *pWork[2], Uint32 numFrames );
+void  vlfftHostEngineDelete( vlfftHostEngine_t *engine );
+void  vlfftHostEngineSync( vlfftHostEngine_t *engine, Uint32 coreNum );
+
+vlfft_plan_t *vlfft_plan_create( Uint32 N, Uint32 numCores );
+vlfft_plan_t *vlfft_plan_create_inverse( Uint32 N, Uint32 numCores, Bool scale );
+vlfft_plan_t *vlfft_plan_create_twiddle( Uint32 N, Uint32 numCores, Uint32 twiddleMode, Uint32 anchorStep );
+vlfft_plan_t *vlfft_plan_create_depth( Uint32 N, Uint32 numCores, Uint32 bufferDepth );
+vlfft_plan_t *vlfft_plan_create_inplace( Uint32 N, Uint32 numCores, Bool naturalOrder );
+vlfft_plan_t *vlfft_plan_create_intermediate( Uint32 N, Uint32 numCores, Uint32 intermediate );
+vlfft_plan_t *vlfft_plan_create_dynamic( Uint32 N, Uint32 numCores );
+vlfft_plan_t *vlfft_plan_create_r2c( Uint32 N, Uint32 numCores );
+vlfft_plan_t *vlfft_plan_create_c2r( Uint32 N, Uint32 numCores, Bool scale );
+vlfft_plan_t *vlfft_plan_create_2d( Uint32 N1, Uint32 N2, Uint32 numCores, Uint32 direction, Bool scale );
+vlfft_plan_t *vlfft_plan_create_3d( Uint32 N1, Uint32 N2, Uint32 N3, Uint32 numCores, Uint32 direction, Bool scale );
+vlfft_plan_t *vlfft_plan_create_pruned( Uint32 N, Uint32 numCores, Uint32 inBegin, Uint32 inEnd,
+                                        Uint32 outBegin, Uint32 outEnd );
+vlfft_plan_t *vlfft_plan_create_conv( Uint32 N, Uint32 numCores, const float *pFilter, Uint32 filterLen, Bool correlate );
+void  vlfft_execute( vlfft_plan_t *plan, float *pIn, float *pOut );
+Int32 vlfft_execute_stream( vlfft_plan_t *plan, float **ppIn, float **ppOut, Uint32 numFrames );
+Int32 vlfft_execute_planes( vlfft_plan_t *plan, float *pIn, float *pOut, Uint32 numPlanes );
+Int32 vlfft_conv_stream( vlfft_plan_t *plan, float *pIn, Uint32 numSamples, float *pOut );
+void  vlfft_conv_reset( vlfft_plan_t *plan );
+void  vlfft_conv_stats( vlfft_plan_t *plan, vlfftConvStats_t *pStats, Bool reset );
+void  vlfft_plan_cleanup( void );
+vlfft_stft_t *vlfft_stft_create( Uint32 windowLen, Uint32 hop, Uint32 numCores, const float *pWindow, Uint32 numRows,
+                                vlfftStftRows_t onRows, void *rowsArg );
+Int32 vlfft_stft_push( vlfft_stft_t *stft, const float *pIn, size_t numSamples );
+float *vlfft_stft_row( vlfft_stft_t *stft, unsigned long long frame );
+void  vlfft_stft_stats( vlfft_stft_t *stft, vlfftStftStats_t *pStats, Bool reset );
+void  vlfft_stft_reset( vlfft_stft_t *stft );
+void  vlfft_stft_delete( vlfft_stft_t *stft );
+Int32 vlfft_execute_file( const char *inPath, const char *workPath, const char *outPath, Uint32 numCores,
+                          vlfftFileStats_t *pStats );
+
+Int32 vlfft_profile_start( vlfft_plan_t *plan, Uint32 maxBlocksPerCore );
+void  vlfft_profile_stop( vlfft_plan_t *plan );
+void  vlfft_profile_report( vlfft_plan_t *plan, FILE *fp );
+Int32 vlfft_profile_export( vlfft_plan_t *plan, const char *path );
+
+Int32 vlfft_tune( Uint32 N, Uint32 numCores, VLFFTconfig_t *pBest, double *pMsPerFft );
+
+void  vlfftRealSplitInit( float *pSplit, Uint32 N );
+void  vlfftRealSplit( void *arg, Uint32 coreNum, Uint32 numCores );
+void  vlfftRealMerge( void *arg, Uint32 coreNum, Uint32 numCores );
+
+Int32 vlfftInPlaceInit( vlfft_plan_t *plan );
+void  vlfftInPlaceNatural( void *arg, Uint32 coreNum, Uint32 numCores );
+
+Uint32 vlfftBluesteinSize( Uint32 N, Uint32 numCores );
+Int32 vlfftBluesteinInit( vlfft_plan_t *plan, vlfft_plan_t *convFwd, vlfft_plan_t *convInv );
+void  vlfftBluesteinExecute( vlfft_plan_t *plan, const float *pIn, float *pOut );
+
+Int32 vlfftConvInit( vlfft_plan_t *plan, const float *pFilter, Uint32 filterLen, Bool correlate );
+void  vlfftConvExecute( vlfft_plan_t *plan, float *pIn, float *pOut );
+void  vlfftSpectrumMultiply( float *pInOut, const float *pH, size_t numSamples );
+
+const char *vlfftWisdomPath( void );
+Int32 vlfftWisdomStore( const VLFFTconfig_t *VLFFTconfig, double msPerFft );
+
+#endif  // _VLFFT_HOST_H
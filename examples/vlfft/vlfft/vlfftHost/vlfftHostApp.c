@@ -0,0 +1,1402 @@
+/*
+ * main()
+ *
+ *    Linux host demo of multicore FFT: runs the VLFFT_SIZE point FFT with
+ *    NUM_CORES_FOR_FFT_COMPUTE worker threads, reports the time per FFT
+ *    and the throughput per core, and checks every bin against a double
+ *    precision reference FFT (vlfftValidate.c) and the output energy.
+ *    Also reports time and SNR for each inter-pass twiddle mode
+ *
+ * Copyright (C) {2011} Texas Instruments Incorporated - http://www.ti.com/
+ *
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *    Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ *    Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the
+ *    distribution.
+ *
+ *    Neither the name of Texas Instruments Incorporated nor the names of
+ *    its contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ *  A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ *  OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *  SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *  LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ *  DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ *  THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ *  (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ *  OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+*/
+
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <math.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+#include "vlfftHostStd.h"
+
+/* vlfft.h */
+#include "../vlfftInc/vlfftDebug.h"
+#include "../vlfftInc/vlfftMessgQ.h"
+#include "../vlfftInc/vlfft.h"
+#include "../vlfftInc/vlfftconfig.h"
+#include "vlfftHost.h"
+
+#define NUM_FFT_TO_COMPUTE    10
+#define VLFFT_REL_ERROR        1e-4
+#define NUM_SNR_BINS           64
+#define VLFFT_MIN_SNR_DB       60.0
+#define VLFFT_MIN_FP16_SNR_DB  65.0
+#define VLFFT_MIN_BF16_SNR_DB  50.0
+#define NUM_FILE_SNR_BINS      4
+#define NUM_MULTIDIM_SNR_BINS  16
+#define NUM_PRUNED_BINS        20     // first bins, as many as the DSP demo's dft() check
+#define NUM_CONV_WINDOWS       16     // input of the convolution test, in N-point windows
+#define NUM_CONV_SNR_OUTPUTS   64
+#define NUM_STFT_SNR_BINS      8      // per checked frame, the first of each batch
+#define STFT_CHUNK             4096   // samples per vlfft_stft_push()
+#define STFT_SAMPLES           (1U<<22)
+#define VLFFT_ENERGY_TOLERANCE 1e-4
+#define VLFFT_MAX_LOG2_REFERENCE 24   // 512 MB of reference and twiddles
+
+Uint32 compare_float( Uint32 n, float *pIn0, float *pIn1 );
+
+
+static double timeNowMs( void ) {
+	struct timespec ts;
+
+	clock_gettime( CLOCK_MONOTONIC, &ts );
+	return ts.tv_sec*1000.0 + ts.tv_nsec/1000000.0;
+}
+
+
+/* same test vector as genFFTTestData() on the DSP, */
+/* a pulse of min(N, N2) samples                     */
+static void genFFTTestData( float *inData, Uint32 N, Uint32 N2 ) {
+	Uint32 i;
+
+	memset( inData, 0, (size_t)N*BYTES_PER_COMPLEX_SAMPLE );
+
+	for(i=0; i<N2 && i<N; i++) {
+#if USE_BDTI_FFT
+		inData[2*i] = 0.0;
+		inData[2*i+1]=1.0;
+#else
+		inData[2*i] = 1.0;
+		inData[2*i+1]=0.0;
+#endif
+	}
+}
+
+
+/* max |a-b| over max |b|, for signals too large for compare_float() */
+static double relError( Uint32 n, const float *a, const float *b ) {
+	Uint32 i;
+	double err = 0.0, ref = 0.0;
+
+	for( i=0; i<n; i++ ) {
+		if( fabs( a[i]-b[i] ) > err ) err = fabs( a[i]-b[i] );
+		if( fabs( b[i] ) > ref )      ref = fabs( b[i] );
+	}
+	return ref > 0.0 ? err/ref : err;
+}
+
+
+/*********************************************************/
+/*  R2C of a real test signal against the complex FFT of */
+/*  the same signal, then C2R back; prints the real FFT  */
+/*  time, returns 0 on success                           */
+/*********************************************************/
+static int realFFTCheck( Uint32 N, Uint32 numCores, vlfft_plan_t *plan, float *pCplx, float *pCplxOut ) {
+	vlfft_plan_t *planR2C, *planC2R;
+	VLFFTconfig_t VLFFTconfig;
+	float   *realIn, *realOut, *realBack;
+	Uint32  i, fftLoop;
+	double  timer0, fftTime;
+	int     status;
+
+	if( N & 0x1 ) {
+		printf("  Real FFT          =    skipped, N is odd \n" );
+		return 0;
+	}
+
+	/* the N/2-point complex FFT may be too small for numCores, */
+	/* or have a factor the passes cannot split                 */
+	if( vlfftConfigSelect( &VLFFTconfig, N/2, numCores ) != 0 ) {
+		printf("  Real FFT          =    skipped, no %u-point plan on %u cores \n", N/2, numCores );
+		return 0;
+	}
+
+	planR2C = vlfft_plan_create_r2c( N, numCores );
+	planC2R = vlfft_plan_create_c2r( N, numCores, TRUE );
+	if( planR2C == NULL || planC2R == NULL )
+		return 1;
+
+	realIn   = (float *)vlfftHostAlloc( (size_t)N*sizeof(float) );
+	realBack = (float *)vlfftHostAlloc( (size_t)N*sizeof(float) );
+	realOut  = (float *)vlfftHostAlloc( ((size_t)N/2+1)*BYTES_PER_COMPLEX_SAMPLE );
+	if( !realIn || !realBack || !realOut )
+		return 1;
+
+	for( i=0; i<N; i++ ) {
+		realIn[i]     = (float)((i*2654435761U)>>16)/65536.0f - 0.5f;
+		pCplx[2*i  ]  = 0.0f;
+		pCplx[2*i+1]  = realIn[i];
+	}
+
+	vlfft_execute( planR2C, realIn, realOut );
+
+	timer0 = timeNowMs();
+	for(fftLoop=0; fftLoop<NUM_FFT_TO_COMPUTE; fftLoop++)
+		vlfft_execute( planR2C, realIn, realOut );
+	fftTime = (timeNowMs() - timer0)/NUM_FFT_TO_COMPUTE;
+
+	printf("  Real FFT          =    %f ms, %f Msamples/s \n", fftTime, N/(fftTime*1000.0) );
+
+	vlfft_execute( plan, pCplx, pCplxOut );
+	vlfft_execute( planC2R, realOut, realBack );
+
+	status = relError( 2*(N/2+1), realOut, pCplxOut ) > VLFFT_REL_ERROR ||
+	         relError( N, realBack, realIn ) > VLFFT_REL_ERROR;
+
+	vlfftHostFree( realIn );
+	vlfftHostFree( realBack );
+	vlfftHostFree( realOut );
+
+	return status;
+}
+
+
+/*********************************************************/
+/*  with VLFFT_EDMA=1: per worker, time per FFT blocked  */
+/*  in edmaPoll() against time the copy thread moved     */
+/*  data; a worker that mostly waits is transfer bound   */
+/*********************************************************/
+static void edmaReport( vlfft_plan_t *plan, Uint32 numFFTs, Bool reset ) {
+	vlfftEdmaStats_t stats;
+	Uint32 coreNum;
+
+	for( coreNum=0; coreNum<plan->engine.numCores; coreNum++ ) {
+		if( plan->engine.core[coreNum].dma.hEdma == NULL )
+			return;
+		vlfftEdmaHostStats( plan->engine.core[coreNum].dma.hEdma, &stats, TRUE );
+		if( reset )
+			continue;
+		printf("  EDMA core %-2u      =    poll wait %f ms, copy %f ms per fft, %f GB/s \n", coreNum,
+		       stats.pollWaitMs/numFFTs, stats.busyMs/numFFTs,
+		       stats.busyMs > 0.0 ? stats.numBytes/(stats.busyMs*1e6) : 0.0 );
+	}
+}
+
+
+/*********************************************************/
+/*  with VLFFT_PROFILE=path in the environment, times    */
+/*  the phases of NUM_FFT_TO_COMPUTE more FFTs, prints   */
+/*  the summary and writes every block's record to path  */
+/*  (JSON if it ends in .json, CSV otherwise)            */
+/*********************************************************/
+static int profileReport( vlfft_plan_t *plan, float *pIn, float *pOut ) {
+	const char *path = getenv( "VLFFT_PROFILE" );
+	Uint32 fftLoop;
+
+	if( path == NULL || *path == '\0' )
+		return 0;
+
+	if( vlfft_profile_start( plan, 0 ) != 0 ) {
+		fprintf( stderr, "vlfft: out of memory for the profile\n" );
+		return 1;
+	}
+	for(fftLoop=0; fftLoop<NUM_FFT_TO_COMPUTE; fftLoop++)
+		vlfft_execute( plan, pIn, pOut );
+	vlfft_profile_stop( plan );
+
+	vlfft_profile_report( plan, stdout );
+	if( vlfft_profile_export( plan, path ) != 0 ) {
+		fprintf( stderr, "vlfft: cannot write %s\n", path );
+		return 1;
+	}
+	printf("  Profile written to %s \n", path );
+	return 0;
+}
+
+
+/*********************************************************/
+/*  vlfftTransposeStrided() and vlfftTransposeSquareBand */
+/*  () against a plain transpose, on shapes with ragged  */
+/*  edges around the 4x4 kernels and the tile, and with  */
+/*  pitches wider than the rows; the samples between the */
+/*  rows must be left alone                              */
+/*********************************************************/
+static int transposeCheck( void ) {
+	static const Uint32 shapes[][2] = { {8, 1024}, {1024, 8}, {37, 53}, {67, 129}, {1, 5}, {33, 32}, {100, 100} };
+	static const Uint32 sides[] = { 1, 7, 32, 33, 131 };
+	float   *pIn, *pOut;
+	Uint32  i, r, c, n, rows, cols, numSamples;
+	size_t  inStride, outStride, ld;
+	int     status = 0;
+
+	numSamples = 131*(131+2);   // the largest of the matrices
+	pIn  = (float *)vlfftHostAlloc( (size_t)numSamples*BYTES_PER_COMPLEX_SAMPLE );
+	pOut = (float *)vlfftHostAlloc( (size_t)numSamples*BYTES_PER_COMPLEX_SAMPLE );
+	if( !pIn || !pOut )
+		return 1;
+
+	for( i=0; i<sizeof(shapes)/sizeof(shapes[0]); i++ ) {
+		rows      = shapes[i][0];
+		cols      = shapes[i][1];
+		inStride  = cols + 3;
+		outStride = rows + 5;
+		for( r=0; r<2*numSamples; r++ ) {
+			pIn[r]  = (float)r;
+			pOut[r] = -1.0f;
+		}
+
+		vlfftTransposeStrided( pIn, inStride, pOut, outStride, rows, cols );
+
+		for( c=0; c<cols; c++ ) {
+			for( r=0; r<outStride; r++ ) {
+				if( r < rows )
+					status |= pOut[2*(c*outStride+r)] != pIn[2*(r*inStride+c)] ||
+					          pOut[2*(c*outStride+r)+1] != pIn[2*(r*inStride+c)+1];
+				else
+					status |= pOut[2*(c*outStride+r)] != -1.0f || pOut[2*(c*outStride+r)+1] != -1.0f;
+			}
+		}
+	}
+
+	// in place, in three bands as the workers split it
+	for( i=0; i<sizeof(sides)/sizeof(sides[0]); i++ ) {
+		n  = sides[i];
+		ld = n + 2;
+		for( r=0; r<2*n*ld; r++ )
+			pIn[r] = pOut[r] = (float)r;
+
+		vlfftTransposeSquareBand( pOut, ld, n, 0,     n/3   );
+		vlfftTransposeSquareBand( pOut, ld, n, n/3,   2*n/3 );
+		vlfftTransposeSquareBand( pOut, ld, n, 2*n/3, n     );
+
+		for( r=0; r<n; r++ ) {
+			for( c=0; c<ld; c++ ) {
+				if( c < n )
+					status |= pOut[2*(r*ld+c)] != pIn[2*(c*ld+r)] || pOut[2*(r*ld+c)+1] != pIn[2*(c*ld+r)+1];
+				else
+					status |= pOut[2*(r*ld+c)] != pIn[2*(r*ld+c)] || pOut[2*(r*ld+c)+1] != pIn[2*(r*ld+c)+1];
+			}
+		}
+	}
+
+	printf("  Transposes        =    %s \n", status ? "wrong" : "match a plain transpose" );
+
+	vlfftHostFree( pIn );
+	vlfftHostFree( pOut );
+
+	return status;
+}
+
+
+/*********************************************************/
+/*  runs the forward FFT of pIn with buffer rings 2 to   */
+/*  4 deep on the emulated EDMA, prints time and the     */
+/*  time the workers waited for transfers; the blocks    */
+/*  are computed the same way at any depth, so the       */
+/*  outputs must match pRef bit for bit                  */
+/*********************************************************/
+static int bufferDepthCheck( Uint32 N, Uint32 numCores, float *pIn, const float *pRef, float *pOut ) {
+	vlfft_plan_t *plan;
+	vlfftEdmaStats_t stats;
+	Uint32  depth, coreNum, fftLoop;
+	double  timer0, fftTime, pollWaitMs;
+	int     status = 0;
+
+	for( depth=2; depth<=4; depth++ ) {
+		plan = vlfft_plan_create_depth( N, numCores, depth );
+		if( plan == NULL )
+			return 1;
+
+		vlfft_execute( plan, pIn, pOut );
+		status |= memcmp( pOut, pRef, (size_t)N*BYTES_PER_COMPLEX_SAMPLE ) != 0;
+		edmaReport( plan, 0, TRUE );
+
+		timer0 = timeNowMs();
+		for(fftLoop=0; fftLoop<NUM_FFT_TO_COMPUTE; fftLoop++)
+			vlfft_execute( plan, pIn, pOut );
+		fftTime = (timeNowMs() - timer0)/NUM_FFT_TO_COMPUTE;
+
+		pollWaitMs = 0.0;
+		for( coreNum=0; coreNum<plan->engine.numCores; coreNum++ ) {
+			if( plan->engine.core[coreNum].dma.hEdma == NULL ) {
+				status = 1;
+				break;
+			}
+			vlfftEdmaHostStats( plan->engine.core[coreNum].dma.hEdma, &stats, TRUE );
+			pollWaitMs += stats.pollWaitMs;
+		}
+
+		printf("  Buffer depth %u    =    %f ms, poll wait %f ms per fft and core \n",
+		       depth, fftTime, pollWaitMs/(NUM_FFT_TO_COMPUTE*numCores) );
+	}
+
+	return status;
+}
+
+
+/*********************************************************/
+/*  pruned plan for input [inBegin, inEnd) and bins      */
+/*  [outBegin, outEnd) against plan's full FFT of the    */
+/*  same input, zero outside the range                   */
+/*********************************************************/
+static int prunedRangeCheck( Uint32 N, Uint32 numCores, vlfft_plan_t *plan, Uint32 inBegin, Uint32 inEnd,
+                             Uint32 outBegin, Uint32 outEnd ) {
+	vlfft_plan_t *planPruned;
+	float   *pIn, *pRef, *pOut;
+	Uint32  i;
+	double  err;
+
+	planPruned = vlfft_plan_create_pruned( N, numCores, inBegin, inEnd, outBegin, outEnd );
+	if( planPruned == NULL )
+		return 1;
+
+	pIn  = (float *)vlfftHostAlloc( (size_t)N*BYTES_PER_COMPLEX_SAMPLE );
+	pRef = (float *)vlfftHostAlloc( (size_t)N*BYTES_PER_COMPLEX_SAMPLE );
+	pOut = (float *)vlfftHostAlloc( (size_t)N*BYTES_PER_COMPLEX_SAMPLE );
+	if( !pIn || !pRef || !pOut )
+		return 1;
+
+	memset( pIn, 0, (size_t)N*BYTES_PER_COMPLEX_SAMPLE );
+	for( i=inBegin; i<inEnd; i++ ) {
+		pIn[2*i  ] = (float)((i*2654435761U)>>16)/65536.0f - 0.5f;
+		pIn[2*i+1] = (float)((i*2246822519U)>>16)/65536.0f - 0.5f;
+	}
+
+	vlfft_execute( plan, pIn, pRef );
+	vlfft_execute( planPruned, pIn, pOut );
+	err = relError( 2*(outEnd-outBegin), &pOut[2*outBegin], &pRef[2*outBegin] );
+
+	printf("  Pruned            =    samples [%u, %u) in, bins [%u, %u) out, rel error %e \n",
+	       inBegin, inEnd, outBegin, outEnd, err );
+
+	vlfftHostFree( pIn );
+	vlfftHostFree( pRef );
+	vlfftHostFree( pOut );
+
+	return err > VLFFT_REL_ERROR;
+}
+
+
+/*********************************************************/
+/*  genFFTTestData() has only its first N2 samples set:  */
+/*  the pruned plan that knows it, asked for the first   */
+/*  NUM_PRUNED_BINS bins, must give those of pRef, the   */
+/*  output of planFull; then ranges that take the other  */
+/*  paths of the pruning                                 */
+/*********************************************************/
+static int prunedCheck( Uint32 N, Uint32 numCores, vlfft_plan_t *planFull, float *pIn, const float *pRef, float *pOut ) {
+	vlfft_plan_t *plan;
+	Uint32  fftLoop, N1, N2;
+	double  timer0, fftTime;
+
+	N1 = planFull->VLFFTconfig.N1;
+	N2 = planFull->VLFFTconfig.N2;
+
+	plan = vlfft_plan_create_pruned( N, numCores, 0, N2, 0, NUM_PRUNED_BINS );
+	if( plan == NULL )
+		return 1;
+
+	vlfft_execute( plan, pIn, pOut );
+	if( relError( 2*NUM_PRUNED_BINS, pOut, pRef ) > VLFFT_REL_ERROR )
+		return 1;
+
+	timer0 = timeNowMs();
+	for(fftLoop=0; fftLoop<NUM_FFT_TO_COMPUTE; fftLoop++)
+		vlfft_execute( plan, pIn, pOut );
+	fftTime = (timeNowMs() - timer0)/NUM_FFT_TO_COMPUTE;
+
+	printf("  Pruned            =    %f ms, %u samples in, %u bins out \n", fftTime, N2, NUM_PRUNED_BINS );
+
+	/* inputs starting and ending inside rows of the N1 x N2  */
+	/* input, several rows per column, and bins k1 = k mod N1 */
+	/* that wrap past N1                                      */
+	return prunedRangeCheck( N, numCores, planFull, N2/2+1, 2*N2+N2/2, N1-N1/4, N1+N1/2 ) ||
+	       prunedRangeCheck( N, numCores, planFull, N-2*N2-N2/2, N-1, N/2+N1-N1/8-1, N/2+N1+N1/4 );
+}
+
+
+/* blocks from the shared counter must give the static split's result bit for bit */
+static int dynamicCheck( Uint32 N, Uint32 numCores, float *pIn, const float *pRef, float *pOut ) {
+	vlfft_plan_t *plan;
+	Uint32  fftLoop;
+	double  timer0, fftTime;
+
+	plan = vlfft_plan_create_dynamic( N, numCores );
+	if( plan == NULL )
+		return 1;
+
+	vlfft_execute( plan, pIn, pOut );
+	if( memcmp( pOut, pRef, (size_t)N*BYTES_PER_COMPLEX_SAMPLE ) != 0 )
+		return 1;
+
+	timer0 = timeNowMs();
+	for(fftLoop=0; fftLoop<NUM_FFT_TO_COMPUTE; fftLoop++)
+		vlfft_execute( plan, pIn, pOut );
+	fftTime = (timeNowMs() - timer0)/NUM_FFT_TO_COMPUTE;
+
+	printf("  Dynamic schedule  =    %f ms, %f Msamples/s \n", fftTime, N/(fftTime*1000.0) );
+	return 0;
+}
+
+
+/*********************************************************/
+/*  in-place plans must give the out-of-place result,    */
+/*  transposed or in natural order, and be NULL exactly  */
+/*  where vlfft_plan_create_inplace() says: no N1 x N2   */
+/*  split (the sizes below 1<<VLFFT_MIN_LOG2_SIZE and    */
+/*  the Bluestein ones), or natural order with neither   */
+/*  of N1 and N2 a multiple of the other                 */
+/*********************************************************/
+static int inPlaceCheck( Uint32 N, Uint32 numCores, const float *pIn, const float *pRef, float *pOut ) {
+	vlfft_plan_t *plan;
+	VLFFTconfig_t VLFFTconfig;
+	Uint32  N1, N2, k1, k2, fftLoop;
+	double  timer0, fftTime;
+	int     natural, noSplit, status = 0;
+
+	noSplit = vlfftConfigSelect( &VLFFTconfig, N, numCores ) != 0;
+	N1 = VLFFTconfig.N1;
+	N2 = VLFFTconfig.N2;
+
+	for( natural=0; natural<=1; natural++ ) {
+		plan = vlfft_plan_create_inplace( N, numCores, natural ? TRUE : FALSE );
+		if( noSplit || (natural && (N1 > N2 ? N1%N2 : N2%N1) != 0) ) {
+			printf("  In place %s =    no plan for N = %u, %s \n", natural ? "natural   " : "transposed", N,
+			       plan == NULL ? "NULL" : "not NULL" );
+			status |= plan != NULL;
+			continue;
+		}
+		if( plan == NULL )
+			return 1;
+
+		memcpy( pOut, pIn, (size_t)N*BYTES_PER_COMPLEX_SAMPLE );
+		vlfft_execute( plan, pOut, pOut );
+		if( natural ) {
+			status |= memcmp( pOut, pRef, (size_t)N*BYTES_PER_COMPLEX_SAMPLE ) != 0;
+		} else {
+			for( k1=0; k1<N1; k1++ )
+				for( k2=0; k2<N2; k2++ )
+					status |= memcmp( &pOut[2*((size_t)k1*N2+k2)], &pRef[2*((size_t)k2*N1+k1)],
+					                  BYTES_PER_COMPLEX_SAMPLE ) != 0;
+		}
+
+		timer0 = timeNowMs();
+		for(fftLoop=0; fftLoop<NUM_FFT_TO_COMPUTE; fftLoop++)
+			vlfft_execute( plan, pOut, pOut );
+		fftTime = (timeNowMs() - timer0)/NUM_FFT_TO_COMPUTE;
+
+		printf("  In place %s =    %f ms, %f Msamples/s \n", natural ? "natural   " : "transposed",
+		       fftTime, N/(fftTime*1000.0) );
+	}
+
+	return status;
+}
+
+
+/*********************************************************/
+/*  checks pOut and pStream, both the forward FFT of     */
+/*  pIn, by their energy and, up to 2^24 points, every   */
+/*  bin against the double precision reference; prints  */
+/*  the errors, returns 0 if all pass                    */
+/*********************************************************/
+static int validateOutput( Uint32 N, const float *pIn, const float *pOut, const float *pStream ) {
+	vlfftErrorStats_t stats, streamStats;
+	double *pRef, energyErr, streamErr;
+	int    status;
+
+	energyErr = vlfftEnergyCheck( N, pIn, pOut, 1.0 );
+	streamErr = vlfftEnergyCheck( N, pIn, pStream, 1.0 );
+	if( streamErr > energyErr )
+		energyErr = streamErr;
+	printf("  Energy check      =    %.2e relative error \n", energyErr );
+	status = energyErr > VLFFT_ENERGY_TOLERANCE;
+
+	if( N > (1U<<VLFFT_MAX_LOG2_REFERENCE) )
+		return status;
+
+	pRef = (double *)vlfftHostAlloc( VLFFT_REFERENCE_WORK_SIZE(N)*sizeof(double) );
+	if( pRef == NULL )
+		return 1;
+	if( vlfftReferenceFFT( N, pIn, VLFFT_FORWARD, 1.0, pRef ) != 0 ) {
+		printf("  Reference check   =    skipped, N has a prime factor above %u \n", VLFFT_VALIDATE_MAX_RADIX );
+		vlfftHostFree( pRef );
+		return status;
+	}
+
+	vlfftCompareReference( N, pOut,    pRef, &stats );
+	vlfftCompareReference( N, pStream, pRef, &streamStats );
+	printf("  Reference check   =    max abs error %.3e at bin %u, RMS %.3e, SNR %.1f dB (stream %.1f dB) \n",
+	       stats.maxAbsError, stats.maxErrorBin, stats.rmsError, stats.snrDb, streamStats.snrDb );
+	status |= stats.snrDb < VLFFT_MIN_SNR_DB || streamStats.snrDb < VLFFT_MIN_SNR_DB;
+
+	vlfftHostFree( pRef );
+	return status;
+}
+
+
+/* bins of an N-point forward DFT in double, spread over the whole spectrum */
+static void dftBins( size_t N, const float *pIn, const Uint32 *bins, Uint32 numBins, double *pRef ) {
+	Uint32 b;
+	size_t i;
+	double wRe, wIm, stepRe, stepIm, re, im, t;
+	const double PI = 3.14159265358979323846;
+
+	for( b=0; b<numBins; b++ ) {
+		stepRe = cos( 2.0*PI*bins[b]/N );
+		stepIm = -sin( 2.0*PI*bins[b]/N );
+		wRe = 1.0;
+		wIm = 0.0;
+		re  = 0.0;
+		im  = 0.0;
+		for( i=0; i<N; i++ ) {
+			re += pIn[2*i+1]*wRe - pIn[2*i]*wIm;
+			im += pIn[2*i+1]*wIm + pIn[2*i]*wRe;
+			t   = wRe*stepRe - wIm*stepIm;
+			wIm = wRe*stepIm + wIm*stepRe;
+			wRe = t;
+		}
+		pRef[2*b  ] = im;
+		pRef[2*b+1] = re;
+	}
+}
+
+
+/* white noise, xorshift32, so every bin carries signal */
+static void whiteNoise( size_t N, float *pIn ) {
+	Uint32 seed = 1;
+	size_t i;
+
+	for( i=0; i<2*N; i++ ) {
+		seed ^= seed << 13;
+		seed ^= seed >> 17;
+		seed ^= seed << 5;
+		pIn[i] = (float)(seed>>8)/16777216.0f - 0.5f;
+	}
+}
+
+
+/* white input and its dftBins() */
+static void whiteInput( Uint32 N, float *pIn, Uint32 *bins, double *pRef ) {
+	Uint32 i;
+
+	whiteNoise( N, pIn );
+	for( i=0; i<NUM_SNR_BINS; i++ )
+		bins[i] = (Uint32)(((unsigned long long)i*N)/NUM_SNR_BINS + i*7) % N;
+	dftBins( N, pIn, bins, NUM_SNR_BINS, pRef );
+}
+
+
+/* SNR in dB of pOut over the whiteInput() bins */
+static double binSnr( const float *pOut, const Uint32 *bins, const double *pRef ) {
+	Uint32 i;
+	double sig = 0.0, err = 0.0, d;
+
+	for( i=0; i<NUM_SNR_BINS; i++ ) {
+		sig += pRef[2*i]*pRef[2*i] + pRef[2*i+1]*pRef[2*i+1];
+		d    = pOut[2*bins[i]  ] - pRef[2*i  ];
+		err += d*d;
+		d    = pOut[2*bins[i]+1] - pRef[2*i+1];
+		err += d*d;
+	}
+	return err > 0.0 ? 10.0*log10( sig/err ) : 999.0;
+}
+
+
+/*********************************************************/
+/*  runs the forward FFT with each inter-pass twiddle    */
+/*  mode on the whiteInput(), prints time and SNR;       */
+/*  returns 0 if every mode reaches VLFFT_MIN_SNR_DB     */
+/*********************************************************/
+static int twiddleModeCheck( Uint32 N, Uint32 numCores, float *pIn, float *pOut, const Uint32 *bins, const double *pRef ) {
+	static const char *modeName[] = { "recursive", "table", "hybrid" };
+	vlfft_plan_t *plan;
+	Uint32  mode, fftLoop;
+	double  timer0, fftTime, snr;
+	int     status = 0;
+
+	for( mode=VLFFT_TWIDDLE_RECURSIVE; mode<=VLFFT_TWIDDLE_HYBRID; mode++ ) {
+		plan = vlfft_plan_create_twiddle( N, numCores, mode, 0 );
+		if( plan == NULL )
+			return 1;
+
+		vlfft_execute( plan, pIn, pOut );
+
+		timer0 = timeNowMs();
+		for(fftLoop=0; fftLoop<NUM_FFT_TO_COMPUTE; fftLoop++)
+			vlfft_execute( plan, pIn, pOut );
+		fftTime = (timeNowMs() - timer0)/NUM_FFT_TO_COMPUTE;
+
+		snr = binSnr( pOut, bins, pRef );
+
+		printf("  Twiddles %-9s=    %f ms, %f Msamples/s, SNR %.1f dB \n",
+		       modeName[mode], fftTime, N/(fftTime*1000.0), snr );
+		status |= snr < VLFFT_MIN_SNR_DB;
+	}
+
+	return status;
+}
+
+
+/*********************************************************/
+/*  the whiteInput() FFT with the intermediate in float, */
+/*  half and bfloat16: prints time, SNR and the traffic  */
+/*  through the intermediate (written once, read once);  */
+/*  returns 0 if each reaches its minimum SNR            */
+/*********************************************************/
+static int intermediateCheck( Uint32 N, Uint32 numCores, float *pIn, float *pOut, const Uint32 *bins, const double *pRef ) {
+	static const char   *formatName[] = { "float", "fp16", "bf16" };
+	static const double minSnr[]      = { VLFFT_MIN_SNR_DB, VLFFT_MIN_FP16_SNR_DB, VLFFT_MIN_BF16_SNR_DB };
+	vlfft_plan_t *plan;
+	Uint32  format, fftLoop;
+	double  timer0, fftTime, snr, workMB;
+	int     status = 0;
+
+	for( format=VLFFT_INTERMEDIATE_FLOAT; format<=VLFFT_INTERMEDIATE_BF16; format++ ) {
+		plan = vlfft_plan_create_intermediate( N, numCores, format );
+		if( plan == NULL )
+			return 1;
+
+		vlfft_execute( plan, pIn, pOut );
+
+		timer0 = timeNowMs();
+		for(fftLoop=0; fftLoop<NUM_FFT_TO_COMPUTE; fftLoop++)
+			vlfft_execute( plan, pIn, pOut );
+		fftTime = (timeNowMs() - timer0)/NUM_FFT_TO_COMPUTE;
+
+		snr    = binSnr( pOut, bins, pRef );
+		workMB = 2.0*N*(format == VLFFT_INTERMEDIATE_FLOAT ? BYTES_PER_COMPLEX_SAMPLE : BYTES_PER_PACKED_COMPLEX_SAMPLE)/1e6;
+
+		printf("  Intermediate %-5s=    %f ms, %f Msamples/s, SNR %.1f dB, %.1f MB at %.2f GB/s \n",
+		       formatName[format], fftTime, N/(fftTime*1000.0), snr, workMB, workMB/fftTime );
+		status |= snr < minSnr[format];
+	}
+
+	return status;
+}
+
+
+/* bin k of the forward DFT of a dims[0] x dims[1] x dims[2] array, dims[2] fastest, in double */
+static void dftBin3D( const Uint32 *dims, const float *pIn, const Uint32 *k, double *pRef ) {
+	double  *pW[3], re, im, w12Re, w12Im, wRe, wIm;
+	size_t  i;
+	Uint32  d, n1, n2, n3;
+	const double PI = 3.14159265358979323846;
+
+	for( d=0; d<3; d++ ) {
+		pW[d] = (double *)malloc( 2*(size_t)dims[d]*sizeof(double) );
+		for( i=0; i<dims[d]; i++ ) {
+			pW[d][2*i  ] = cos( 2.0*PI*(double)(((unsigned long long)k[d]*i)%dims[d])/dims[d] );
+			pW[d][2*i+1] = -sin( 2.0*PI*(double)(((unsigned long long)k[d]*i)%dims[d])/dims[d] );
+		}
+	}
+
+	re = 0.0;
+	im = 0.0;
+	i  = 0;
+	for( n1=0; n1<dims[0]; n1++ ) {
+		for( n2=0; n2<dims[1]; n2++ ) {
+			w12Re = pW[0][2*n1]*pW[1][2*n2] - pW[0][2*n1+1]*pW[1][2*n2+1];
+			w12Im = pW[0][2*n1]*pW[1][2*n2+1] + pW[0][2*n1+1]*pW[1][2*n2];
+			for( n3=0; n3<dims[2]; n3++, i++ ) {
+				wRe = w12Re*pW[2][2*n3] - w12Im*pW[2][2*n3+1];
+				wIm = w12Re*pW[2][2*n3+1] + w12Im*pW[2][2*n3];
+				re += pIn[2*i+1]*wRe - pIn[2*i]*wIm;
+				im += pIn[2*i+1]*wIm + pIn[2*i]*wRe;
+			}
+		}
+	}
+	pRef[0] = im;
+	pRef[1] = re;
+
+	for( d=0; d<3; d++ )
+		free( pW[d] );
+}
+
+
+/*********************************************************/
+/*  2D (dims[0] = 1) or 3D FFT of white noise: prints    */
+/*  the time of one and of the inverse, the SNR of a few */
+/*  bins against dftBin3D(); returns 0 if they reach     */
+/*  VLFFT_MIN_SNR_DB and the scaled inverse gives the    */
+/*  input back                                           */
+/*********************************************************/
+static int multiDimFFT( const Uint32 *dims, Uint32 numCores ) {
+	vlfft_plan_t *plan, *planInv;
+	float   *pIn, *pOut, *pBack;
+	Uint32  k[3], i, d, fftLoop;
+	double  ref[2], sig = 0.0, err = 0.0, e, timer0, fftTime, invTime, snr;
+	size_t  N, bin;
+	char    shape[64];
+	int     status;
+
+	N = (size_t)dims[0]*dims[1]*dims[2];
+	if( dims[0] == 1 )
+		snprintf( shape, sizeof(shape), "%u x %u", dims[1], dims[2] );
+	else
+		snprintf( shape, sizeof(shape), "%u x %u x %u", dims[0], dims[1], dims[2] );
+	if( dims[0] == 1 ) {
+		plan    = vlfft_plan_create_2d( dims[1], dims[2], numCores, VLFFT_FORWARD, FALSE );
+		planInv = vlfft_plan_create_2d( dims[1], dims[2], numCores, VLFFT_INVERSE, TRUE );
+	} else {
+		plan    = vlfft_plan_create_3d( dims[0], dims[1], dims[2], numCores, VLFFT_FORWARD, FALSE );
+		planInv = vlfft_plan_create_3d( dims[0], dims[1], dims[2], numCores, VLFFT_INVERSE, TRUE );
+	}
+	if( plan == NULL || planInv == NULL ) {
+		fprintf( stderr, "vlfft: no plan for %s on %u cores\n", shape, numCores );
+		return 1;
+	}
+
+	pIn   = (float *)vlfftHostAlloc( N*BYTES_PER_COMPLEX_SAMPLE );
+	pOut  = (float *)vlfftHostAlloc( N*BYTES_PER_COMPLEX_SAMPLE );
+	pBack = (float *)vlfftHostAlloc( N*BYTES_PER_COMPLEX_SAMPLE );
+	if( !pIn || !pOut || !pBack ) {
+		fprintf( stderr, "vlfft: out of memory\n" );
+		return 1;
+	}
+
+	whiteNoise( N, pIn );
+	vlfft_execute( plan, pIn, pOut );
+	vlfft_execute( planInv, pOut, pBack );
+
+	timer0 = timeNowMs();
+	for(fftLoop=0; fftLoop<NUM_FFT_TO_COMPUTE; fftLoop++)
+		vlfft_execute( plan, pIn, pOut );
+	fftTime = (timeNowMs() - timer0)/NUM_FFT_TO_COMPUTE;
+
+	timer0 = timeNowMs();
+	for(fftLoop=0; fftLoop<NUM_FFT_TO_COMPUTE; fftLoop++)
+		vlfft_execute( planInv, pOut, pBack );
+	invTime = (timeNowMs() - timer0)/NUM_FFT_TO_COMPUTE;
+
+	for( i=0; i<NUM_MULTIDIM_SNR_BINS; i++ ) {
+		for( d=0; d<3; d++ )
+			k[d] = (Uint32)(((unsigned long long)i*dims[d])/NUM_MULTIDIM_SNR_BINS + i*(d+3)) % dims[d];
+		dftBin3D( dims, pIn, k, ref );
+		bin  = ((size_t)k[0]*dims[1] + k[1])*dims[2] + k[2];
+		sig += ref[0]*ref[0] + ref[1]*ref[1];
+		e    = pOut[2*bin  ] - ref[0];
+		err += e*e;
+		e    = pOut[2*bin+1] - ref[1];
+		err += e*e;
+	}
+	snr = err > 0.0 ? 10.0*log10( sig/err ) : 999.0;
+
+	printf("%s FFT on %u cores \n", shape, numCores );
+	printf("  Avg time per fft  =    %f ms, %f Msamples/s \n", fftTime, N/(fftTime*1000.0) );
+	printf("  Inverse           =    %f ms, %f Msamples/s \n", invTime, N/(invTime*1000.0) );
+	printf("  SNR               =    %.1f dB over %u bins \n", snr, NUM_MULTIDIM_SNR_BINS );
+
+	status = snr < VLFFT_MIN_SNR_DB || relError( 2*N, pBack, pIn ) > VLFFT_REL_ERROR;
+
+	vlfft_plan_cleanup();
+
+	vlfftHostFree( pIn );
+	vlfftHostFree( pOut );
+	vlfftHostFree( pBack );
+
+	return status;
+}
+
+
+/*********************************************************/
+/*  overlap-save convolution and correlation of white    */
+/*  noise with a filterLen-tap filter, streamed in       */
+/*  chunks of every size from 1 sample up: prints the    */
+/*  throughput and the SNR of a few outputs against      */
+/*  direct filtering; returns 0 if they reach            */
+/*  VLFFT_MIN_SNR_DB                                     */
+/*********************************************************/
+static int convCheck( Uint32 N, Uint32 filterLen, Uint32 numCores ) {
+	vlfft_plan_t     *plan[2];
+	vlfftConvStats_t stats;
+	float   *pIn, *pOut, *pFilter, g[2];
+	size_t  len, pos, chunk, t, m, j;
+	double  sig, err, re, im, e, snr[2];
+	Uint32  c, i;
+	int     status = 0;
+
+	len     = (size_t)NUM_CONV_WINDOWS*N;
+	pIn     = (float *)vlfftHostAlloc( len*BYTES_PER_COMPLEX_SAMPLE );
+	pOut    = (float *)vlfftHostAlloc( len*BYTES_PER_COMPLEX_SAMPLE );
+	pFilter = (float *)vlfftHostAlloc( (size_t)filterLen*BYTES_PER_COMPLEX_SAMPLE );
+	if( !pIn || !pOut || !pFilter ) {
+		fprintf( stderr, "vlfft: out of memory\n" );
+		return 1;
+	}
+	whiteNoise( len, pIn );
+	whiteNoise( filterLen, pFilter );
+
+	for( c=0; c<2; c++ ) {
+		plan[c] = vlfft_plan_create_conv( N, numCores, pFilter, filterLen, c == 1 );
+		if( plan[c] == NULL ) {
+			fprintf( stderr, "vlfft: no convolution plan for N = %u, %u taps on %u cores\n", N, filterLen, numCores );
+			return 1;
+		}
+
+		// growing chunks, whole windows and odd pieces
+		for( pos=0, chunk=1; pos<len; pos+=chunk, chunk=chunk*5+3 ) {
+			if( chunk > len-pos )
+				chunk = len-pos;
+			vlfft_conv_stream( plan[c], pIn + 2*pos, (Uint32)chunk, pOut + 2*pos );
+		}
+
+		// y[t] = sum g[m] x[t-m], g the filter or its reversed conjugate
+		sig = 0.0;
+		err = 0.0;
+		for( i=0; i<NUM_CONV_SNR_OUTPUTS; i++ ) {
+			t  = i < NUM_CONV_SNR_OUTPUTS/4 ? i : ((size_t)i*(len/NUM_CONV_SNR_OUTPUTS) + i*13) % len;
+			re = 0.0;
+			im = 0.0;
+			for( m=0; m<filterLen && m<=t; m++ ) {
+				j    = c == 0 ? m : filterLen-1-m;
+				g[0] = c == 0 ? pFilter[2*j] : -pFilter[2*j];
+				g[1] = pFilter[2*j+1];
+				re  += (double)g[1]*pIn[2*(t-m)+1] - (double)g[0]*pIn[2*(t-m)];
+				im  += (double)g[1]*pIn[2*(t-m)  ] + (double)g[0]*pIn[2*(t-m)+1];
+			}
+			sig += re*re + im*im;
+			e    = pOut[2*t+1] - re;
+			err += e*e;
+			e    = pOut[2*t  ] - im;
+			err += e*e;
+		}
+		snr[c] = err > 0.0 ? 10.0*log10( sig/err ) : 999.0;
+
+		vlfft_conv_stats( plan[c], &stats, TRUE );
+		printf("%s, %u-point windows, %u taps, %u cores \n", c == 0 ? "Convolution" : "Correlation", N, filterLen, numCores );
+		printf("  Throughput        =    %f Msamples/s, %llu windows in %f ms \n",
+		       stats.samplesPerSec/1e6, stats.numBlocks, stats.totalMs );
+		printf("  SNR               =    %.1f dB over %u outputs \n", snr[c], NUM_CONV_SNR_OUTPUTS );
+		status |= snr[c] < VLFFT_MIN_SNR_DB;
+	}
+
+	vlfft_plan_cleanup();
+
+	vlfftHostFree( pIn );
+	vlfftHostFree( pOut );
+	vlfftHostFree( pFilter );
+
+	return status;
+}
+
+
+/* frames of the STFT benchmark checked against dftBins() */
+typedef struct {
+	vlfft_stft_t *stft;
+	const float  *pIn;
+	float        *pFrame;
+	double       sig;
+	double       err;
+} stftCheck_t;
+
+
+/* first frame of each batch, windowed, against its row */
+static void stftCheckRows( void *arg, unsigned long long firstFrame, Uint32 numFrames ) {
+	stftCheck_t  *check = (stftCheck_t *)arg;
+	vlfft_stft_t *stft  = check->stft;
+	const float  *pRow, *pSrc;
+	Uint32  bins[NUM_STFT_SNR_BINS];
+	double  ref[2*NUM_STFT_SNR_BINS], d;
+	Uint32  i;
+
+	(void)numFrames;
+	pRow = vlfft_stft_row( stft, firstFrame );
+	pSrc = check->pIn + 2*(size_t)firstFrame*stft->hop;
+	for( i=0; i<stft->windowLen; i++ ) {
+		check->pFrame[2*i  ] = pSrc[2*i  ]*stft->pWindow[i];
+		check->pFrame[2*i+1] = pSrc[2*i+1]*stft->pWindow[i];
+	}
+	for( i=0; i<NUM_STFT_SNR_BINS; i++ )
+		bins[i] = (Uint32)((((unsigned long long)i*stft->windowLen)/NUM_STFT_SNR_BINS + i*7 + firstFrame) % stft->windowLen);
+	dftBins( stft->windowLen, check->pFrame, bins, NUM_STFT_SNR_BINS, ref );
+
+	for( i=0; i<NUM_STFT_SNR_BINS; i++ ) {
+		check->sig += ref[2*i]*ref[2*i] + ref[2*i+1]*ref[2*i+1];
+		d           = pRow[2*bins[i]  ] - ref[2*i  ];
+		check->err += d*d;
+		d           = pRow[2*bins[i]+1] - ref[2*i+1];
+		check->err += d*d;
+	}
+}
+
+
+/*********************************************************/
+/*  STFT throughput over 1024 to 8192-point Hann         */
+/*  windows at 50% and 75% overlap: numSamples of white  */
+/*  noise pushed STFT_CHUNK at a time, the first frame   */
+/*  of every batch checked; returns 0 if all reach       */
+/*  VLFFT_MIN_SNR_DB                                     */
+/*********************************************************/
+static int stftBenchmark( Uint32 numCores, size_t numSamples ) {
+	static const Uint32 windowLens[] = { 1024, 2048, 4096, 8192 };
+	static const Uint32 overlaps[]   = { 2, 4 };   // hop = windowLen/overlap
+	vlfftStftStats_t stats;
+	stftCheck_t check;
+	float   *pIn;
+	size_t  pos, num;
+	Uint32  w, o;
+	double  snr;
+	int     status = 0;
+
+	pIn          = (float *)vlfftHostAlloc( numSamples*BYTES_PER_COMPLEX_SAMPLE );
+	check.pFrame = (float *)vlfftHostAlloc( 8192*BYTES_PER_COMPLEX_SAMPLE );
+	if( !pIn || !check.pFrame ) {
+		fprintf( stderr, "vlfft: out of memory\n" );
+		return 1;
+	}
+	whiteNoise( numSamples, pIn );
+	check.pIn = pIn;
+
+	printf("STFT of %zu samples on %u cores, %u per push \n", numSamples, numCores, STFT_CHUNK );
+	printf("  window    hop   Msamples/s     frames/s      SNR \n" );
+	for( w=0; w<sizeof(windowLens)/sizeof(windowLens[0]); w++ ) {
+		for( o=0; o<sizeof(overlaps)/sizeof(overlaps[0]); o++ ) {
+			check.stft = vlfft_stft_create( windowLens[w], windowLens[w]/overlaps[o], numCores, NULL,
+			                                numCores*VLFFT_STFT_FRAMES_PER_CORE, stftCheckRows, &check );
+			if( check.stft == NULL ) {
+				fprintf( stderr, "vlfft: no STFT of %u-point windows on %u cores\n", windowLens[w], numCores );
+				return 1;
+			}
+			check.sig = 0.0;
+			check.err = 0.0;
+
+			for( pos=0; pos<numSamples; pos+=num ) {
+				num = numSamples-pos < STFT_CHUNK ? numSamples-pos : STFT_CHUNK;
+				vlfft_stft_push( check.stft, pIn + 2*pos, num );
+			}
+
+			vlfft_stft_stats( check.stft, &stats, FALSE );
+			snr = check.err > 0.0 ? 10.0*log10( check.sig/check.err ) : 999.0;
+			printf("  %6u %6u %12.1f %12.0f %8.1f dB \n", windowLens[w], windowLens[w]/overlaps[o],
+			       stats.samplesPerSec/1e6, stats.numFrames/(stats.totalMs/1000.0), snr );
+			status |= snr < VLFFT_MIN_SNR_DB;
+
+			vlfft_stft_delete( check.stft );
+		}
+	}
+
+	vlfftHostFree( pIn );
+	vlfftHostFree( check.pFrame );
+
+	return status;
+}
+
+
+/* n-point stages as "8x8x4x4" */
+static void stagesName( Uint32 n, Uint32 stages, char *name ) {
+	Uint32 R;
+
+	name[0] = '\0';
+	for( ; n>1; n/=R ) {
+		R = 1U << ((stages&((1U<<VLFFT_BATCH_STAGE_BITS)-1))+1);
+		stages >>= VLFFT_BATCH_STAGE_BITS;
+		sprintf( name + strlen( name ), "%s%u", name[0] ? "x" : "", R );
+	}
+}
+
+
+/*********************************************************/
+/*  time per FFT and Msamples/s of the VLFFT_16K to      */
+/*  VLFFT_1024K sizes on the split vlfftConfigSelect()   */
+/*  picks, with both passes in the stages of radix 4,    */
+/*  then up to 8 and up to 16.  Each result is checked   */
+/*  against the radix-4 one                              */
+/*********************************************************/
+static int sizeBenchmark( Uint32 numCores ) {
+	static const Uint32 maxRadix[3] = { 4, 8, 16 };
+	vlfftHostEngine_t engine;
+	VLFFTconfig_t VLFFTconfig;
+	float   *pIn, *pWork, *pOut, *pRef;
+	double  timer0, ms, err;
+	Uint32  log2N, N, fftLoop, r;
+	char    name1[64], name2[64];
+	int     status = 0;
+
+	N     = 1U<<20;
+	pIn   = (float *)vlfftHostAlloc( (size_t)N*BYTES_PER_COMPLEX_SAMPLE );
+	pWork = (float *)vlfftHostAlloc( (size_t)N*BYTES_PER_COMPLEX_SAMPLE );
+	pOut  = (float *)vlfftHostAlloc( (size_t)N*BYTES_PER_COMPLEX_SAMPLE );
+	pRef  = (float *)vlfftHostAlloc( (size_t)N*BYTES_PER_COMPLEX_SAMPLE );
+	if( !pIn || !pWork || !pOut || !pRef ) {
+		fprintf( stderr, "vlfft: out of memory\n" );
+		return 1;
+	}
+	whiteNoise( N, pIn );
+
+	printf("batched FFT on %u cores, stages of radix 4 against radix 8 and 16 \n", numCores );
+	printf("        N     N1 x N2    1st pass     2nd pass       ms per FFT   Msamples/s   error \n" );
+	for( log2N=14; log2N<=20 && status==0; log2N++ ) {
+		N = 1U<<log2N;
+		for( r=0; r<3; r++ ) {
+			if( vlfftConfigSelect( &VLFFTconfig, N, numCores ) != 0 ||
+			    VLFFTconfig.radix_1stIter == VLFFT_RADIX_MIXED || VLFFTconfig.radix_2ndIter == VLFFT_RADIX_MIXED ) {
+				fprintf( stderr, "vlfft: no radix 2 or 4 plan for N = %u on %u cores\n", N, numCores );
+				status = 1;
+				break;
+			}
+			VLFFTconfig.stages_1stIter = vlfftBatchStages( VLFFTconfig.N1, maxRadix[r] );
+			VLFFTconfig.stages_2ndIter = vlfftBatchStages( VLFFTconfig.N2, maxRadix[r] );
+			if( vlfftHostEngineCreate( &engine, &VLFFTconfig ) != 0 ) {
+				fprintf( stderr, "vlfft: no plan for N = %u on %u cores\n", N, numCores );
+				status = 1;
+				break;
+			}
+
+			vlfftHostEngineRun( &engine, pIn, pWork, pOut );
+			timer0 = timeNowMs();
+			for( fftLoop=0; fftLoop<NUM_FFT_TO_COMPUTE; fftLoop++ )
+				vlfftHostEngineRun( &engine, pIn, pWork, pOut );
+			ms = (timeNowMs() - timer0)/NUM_FFT_TO_COMPUTE;
+			vlfftHostEngineDelete( &engine );
+
+			// radix 4 the reference
+			if( r == 0 )
+				memcpy( pRef, pOut, (size_t)N*BYTES_PER_COMPLEX_SAMPLE );
+			err = relError( 2*N, pOut, pRef );
+			status |= err > VLFFT_REL_ERROR;
+
+			stagesName( VLFFTconfig.N1, VLFFTconfig.stages_1stIter, name1 );
+			stagesName( VLFFTconfig.N2, VLFFTconfig.stages_2ndIter, name2 );
+			printf("  %7u %5u x %-5u %-12s %-12s %12.3f %12.1f %8.1e \n", N, VLFFTconfig.N1, VLFFTconfig.N2,
+			       name1, name2, ms, N/(ms*1000.0), err );
+		}
+	}
+
+	vlfftHostFree( pIn );
+	vlfftHostFree( pWork );
+	vlfftHostFree( pOut );
+	vlfftHostFree( pRef );
+
+	return status;
+}
+
+
+/*********************************************************/
+/*  out-of-core FFT of inPath into outPath, prints the   */
+/*  time against the time spent on the files and the    */
+/*  SNR of a few bins; returns 0 on success              */
+/*********************************************************/
+static int fileFFT( const char *inPath, const char *outPath, Uint32 numCores ) {
+	vlfftFileStats_t stats;
+	struct stat st;
+	const float *pIn, *pOut;
+	Uint32  bins[NUM_FILE_SNR_BINS];
+	double  ref[2*NUM_FILE_SNR_BINS];
+	double  sig = 0.0, err = 0.0, d, snr;
+	size_t  N, numBytes;
+	Uint32  i;
+	int     fdIn, fdOut;
+
+	if( vlfft_execute_file( inPath, NULL, outPath, numCores, &stats ) != 0 ) {
+		fprintf( stderr, "vlfft: cannot transform %s into %s\n", inPath, outPath );
+		return 1;
+	}
+
+	printf("  File FFT          =    %f s, %f Msamples/s \n", stats.totalMs/1000.0,
+	       stat( inPath, &st ) == 0 ? st.st_size/BYTES_PER_COMPLEX_SAMPLE/(stats.totalMs*1000.0) : 0.0 );
+	printf("  File I/O          =    read %f s, write %f s, %f MB/s, waited %f s for the workers \n",
+	       stats.readMs/1000.0, stats.writeMs/1000.0,
+	       stats.numBytes/((stats.readMs+stats.writeMs)*1000.0), stats.computeWaitMs/1000.0 );
+
+	fdIn  = open( inPath,  O_RDONLY );
+	fdOut = open( outPath, O_RDONLY );
+	if( fdIn < 0 || fdOut < 0 || fstat( fdIn, &st ) != 0 )
+		return 1;
+	numBytes = (size_t)st.st_size;
+	N        = numBytes/BYTES_PER_COMPLEX_SAMPLE;
+	pIn  = (const float *)mmap( NULL, numBytes, PROT_READ, MAP_SHARED, fdIn,  0 );
+	pOut = (const float *)mmap( NULL, numBytes, PROT_READ, MAP_SHARED, fdOut, 0 );
+	close( fdIn );
+	close( fdOut );
+	if( pIn == MAP_FAILED || pOut == MAP_FAILED )
+		return 1;
+
+	for( i=0; i<NUM_FILE_SNR_BINS; i++ )
+		bins[i] = (Uint32)(((unsigned long long)i*N)/NUM_FILE_SNR_BINS + i*7) % N;
+	dftBins( N, pIn, bins, NUM_FILE_SNR_BINS, ref );
+
+	for( i=0; i<NUM_FILE_SNR_BINS; i++ ) {
+		sig += ref[2*i]*ref[2*i] + ref[2*i+1]*ref[2*i+1];
+		d    = pOut[2*(size_t)bins[i]  ] - ref[2*i  ];
+		err += d*d;
+		d    = pOut[2*(size_t)bins[i]+1] - ref[2*i+1];
+		err += d*d;
+	}
+	snr = err > 0.0 ? 10.0*log10( sig/err ) : 999.0;
+	printf("  File FFT SNR      =    %.1f dB over %u bins \n", snr, NUM_FILE_SNR_BINS );
+
+	munmap( (void *)pIn,  numBytes );
+	munmap( (void *)pOut, numBytes );
+
+	return snr < VLFFT_MIN_SNR_DB;
+}
+
+
+/*********************************************************/
+/*  argv[first] on as numbers into pValue, at most       */
+/*  maxValues of them; returns how many, or -1 if one is */
+/*  not a number or there are too many                   */
+/*********************************************************/
+static int numericArgs( int argc, char *argv[], int first, unsigned long long *pValue, int maxValues ) {
+	char *end;
+	int  i;
+
+	if( argc - first > maxValues )
+		return -1;
+	for( i=first; i<argc; i++ ) {
+		if( argv[i][0] < '0' || argv[i][0] > '9' )
+			return -1;
+		pValue[i-first] = strtoull( argv[i], &end, 0 );
+		if( *end != '\0' )
+			return -1;
+	}
+	return argc > first ? argc - first : 0;
+}
+
+
+static int usage( FILE *fp ) {
+	fprintf( fp, "usage: vlfft_host [-t] [N [numCores]]\n"
+	             "       vlfft_host -f inFile outFile [numCores]\n"
+	             "       vlfft_host -2 N1 N2 [numCores]\n"
+	             "       vlfft_host -3 N1 N2 N3 [numCores]\n"
+	             "       vlfft_host -c N filterLen [numCores]\n"
+	             "       vlfft_host -s [numCores [numSamples]]\n"
+	             "       vlfft_host -k [numCores]\n" );
+	return fp == stdout ? 0 : 1;
+}
+
+
+/*
+ *  vlfft_host [-t] [N [numCores]]
+ *
+ *  N need not be a power of two, see vlfft_plan_create().  N and
+ *  numCores default to VLFFT_SIZE and NUM_CORES_FOR_FFT_COMPUTE
+ *  from vlfftconfig.h.  -t first tunes (N, numCores) and saves the
+ *  result to the wisdom file.  VLFFT_EDMA=1 runs the emulated EDMA and
+ *  reports how long each worker waited for it.  VLFFT_PROFILE=path
+ *  times every block of every core and writes the records to path.
+ *
+ *  vlfft_host -f inFile outFile [numCores]
+ *
+ *  out-of-core FFT of a file of N complex samples, N a power of two
+ *  up to 2^32
+ *
+ *  vlfft_host -2 N1 N2 [numCores]
+ *  vlfft_host -3 N1 N2 N3 [numCores]
+ *
+ *  2D or 3D FFT of N1 x N2 (x N3) complex samples, last size fastest
+ *
+ *  vlfft_host -c N filterLen [numCores]
+ *
+ *  overlap-save convolution and correlation through N-point windows
+ *
+ *  vlfft_host -s [numCores [numSamples]]
+ *
+ *  STFT throughput over window and hop sizes
+ *
+ *  vlfft_host -k [numCores]
+ *
+ *  16K to 1M-point FFT throughput with the batched kernel's stages of
+ *  radix 4 against those up to radix 8 and 16
+ *
+ *  vlfft_host -h, or any argument that is not a number where one is
+ *  expected, prints the usage
+ */
+int main( int argc, char *argv[] ) {
+	vlfft_plan_t  *plan, *planInv;
+	VLFFTconfig_t tuned;
+	float   *inData, *outData, *backData;
+	float   *frameIn[NUM_FFT_TO_COMPUTE], *frameOut[NUM_FFT_TO_COMPUTE];
+	Uint32  bins[NUM_SNR_BINS];
+	double  ref[2*NUM_SNR_BINS];
+	Uint32  N, numCores, fftLoop, dims[3], numDims, d;
+	double  timer0, fftTime;
+	unsigned long long value[4];
+	char    name1[64], name2[64];
+	int     status, tune, numValues;
+
+	if( argc > 1 && (strcmp( argv[1], "-h" ) == 0 || strcmp( argv[1], "--help" ) == 0) )
+		return usage( stdout );
+
+	if( argc > 1 && strcmp( argv[1], "-f" ) == 0 ) {
+		if( argc < 4 || (numValues = numericArgs( argc, argv, 4, value, 1 )) < 0 )
+			return usage( stderr );
+		numCores = numValues > 0 ? (Uint32)value[0] : NUM_CORES_FOR_FFT_COMPUTE;
+		status   = fileFFT( argv[2], argv[3], numCores );
+		printf( status == 0 ? "   Success!!!   \n" : "   Fail!!!   \n" );
+		return status;
+	}
+
+	if( argc > 1 && strcmp( argv[1], "-c" ) == 0 ) {
+		if( (numValues = numericArgs( argc, argv, 2, value, 3 )) < 2 )
+			return usage( stderr );
+		numCores = numValues > 2 ? (Uint32)value[2] : NUM_CORES_FOR_FFT_COMPUTE;
+		status   = convCheck( (Uint32)value[0], (Uint32)value[1], numCores );
+		printf( status == 0 ? "   Success!!!   \n" : "   Fail!!!   \n" );
+		return status;
+	}
+
+	if( argc > 1 && strcmp( argv[1], "-k" ) == 0 ) {
+		if( (numValues = numericArgs( argc, argv, 2, value, 1 )) < 0 )
+			return usage( stderr );
+		numCores = numValues > 0 ? (Uint32)value[0] : NUM_CORES_FOR_FFT_COMPUTE;
+		status   = sizeBenchmark( numCores );
+		printf( status == 0 ? "   Success!!!   \n" : "   Fail!!!   \n" );
+		return status;
+	}
+
+	if( argc > 1 && strcmp( argv[1], "-s" ) == 0 ) {
+		if( (numValues = numericArgs( argc, argv, 2, value, 2 )) < 0 )
+			return usage( stderr );
+		numCores = numValues > 0 ? (Uint32)value[0] : NUM_CORES_FOR_FFT_COMPUTE;
+		status   = stftBenchmark( numCores, numValues > 1 ? (size_t)value[1] : STFT_SAMPLES );
+		printf( status == 0 ? "   Success!!!   \n" : "   Fail!!!   \n" );
+		return status;
+	}
+
+	numDims = argc > 1 ? (strcmp( argv[1], "-2" ) == 0 ? 2 : strcmp( argv[1], "-3" ) == 0 ? 3 : 0) : 0;
+	if( numDims != 0 ) {
+		if( (numValues = numericArgs( argc, argv, 2, value, (int)numDims+1 )) < (int)numDims )
+			return usage( stderr );
+		dims[0] = 1;
+		for( d=0; d<numDims; d++ )
+			dims[3-numDims+d] = (Uint32)value[d];
+		numCores = numValues > (int)numDims ? (Uint32)value[numDims] : NUM_CORES_FOR_FFT_COMPUTE;
+		status   = multiDimFFT( dims, numCores );
+		printf( status == 0 ? "   Success!!!   \n" : "   Fail!!!   \n" );
+		return status;
+	}
+
+	tune = argc > 1 && strcmp( argv[1], "-t" ) == 0;
+	if( (numValues = numericArgs( argc, argv, tune ? 2 : 1, value, 2 )) < 0 )
+		return usage( stderr );
+
+	N        = numValues > 0 ? (Uint32)value[0] : VLFFT_SIZE;
+	numCores = numValues > 1 ? (Uint32)value[1] : NUM_CORES_FOR_FFT_COMPUTE;
+
+	if( tune ) {
+		if( vlfft_tune( N, numCores, &tuned, &fftTime ) != 0 ) {
+			fprintf( stderr, "vlfft: tuning N = %u on %u cores failed\n", N, numCores );
+			return 1;
+		}
+		stagesName( tuned.N1, tuned.stages_1stIter, name1 );
+		stagesName( tuned.N2, tuned.stages_2ndIter, name2 );
+		printf("tuned: %u x %u, radix %u/%u, stages %s/%s, %u samples per block, %f ms -> %s\n",
+		       tuned.N1, tuned.N2, tuned.radix_1stIter, tuned.radix_2ndIter,
+		       tuned.radix_1stIter == VLFFT_RADIX_MIXED ? "mixed" : name1,
+		       tuned.radix_2ndIter == VLFFT_RADIX_MIXED ? "mixed" : name2,
+		       tuned.samplesPerBlock, fftTime, vlfftWisdomPath() );
+	}
+
+	plan = vlfft_plan_create( N, numCores );
+	if( plan == NULL ) {
+		fprintf( stderr, "vlfft: no plan for N = %u on %u cores\n", N, numCores );
+		return 1;
+	}
+
+	inData   = (float *)vlfftHostAlloc( (size_t)N*BYTES_PER_COMPLEX_SAMPLE );
+	outData  = (float *)vlfftHostAlloc( (size_t)N*BYTES_PER_COMPLEX_SAMPLE );
+	backData = (float *)vlfftHostAlloc( (size_t)N*BYTES_PER_COMPLEX_SAMPLE );
+	if( !inData || !outData || !backData ) {
+		fprintf( stderr, "vlfft: out of memory\n" );
+		return 1;
+	}
+
+	printf("num of working cores: %u\n", plan->VLFFTconfig.numCoresForFftCompute );
+	printf("total size FFT: %u\n", plan->VLFFTconfig.N );
+	if( plan->convFwd != NULL ) {
+		/* Bluestein, the input pulse as for the M-point FFTs */
+		printf("Bluestein through %u-point FFTs\n", plan->convFwd->VLFFTconfig.N );
+		genFFTTestData( inData, N, plan->convFwd->VLFFTconfig.N2 );
+	} else {
+		printf("1st iter FFT: %u\n", plan->VLFFTconfig.N1 );
+		printf("2nd iter FFT: %u\n", plan->VLFFTconfig.N2 );
+		genFFTTestData( inData, N, plan->VLFFTconfig.N2 );
+	}
+
+	/* first run warms up the caches and page tables */
+	vlfft_execute( plan, inData, outData );
+
+	edmaReport( plan, 0, TRUE );
+
+	timer0 = timeNowMs();
+	for(fftLoop=0; fftLoop<NUM_FFT_TO_COMPUTE; fftLoop++)
+		vlfft_execute( plan, inData, outData );
+	fftTime = (timeNowMs() - timer0)/NUM_FFT_TO_COMPUTE;
+
+	printf("  Avg time per fft  =    %f ms \n", fftTime );
+	printf("  Throughput        =    %f Msamples/s, %f Msamples/s per core \n",
+	       N/(fftTime*1000.0), N/(fftTime*1000.0)/numCores );
+	edmaReport( plan, NUM_FFT_TO_COMPUTE, FALSE );
+	status = profileReport( plan, inData, outData );
+
+	/* the same frames as a pipelined stream, outputs alternate */
+	for(fftLoop=0; fftLoop<NUM_FFT_TO_COMPUTE; fftLoop++) {
+		frameIn[fftLoop]  = inData;
+		frameOut[fftLoop] = (fftLoop&0x1) ? backData : outData;
+	}
+	vlfft_execute_stream( plan, frameIn, frameOut, NUM_FFT_TO_COMPUTE );
+
+	timer0 = timeNowMs();
+	vlfft_execute_stream( plan, frameIn, frameOut, NUM_FFT_TO_COMPUTE );
+	fftTime = (timeNowMs() - timer0)/NUM_FFT_TO_COMPUTE;
+
+	printf("  Streaming         =    %f frames/s, %f Msamples/s \n",
+	       1000.0/fftTime, N/(fftTime*1000.0) );
+
+	status |= validateOutput( N, inData, outData, backData );
+	status |= transposeCheck();
+	status |= bufferDepthCheck( N, numCores, inData, outData, backData );
+	status |= inPlaceCheck( N, numCores, inData, outData, backData );
+	status |= dynamicCheck( N, numCores, inData, outData, backData );
+	if( plan->convFwd == NULL )
+		status |= prunedCheck( N, numCores, plan, inData, outData, backData );
+
+	/* scaled inverse of the result must give the input back */
+	planInv = vlfft_plan_create_inverse( N, numCores, TRUE );
+	if( planInv == NULL ) {
+		status = 1;
+	} else {
+		vlfft_execute( planInv, outData, backData );
+		status |= compare_float( 2*N, backData, inData );
+	}
+
+	status |= realFFTCheck( N, numCores, plan, backData, outData );
+
+	whiteInput( N, backData, bins, ref );
+	status |= twiddleModeCheck( N, numCores, backData, outData, bins, ref );
+	status |= intermediateCheck( N, numCores, backData, outData, bins, ref );
+	printf( status == 0 ? "   Success!!!   \n" : "   Fail!!!   \n" );
+
+	vlfft_plan_cleanup();
+
+	vlfftHostFree( inData );
+	vlfftHostFree( outData );
+	vlfftHostFree( backData );
+
+	return status;
+}
@@ -0,0 +1,396 @@
+/*
+ * vlfftHostEngineCreate()
+ * vlfftHostEngineRun()
+ * vlfftHostEngineDelete()
+ *
+ *    Multicore FFT on a Linux host.  Every DSP core is a worker thread
+ *    pinned to its own CPU; the 1st -> 2nd iteration hand-off is the
+ *    sense reversing barrier of vlfftBarrier.c, as on the DSP.  With
+ *    VLFFT_EDMA=1 in the environment each worker moves its blocks
+ *    through an emulated EDMA3 (vlfftEdmaHost.c) on a copy thread of
+ *    its own, otherwise it copies them itself
+ *
+ * Copyright (C) {2011} Texas Instruments Incorporated - http://www.ti.com/
+ *
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *    Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ *    Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the
+ *    distribution.
+ *
+ *    Neither the name of Texas Instruments Incorporated nor the names of
+ *    its contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ *  A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ *  OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *  SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *  LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ *  DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ *  THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ *  (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ *  OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+*/
+
+
+#define _GNU_SOURCE
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sched.h>
+#include <unistd.h>
+#include <pthread.h>
+
+#include "vlfftHostStd.h"
+
+/* vlfft.h */
+#include "../vlfftInc/vlfftDebug.h"
+#include "../vlfftInc/vlfftMessgQ.h"
+#include "../vlfftInc/vlfft.h"
+#include "../vlfftInc/vlfftconfig.h"
+#include "vlfftHost.h"
+
+
+void *vlfftHostAlloc( size_t numBytes ) {
+	void *p;
+
+	if( posix_memalign( &p, VLFFT_HOST_ALIGN, numBytes ) != 0 )
+		return NULL;
+	return p;
+}
+
+void vlfftHostFree( void *p ) {
+	free( p );
+}
+
+
+void vlfftHostPinToCpu( Uint32 coreNum ) {
+	cpu_set_t cpus;
+	long      numCpus;
+
+	numCpus = sysconf( _SC_NPROCESSORS_ONLN );
+	if( numCpus < 1 )
+		return;
+
+	CPU_ZERO( &cpus );
+	CPU_SET( coreNum % numCpus, &cpus );
+	pthread_setaffinity_np( pthread_self(), sizeof(cpus), &cpus );
+}
+
+
+/* a core's block records while the engine is profiled */
+static vlfftProfileCore_t *profileOf( vlfftHostEngine_t *engine, vlfftHostCore_t *core ) {
+	return engine->profiling ? &core->profile : NULL;
+}
+
+
+/* barrier wait, timed when profiled */
+static void profiledWait( vlfftHostEngine_t *engine, vlfftHostCore_t *core, vlfftBarrier_t *barrier, Uint32 *pSense ) {
+	vlfftProfileCore_t *prof = profileOf( engine, core );
+
+	if( prof != NULL )
+		vlfftProfileBegin( prof, VLFFT_PROFILE_PASS_SYNC, VLFFT_PROFILE_NO_BLOCK );
+	vlfftBarrierWait( barrier, core->coreNum, pSense );
+	if( prof != NULL )
+		vlfftProfileMark( prof, VLFFT_PROFILE_BARRIER );
+}
+
+
+/****************************************************************/
+/*    the workers' barrier around the passes and the optional   */
+/*    phases                                                    */
+/****************************************************************/
+void vlfftHostEngineSync( vlfftHostEngine_t *engine, Uint32 coreNum ) {
+	vlfftHostCore_t *core = &engine->core[coreNum];
+
+	profiledWait( engine, core, engine->phaseBarrier, &core->phaseSense );
+}
+
+
+/* shared block counter of pass (0 or 1) of frame, NULL when the split is static */
+static Uint32 *blockCounter( vlfftHostEngine_t *engine, Uint32 pass, Uint32 frame ) {
+	if( engine->VLFFTconfig.schedule != VLFFT_SCHEDULE_DYNAMIC )
+		return NULL;
+	return &engine->nextBlock[pass][frame&0x1];
+}
+
+
+/* intermediate of frame f; a 2D FFT has none besides its output */
+static float *streamWork( vlfftHostEngine_t *engine, Uint32 frame ) {
+	if( engine->VLFFTconfig.transform == VLFFT_TRANSFORM_2D )
+		return engine->ppOut[frame];
+	return engine->pWorkStream[frame&0x1];
+}
+
+
+/****************************************************************/
+/*    stream of frames: step s runs the 2nd iteration of frame  */
+/*    s-1 and the 1st iteration of frame s, so a core that is   */
+/*    done with one pass goes straight on to the other, and     */
+/*    there is one hand-off per frame instead of two.  The      */
+/*    intermediate is double buffered, the step barrier keeps   */
+/*    frame s+1 from overwriting what frame s-1 still reads.    */
+/*    So are the block counters of a dynamic schedule: the ones */
+/*    step s used are free for step s+2 once all cores are past */
+/*    the barrier of step s                                     */
+/****************************************************************/
+static void vlfftHostStream( vlfftHostEngine_t *engine, vlfftHostCore_t *core ) {
+	Uint32 step;
+
+	for( step=0; step<=engine->numFrames; step++ ) {
+		if( step > 0 )
+			VLFFT_2ndIter_host( streamWork( engine, step-1 ), engine->ppOut[step-1],
+			                    &core->VLFFTparams, &core->VLFFTbuffers, &core->dma,
+			                    blockCounter( engine, 1, step-1 ), profileOf( engine, core ), core->coreNum );
+
+		if( step < engine->numFrames ) {
+			VLFFT_1stIter_host( engine->ppIn[step], streamWork( engine, step ),
+			                    &core->VLFFTparams, &core->VLFFTbuffers, &core->dma,
+			                    blockCounter( engine, 0, step ), profileOf( engine, core ), core->coreNum );
+
+			vlfftHostEngineSync( engine, core->coreNum );
+
+			if( core->coreNum == 0 ) {
+				engine->nextBlock[0][step&0x1] = 0;
+				if( step > 0 )
+					engine->nextBlock[1][(step-1)&0x1] = 0;
+			}
+		}
+	}
+}
+
+
+/****************************************************************/
+/*    worker: the host counterpart of vlfft_slave()             */
+/****************************************************************/
+static void *vlfftHostWorker( void *arg ) {
+	vlfftHostCore_t   *core   = (vlfftHostCore_t *)arg;
+	vlfftHostEngine_t *engine = core->engine;
+
+	vlfftHostPinToCpu( core->coreNum );
+
+	while(1) {
+		vlfftBarrierWait( engine->startBarrier, core->coreNum, &core->startSense );
+		if( engine->mode == VLFFT_EXIT )
+			break;
+
+		if( engine->numFrames != 0 ) {
+			vlfftHostStream( engine, core );
+			profiledWait( engine, core, engine->doneBarrier, &core->doneSense );
+			continue;
+		}
+
+		if( engine->prePhase != NULL ) {
+			engine->prePhase( engine->phaseArg, core->coreNum, engine->numCores );
+			vlfftHostEngineSync( engine, core->coreNum );
+		}
+
+		VLFFT_1stIter_host( engine->pIn, engine->pWork, &core->VLFFTparams, &core->VLFFTbuffers, &core->dma,
+		                    blockCounter( engine, 0, 0 ), profileOf( engine, core ), core->coreNum );
+
+		/* the columns of a 3D FFT are done after pass 1 */
+		if( engine->VLFFTconfig.transform != VLFFT_TRANSFORM_COLUMNS ) {
+			vlfftHostEngineSync( engine, core->coreNum );
+
+			VLFFT_2ndIter_host( engine->pWork, engine->pOut, &core->VLFFTparams, &core->VLFFTbuffers, &core->dma,
+			                    blockCounter( engine, 1, 0 ), profileOf( engine, core ), core->coreNum );
+		}
+
+		if( engine->postPhase != NULL ) {
+			vlfftHostEngineSync( engine, core->coreNum );
+			engine->postPhase( engine->phaseArg, core->coreNum, engine->numCores );
+		}
+
+		profiledWait( engine, core, engine->doneBarrier, &core->doneSense );
+	}
+
+	return NULL;
+}
+
+
+static void coreBuffersFree( vlfftHostCore_t *core ) {
+	vlfftHostFree( core->pW1 );
+	vlfftHostFree( core->pW2 );
+	vlfftHostFree( core->pTwiddle );
+	vlfftHostFree( core->pTwiddleTable );
+	vlfftHostFree( core->pInBuf );
+	vlfftHostFree( core->pOutBuf );
+	vlfftHostFree( core->pWorkBuf0 );
+	vlfftHostFree( core->pfftInBuf );
+	vlfftHostFree( core->pfftOutBuf );
+	vlfftHostFree( core->profile.pBlock );
+	vlfftHostDmaDelete( &core->dma );
+}
+
+
+static Int32 coreBuffersAlloc( vlfftHostCore_t *core, const VLFFTconfig_t *VLFFTconfig ) {
+	size_t maxN, blockBytes, tableFloats;
+
+	maxN = VLFFTconfig->N1 > VLFFTconfig->N2 ? VLFFTconfig->N1 : VLFFTconfig->N2;
+	blockBytes = maxN*VLFFTconfig->samplesPerBlock*BYTES_PER_COMPLEX_SAMPLE;
+
+	core->pW1        = (float *)vlfftHostAlloc( VLFFTconfig->N1*BYTES_PER_COMPLEX_SAMPLE );
+	core->pW2        = (float *)vlfftHostAlloc( VLFFTconfig->N2*BYTES_PER_COMPLEX_SAMPLE );
+	core->pTwiddle   = (float *)vlfftHostAlloc( VLFFTconfig->N2*BYTES_PER_COMPLEX_SAMPLE );
+	core->pInBuf     = (float *)vlfftHostAlloc( VLFFTconfig->bufferDepth*blockBytes );
+	core->pOutBuf    = (float *)vlfftHostAlloc( VLFFTconfig->bufferDepth*blockBytes );
+	core->pWorkBuf0  = (float *)vlfftHostAlloc( blockBytes );
+	core->pfftInBuf  = (float *)vlfftHostAlloc( maxN*BYTES_PER_COMPLEX_SAMPLE );
+	core->pfftOutBuf = (float *)vlfftHostAlloc( maxN*BYTES_PER_COMPLEX_SAMPLE );
+
+	/* only the table and hybrid twiddle modes have a table */
+	tableFloats = vlfftTwiddleTableSize( VLFFTconfig );
+	core->pTwiddleTable = tableFloats ? (float *)vlfftHostAlloc( tableFloats*sizeof(float) ) : NULL;
+
+	if( !core->pW1 || !core->pW2 || !core->pTwiddle || !core->pInBuf || !core->pOutBuf ||
+	    !core->pWorkBuf0 || !core->pfftInBuf || !core->pfftOutBuf || (tableFloats && !core->pTwiddleTable) ||
+	    vlfftHostDmaInit( &core->dma, VLFFTconfig->emulateEdma || vlfftEdmaHostEnabled() ) != 0 ) {
+		coreBuffersFree( core );
+		return -1;
+	}
+	return 0;
+}
+
+
+static void barriersFree( vlfftHostEngine_t *engine ) {
+	vlfftHostFree( engine->startBarrier );
+	vlfftHostFree( engine->doneBarrier );
+	vlfftHostFree( engine->phaseBarrier );
+}
+
+
+/****************************************************************/
+/*    returns 0 on success, -1 if buffers or threads could not  */
+/*    be created                                                */
+/****************************************************************/
+Int32 vlfftHostEngineCreate( vlfftHostEngine_t *engine, const VLFFTconfig_t *VLFFTconfig ) {
+	Uint32          coreNum, numStarted;
+	vlfftHostCore_t *core;
+
+	memset( engine, 0, sizeof(*engine) );
+	engine->VLFFTconfig = *VLFFTconfig;
+	engine->numCores    = VLFFTconfig->numCoresForFftCompute;
+	engine->mode        = VLFFT_DO_NOTHING;
+
+	engine->core = (vlfftHostCore_t *)calloc( engine->numCores, sizeof(vlfftHostCore_t) );
+	if( engine->core == NULL )
+		return -1;
+
+	for( coreNum=0; coreNum<engine->numCores; coreNum++ ) {
+		core = &engine->core[coreNum];
+		core->engine  = engine;
+		core->coreNum = coreNum;
+
+		if( coreBuffersAlloc( core, VLFFTconfig ) != 0 ) {
+			while( coreNum-- )
+				coreBuffersFree( &engine->core[coreNum] );
+			free( engine->core );
+			return -1;
+		}
+
+		vlfftParamsConfigInit( &core->VLFFTparams, VLFFTconfig, core->pW1, core->pW2, core->pTwiddle, core->pTwiddleTable, coreNum );
+		vlfftBuffersInit( &core->VLFFTbuffers, core->pInBuf, core->pOutBuf, core->pWorkBuf0, core->pfftInBuf, core->pfftOutBuf );
+	}
+
+	engine->startBarrier = (vlfftBarrier_t *)vlfftHostAlloc( sizeof(vlfftBarrier_t) );
+	engine->doneBarrier  = (vlfftBarrier_t *)vlfftHostAlloc( sizeof(vlfftBarrier_t) );
+	engine->phaseBarrier = (vlfftBarrier_t *)vlfftHostAlloc( sizeof(vlfftBarrier_t) );
+	if( !engine->startBarrier || !engine->doneBarrier || !engine->phaseBarrier ) {
+		barriersFree( engine );
+		for( coreNum=0; coreNum<engine->numCores; coreNum++ )
+			coreBuffersFree( &engine->core[coreNum] );
+		free( engine->core );
+		return -1;
+	}
+	vlfftBarrierInit( engine->startBarrier, engine->numCores+1 );
+	vlfftBarrierInit( engine->doneBarrier,  engine->numCores+1 );
+	vlfftBarrierInit( engine->phaseBarrier, engine->numCores   );
+
+	for( numStarted=0; numStarted<engine->numCores; numStarted++ ) {
+		if( pthread_create( &engine->core[numStarted].thread, NULL, vlfftHostWorker, &engine->core[numStarted] ) != 0 )
+			break;
+	}
+	if( numStarted == engine->numCores )
+		return 0;
+
+	// the workers started wait at the start barrier for all numCores:
+	// count only them, before this thread is in, and let them exit
+	__atomic_store_n( &engine->startBarrier->numCores, numStarted+1, __ATOMIC_SEQ_CST );
+	engine->mode = VLFFT_EXIT;
+	vlfftBarrierWait( engine->startBarrier, numStarted, &engine->startSense );
+
+	for( coreNum=0; coreNum<numStarted; coreNum++ )
+		pthread_join( engine->core[coreNum].thread, NULL );
+	for( coreNum=0; coreNum<engine->numCores; coreNum++ )
+		coreBuffersFree( &engine->core[coreNum] );
+	barriersFree( engine );
+	free( engine->core );
+	return -1;
+}
+
+
+/****************************************************************/
+/*    one N-point FFT: pIn -> pWork (1st iter) -> pOut          */
+/****************************************************************/
+void vlfftHostEngineRun( vlfftHostEngine_t *engine, float *pIn, float *pWork, float *pOut ) {
+	engine->pIn   = pIn;
+	engine->pWork = pWork;
+	engine->pOut  = pOut;
+	engine->mode  = VLFFT_PROCESS_1stITER;
+	memset( engine->nextBlock, 0, sizeof(engine->nextBlock) );
+
+	vlfftBarrierWait( engine->startBarrier, engine->numCores, &engine->startSense );
+	vlfftBarrierWait( engine->doneBarrier,  engine->numCores, &engine->doneSense );
+}
+
+
+/****************************************************************/
+/*    numFrames FFTs ppIn[f] -> ppOut[f], pipelined; pWork[0]   */
+/*    and pWork[1] are both N-point intermediates, unused by 2D */
+/*    FFTs                                                      */
+/****************************************************************/
+void vlfftHostEngineRunStream( vlfftHostEngine_t *engine, float **ppIn, float **ppOut, float *pWork[2], Uint32 numFrames ) {
+	if( numFrames == 0 )
+		return;
+
+	engine->ppIn           = ppIn;
+	engine->ppOut          = ppOut;
+	engine->pWorkStream[0] = pWork[0];
+	engine->pWorkStream[1] = pWork[1];
+	engine->numFrames      = numFrames;
+	engine->mode           = VLFFT_PROCESS_1stITER;
+	memset( engine->nextBlock, 0, sizeof(engine->nextBlock) );
+
+	vlfftBarrierWait( engine->startBarrier, engine->numCores, &engine->startSense );
+	vlfftBarrierWait( engine->doneBarrier,  engine->numCores, &engine->doneSense );
+
+	engine->numFrames = 0;
+}
+
+
+void vlfftHostEngineDelete( vlfftHostEngine_t *engine ) {
+	Uint32 coreNum;
+
+	engine->mode = VLFFT_EXIT;
+	vlfftBarrierWait( engine->startBarrier, engine->numCores, &engine->startSense );
+
+	for( coreNum=0; coreNum<engine->numCores; coreNum++ ) {
+		pthread_join( engine->core[coreNum].thread, NULL );
+		coreBuffersFree( &engine->core[coreNum] );
+	}
+
+	barriersFree( engine );
+
+	free( engine->core );
+}
@@ -0,0 +1,530 @@
+/*
+ * VLFFT_1stIter_host()
+ * VLFFT_2ndIter_host()
+ *
+ *    1st and 2nd iteration computation of multicore FFT on a Linux host.
+ *    Same blocking and kernels as VLFFT_1stIter() and VLFFT_2ndIter();
+ *    the EDMA block transfers are done by the worker thread with
+ *    vlfftHostCopy2D().  The batched kernels FFT the columns of a block
+ *    where the transfer leaves them, so the DSP's transposes have no
+ *    counterpart here but for the rows of an in-place 2nd iteration
+ *
+ * Copyright (C) {2011} Texas Instruments Incorporated - http://www.ti.com/
+ *
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *    Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ *    Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the
+ *    distribution.
+ *
+ *    Neither the name of Texas Instruments Incorporated nor the names of
+ *    its contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ *  A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ *  OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *  SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *  LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ *  DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ *  THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ *  (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ *  OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+*/
+
+
+#include <string.h>
+
+#include "vlfftHostStd.h"
+
+/* vlfft.h */
+#include "../vlfftInc/vlfftDebug.h"
+#include "../vlfftInc/vlfftMessgQ.h"
+#include "../vlfftInc/vlfft.h"
+#include "../vlfftInc/vlfftconfig.h"
+#include "vlfftHost.h"
+
+
+/****************************************/
+/*  numRows x numBytes block transfer,  */
+/*  the host side of an aCnt/bCnt DMA   */
+/****************************************/
+void vlfftHostCopy2D( void *pDst, size_t dstStride, const void *pSrc, size_t srcStride, size_t numBytes, Uint32 numRows ) {
+	Uint32 row;
+
+	for( row=0; row<numRows; row++ )
+		memcpy( (char *)pDst + row*dstStride, (const char *)pSrc + row*srcStride, numBytes );
+}
+
+
+/*********************************************************/
+/*  PaRAM set for bCnt rows of aCnt bytes, or an empty   */
+/*  transfer (the DSP's aCnt = 4 placeholders) when      */
+/*  pSrc is NULL                                         */
+/*********************************************************/
+static void dmaBlock( vlfftHostDma_t *dma, EDMA3_DRV_PaRAMRegs *pParamSet, const void *pSrc, void *pDst,
+                      Uint32 aCnt, Uint32 bCnt, size_t srcBIdx, size_t dstBIdx ) {
+	if( pSrc == NULL ) {
+		pSrc = &dma->dummy[0];
+		pDst = &dma->dummy[1];
+		aCnt = sizeof(dma->dummy[0]);
+		bCnt = 1;
+	}
+	pParamSet->srcAddr  = (UArg)pSrc;
+	pParamSet->destAddr = (UArg)pDst;
+	pParamSet->aCnt     = aCnt;
+	pParamSet->bCnt     = bCnt;
+	pParamSet->cCnt     = 1;
+	pParamSet->srcBIdx  = (Int32)srcBIdx;
+	pParamSet->destBIdx = (Int32)dstBIdx;
+	pParamSet->srcCIdx  = 0;
+	pParamSet->destCIdx = 0;
+}
+
+
+/*********************************************************/
+/*  block in chained to block out on the channel pair    */
+/*  of ring slot `slot'; with the EDMA emulated they     */
+/*  overlap the compute until dmaWait() on that slot.    */
+/*  Each slot has its own channels and TCC, so up to     */
+/*  bufferDepth pairs can be in flight                   */
+/*********************************************************/
+static void dmaStart( vlfftHostDma_t *dma, Uint32 slot ) {
+	Uint32 chIn, chOut, tcc;
+
+	if( dma->hEdma == NULL ) {
+		vlfftEdmaTransfer( &dma->paramSet0 );
+		vlfftEdmaTransfer( &dma->paramSet1 );
+		return;
+	}
+
+	chIn  = dma->chId0 + 2*slot;
+	chOut = dma->chId1 + 2*slot;
+	tcc   = dma->tcc1  + 2*slot;
+	dma->paramSet0.opt = (dma->paramSet0.opt & ~OPT_TCC_MASK) | ((chOut << OPT_TCC_SHIFT) & OPT_TCC_MASK);
+	dma->paramSet1.opt = (dma->paramSet1.opt & ~OPT_TCC_MASK) | ((tcc << OPT_TCC_SHIFT) & OPT_TCC_MASK);
+
+	EDMA3_DRV_setPaRAM( dma->hEdma, chIn,  &dma->paramSet0 );
+	EDMA3_DRV_setPaRAM( dma->hEdma, chOut, &dma->paramSet1 );
+	edmaTrigger( dma->hEdma, chIn );
+}
+
+
+static void dmaWait( vlfftHostDma_t *dma, Uint32 slot ) {
+	if( dma->hEdma != NULL )
+		edmaPoll( dma->hEdma, dma->tcc1 + 2*slot );
+}
+
+
+/* time of the current block's phases, see vlfftProfile.c */
+#define PROFILE_BEGIN( pass, b ) do { if( prof != NULL ) vlfftProfileBegin( prof, pass, b ); } while( 0 )
+#define PROFILE_MARK( phase )    do { if( prof != NULL ) vlfftProfileMark( prof, phase ); } while( 0 )
+
+
+/*********************************************************/
+/*  block moved by this core's q-th transfer: the q-th   */
+/*  of its static share, or with a shared counter the    */
+/*  next block nobody has claimed; numBlks for none.     */
+/*  Claims are in order, so once one comes back empty    */
+/*  all later ones do                                    */
+/*********************************************************/
+static Uint32 claimBlock( Uint32 *pNextBlk, Uint32 q, Uint32 numBlks ) {
+	if( pNextBlk != NULL )
+		q = __atomic_fetch_add( pNextBlk, 1, __ATOMIC_RELAXED );
+	return q < numBlks ? q : numBlks;
+}
+
+
+/*********************************************************/
+/*  rows [*pRow0, *pRow1) of the N1 x N2 input that can  */
+/*  be nonzero in the columns of 1st iteration block     */
+/*  blkIdx, an empty range if the block is all zeros     */
+/*********************************************************/
+static void prunedRows( const VLFFTparams_t *VLFFTparams, Uint32 blkIdx, Uint32 *pRow0, Uint32 *pRow1 ) {
+	size_t col0, col1, N2;
+
+	N2   = VLFFTparams->N2;
+	col0 = VLFFTparams->offset1stIterIn/BYTES_PER_COMPLEX_SAMPLE + (size_t)blkIdx*VLFFTparams->samplesPerBlock;
+	col1 = col0 + VLFFTparams->samplesPerBlock - 1;
+
+	*pRow0 = VLFFTparams->inputBegin > col1 ? (Uint32)((VLFFTparams->inputBegin - col1 + N2 - 1)/N2) : 0;
+	*pRow1 = VLFFTparams->inputEnd   > col0 ? (Uint32)((VLFFTparams->inputEnd - 1 - col0)/N2 + 1) : 0;
+}
+
+
+/*********************************************************/
+/*  whether 2nd iteration block blkIdx, k1 = k mod N1 of */
+/*  samplesPerBlock bins k, holds a requested bin; rows  */
+/*  k2 [*pRow0, *pRow1) are the ones that can            */
+/*********************************************************/
+static Bool prunedBins( const VLFFTparams_t *VLFFTparams, Uint32 blkIdx, Uint32 *pRow0, Uint32 *pRow1 ) {
+	size_t k1, first, num, N1;
+
+	N1 = VLFFTparams->N1;
+	k1 = VLFFTparams->offset2ndIterOut/BYTES_PER_COMPLEX_SAMPLE + (size_t)blkIdx*VLFFTparams->samplesPerBlock;
+
+	*pRow0 = (Uint32)(VLFFTparams->outputBegin/N1);
+	*pRow1 = (Uint32)((VLFFTparams->outputEnd - 1)/N1 + 1);
+
+	// k1 of the requested bins: first .. first+num-1 mod N1
+	num   = VLFFTparams->outputEnd - VLFFTparams->outputBegin;
+	first = VLFFTparams->outputBegin % N1;
+	if( num >= N1 )
+		return TRUE;
+	return (k1 < first+num && first < k1+VLFFTparams->samplesPerBlock) || (first+num > N1 && k1 < first+num-N1);
+}
+
+
+/*********************************************************/
+/*  compute N2/numCores FFTs of size N1, samplesPerBlock */
+/*  (normally 8) per block:                              */
+/*  gather columns -> batched FFT -> twiddle ->          */
+/*  store rows of the N2 x N1 intermediate, packed to 16 */
+/*  bits if asked, or in place back into columns and     */
+/*  store over the input columns.  2D and columns alone  */
+/*  leave out the twiddle and go in place.               */
+/*  In and out blocks go through rings of bufferDepth    */
+/*  (2 is the DSP's ping-pong): transfer q moves the     */
+/*  block it claims into ring slot q%depth and the block */
+/*  of transfer q-depth out of it, and transfers q+1 ..  */
+/*  q+depth-1 run while the block of q is computed.      */
+/*  pNextBlk, NULL for the static split, is the pass's   */
+/*  shared block counter, prof NULL unless profiled.     */
+/*  Pruned, the rows of a block that can only be zero    */
+/*  are not read: an all zero block is not FFTed, one    */
+/*  with only row 0 needs no FFT, every bin is row 0     */
+/*********************************************************/
+void VLFFT_1stIter_host( float          *pIn,
+                         float          *pOut,
+                         VLFFTparams_t  *VLFFTparams,
+                         VLFFTbuffers_t *VLFFTbuffers,
+                         vlfftHostDma_t *dma,
+                         Uint32         *pNextBlk,
+                         vlfftProfileCore_t *prof,
+                         Uint32         coreNum ) {
+	Uint32 blkIdx, numBlks, fftIdx, numFFTs, depth, slot, q, issueSlot, outBlk;
+	Uint32 blkId[VLFFT_MAX_BUFFER_DEPTH];
+	Uint32 fftSize, fftSize2, blkFloats, anchorStep, numAnchors, outBCnt, workBytes, fftStride, outStride;
+	Uint32 row0, row1, k;
+	size_t stepInSrc, stepInDst, stepOutDst, outACnt, outDstBIdx, rowFloats;
+	float  *pW1, *pTwiddle, *pInBufInternal, *pOutBufInternal, *pWorkBuf0Internal;
+	float  *pInBlk, *pOutBlk, *pFftBlk, *pBatch;
+	char   *ptrInDDR, *ptrOutDDR;
+	float  wStepRe, wStepIm, packScale, colScale;
+	Bool   packed, mixed, fused;
+	const float *pAnchor;
+
+	(void)coreNum;
+
+	fftSize   = VLFFTparams->N1;
+	fftSize2  = VLFFTparams->N1*2;
+	blkFloats = fftSize2*VLFFTparams->samplesPerBlock;
+	pW1       = VLFFTparams->pW1;
+	pTwiddle  = VLFFTparams->pTwiddle;
+	numBlks   = VLFFTparams->numBlocksPerCore1stIter;
+	numFFTs   = VLFFTparams->numFFTsPerBlock1stIter;
+	depth     = VLFFTparams->bufferDepth;
+	mixed     = VLFFTparams->radix_1stIter == VLFFT_RADIX_MIXED;
+	colScale  = VLFFTparams->transform == VLFFT_TRANSFORM_COLUMNS ? VLFFTparams->scale : 1.0f;
+
+	/* half precision intermediate scaled by 1/N1, the most an N1-point FFT can grow */
+	packed    = VLFFTparams->intermediate != VLFFT_INTERMEDIATE_FLOAT;
+	workBytes = packed ? BYTES_PER_PACKED_COMPLEX_SAMPLE : BYTES_PER_COMPLEX_SAMPLE;
+	packScale = VLFFTparams->intermediate == VLFFT_INTERMEDIATE_FP16 ? 1.0f/fftSize : 1.0f;
+
+	/* 2 floats per anchor, ceil(N1/anchorStep) anchors per FFT */
+	anchorStep = VLFFTparams->twiddleAnchorStep;
+	numAnchors = anchorStep ? (fftSize+anchorStep-1)/anchorStep : 0;
+	pAnchor    = NULL;
+
+	pInBufInternal    = VLFFTbuffers->pInBufInternal;
+	pOutBufInternal   = VLFFTbuffers->pOutBufInternal;
+	pWorkBuf0Internal = VLFFTbuffers->pWorkBuf0Internal;
+
+	stepInSrc  = VLFFTparams->samplesPerBlock*BYTES_PER_COMPLEX_SAMPLE;
+	stepInDst  = VLFFTparams->samplesPerBlock*BYTES_PER_COMPLEX_SAMPLE;
+	stepOutDst = VLFFTparams->N1*VLFFTparams->samplesPerBlock*workBytes;
+	outACnt    = stepOutDst;
+	outBCnt    = 1;
+	outDstBIdx = stepOutDst;
+	if( VLFFTparams->inPlace ) {
+		stepOutDst = stepInSrc;
+		outACnt    = stepInDst;
+		outBCnt    = fftSize;
+		outDstBIdx = VLFFTparams->step1stIterOut;
+	}
+
+	ptrInDDR  = (char *)pIn  + VLFFTparams->offset1stIterIn;
+	ptrOutDDR = (char *)pOut + VLFFTparams->offset1stIterOut;
+
+	rowFloats = 2*(size_t)numFFTs;
+
+	/* N1 rows x samplesPerBlock in, row pitch N2 samples, but  */
+	/* only the rows that can be nonzero; rows of N1 samples    */
+	/* out, contiguous in the intermediate, or in place the     */
+	/* same N1 rows the block came from                         */
+#define DMA_IN( b, s )  do { prunedRows( VLFFTparams, b, &row0, &row1 ); \
+                             dmaBlock( dma, &dma->paramSet0, (b) < numBlks && row1 > 1 && row0 < row1 ? \
+                                       ptrInDDR + stepInSrc*(b) + (size_t)VLFFTparams->step1stIterIn*row0 : NULL, \
+                                       pInBufInternal + blkFloats*(s) + rowFloats*row0, stepInDst, row1-row0, \
+                                       VLFFTparams->step1stIterIn, stepInDst ); } while( 0 )
+#define DMA_OUT( b, s ) dmaBlock( dma, &dma->paramSet1, (b) < numBlks ? pOutBufInternal + blkFloats*(s) : NULL, \
+                                  ptrOutDDR + stepOutDst*(b), outACnt, outBCnt, outACnt, outDstBIdx )
+#define DMA_ISSUE( q ) do { issueSlot = (q)%depth; outBlk = blkId[issueSlot]; blkId[issueSlot] = claimBlock( pNextBlk, q, numBlks ); \
+                            DMA_IN( blkId[issueSlot], issueSlot ); DMA_OUT( outBlk, issueSlot ); dmaStart( dma, issueSlot ); } while( 0 )
+
+	for( q=0; q<depth; q++ )
+		blkId[q] = numBlks;
+	for( q=0; q<depth-1; q++ )
+		DMA_ISSUE( q );
+
+	for( q=0; blkId[q%depth]<numBlks; q++ ) {
+		/* block blkIdx in, its slot's old out block gone */
+		slot   = q%depth;
+		blkIdx = blkId[slot];
+		PROFILE_BEGIN( 0, blkIdx );
+		dmaWait( dma, slot );
+		DMA_ISSUE( q+depth-1 );
+		PROFILE_MARK( VLFFT_PROFILE_DMA );
+
+		pInBlk  = pInBufInternal  + blkFloats*slot;
+		pOutBlk = pOutBufInternal + blkFloats*slot;
+
+		/* 2D: the columns FFTed into the out slot in natural */
+		/* order, the layout they came in, and no twiddles    */
+		if( VLFFTparams->transform != VLFFT_TRANSFORM_1D ) {
+			if( mixed ) {
+				vlfftBatchMixedFFT( fftSize, numFFTs, pInBlk, pOutBlk, pW1, VLFFTparams->direction, colScale );
+			} else {
+				vlfftBatchFFTStages( fftSize, numFFTs, pInBlk, pW1, VLFFTparams->direction, VLFFTparams->stages_1stIter );
+				vlfftBatchFFTRows( fftSize, numFFTs, pInBlk, pOutBlk, colScale );
+			}
+			PROFILE_MARK( VLFFT_PROFILE_FFT );
+			continue;
+		}
+
+		/* pruned: zeros out for a zero block */
+		prunedRows( VLFFTparams, blkIdx, &row0, &row1 );
+		if( row0 >= row1 ) {
+			memset( pOutBlk, 0, blkFloats*sizeof(float) );
+			PROFILE_MARK( VLFFT_PROFILE_FFT );
+			continue;
+		}
+
+		/* the block's columns FFTed together where they came in, */
+		/* mixed radix sizes into the work buffer                 */
+		pBatch  = pInBlk;
+		pFftBlk = packed ? pWorkBuf0Internal : pOutBlk;
+		if( mixed ) {
+			pBatch  = pWorkBuf0Internal;
+			pFftBlk = packed ? pInBlk : pOutBlk;
+		}
+
+		/* twiddled into rows of the out slot, in place back into */
+		/* columns, packed by way of a spare buffer; with the     */
+		/* recurrence in the last radix stage of the FFT          */
+		fftStride = VLFFTparams->inPlace ? 1 : fftSize;
+		outStride = VLFFTparams->inPlace ? numFFTs : 1;
+		fused     = row1 > 1 && !mixed && VLFFTparams->pTwiddleTable == NULL;
+		if( row1 == 1 ) {
+			for( k=0; k<fftSize; k++ )
+				memcpy( pBatch + rowFloats*k, ptrInDDR + stepInSrc*blkIdx, rowFloats*sizeof(float) );
+		} else {
+			memset( pInBlk, 0, rowFloats*row0*sizeof(float) );
+			memset( pInBlk + rowFloats*row1, 0, rowFloats*(fftSize-row1)*sizeof(float) );
+			if( mixed )
+				vlfftBatchMixedFFT( fftSize, numFFTs, pInBlk, pWorkBuf0Internal, pW1, VLFFTparams->direction, 1.0f );
+			else if( fused )
+				vlfftBatchFFTStagesTw( fftSize, numFFTs, pInBlk, pW1, VLFFTparams->direction, VLFFTparams->stages_1stIter,
+				                       &pTwiddle[blkIdx*numFFTs*2], pFftBlk, fftStride, outStride );
+			else
+				vlfftBatchFFTStages( fftSize, numFFTs, pInBlk, pW1, VLFFTparams->direction, VLFFTparams->stages_1stIter );
+		}
+		PROFILE_MARK( VLFFT_PROFILE_FFT );
+
+		for( fftIdx=0; fftIdx<numFFTs && !fused; fftIdx++ ) {
+			wStepRe = pTwiddle[blkIdx*numFFTs*2 + 2*fftIdx    ];
+			wStepIm = pTwiddle[blkIdx*numFFTs*2 + 2*fftIdx + 1];
+			if( VLFFTparams->pTwiddleTable != NULL )
+				pAnchor = VLFFTparams->pTwiddleTable + 2*(blkIdx*numFFTs + fftIdx)*numAnchors;
+
+			multTwiddle_vec_batch( pBatch, numFFTs, fftIdx, !mixed, wStepRe, wStepIm, fftSize,
+			                       &pFftBlk[2*fftStride*fftIdx], outStride, pAnchor, anchorStep );
+		}
+		PROFILE_MARK( VLFFT_PROFILE_TWIDDLE );
+
+		if( packed ) {
+			vlfftPackIntermediate( pFftBlk, (Uint16 *)pOutBlk, blkFloats, VLFFTparams->intermediate, packScale );
+			PROFILE_MARK( VLFFT_PROFILE_PACK );
+		}
+	}
+
+	/* last block out, drain the ring */
+	PROFILE_BEGIN( 0, VLFFT_PROFILE_NO_BLOCK );
+	DMA_ISSUE( q+depth-1 );
+	for( slot=0; slot<depth; slot++ )
+		dmaWait( dma, slot );
+	PROFILE_MARK( VLFFT_PROFILE_DMA );
+
+#undef DMA_IN
+#undef DMA_OUT
+#undef DMA_ISSUE
+}
+
+
+/*********************************************************/
+/*  compute N1/numCores FFTs of size N2, samplesPerBlock */
+/*  per block:                                           */
+/*  gather columns (unpacked if 16 bit) -> batched FFT   */
+/*  -> rows back in natural order ->                     */
+/*  store columns of the N2 x N1 output, through the     */
+/*  same buffer rings as the 1st iteration.  In place    */
+/*  a block is samplesPerBlock whole rows of N2 samples, */
+/*  transposed to columns for the batched FFT and back.  */
+/*  Pruned, blocks with no requested bin are skipped and */
+/*  only the rows with one are stored                    */
+/*********************************************************/
+void VLFFT_2ndIter_host( float          *pIn,
+                         float          *pOut,
+                         VLFFTparams_t  *VLFFTparams,
+                         VLFFTbuffers_t *VLFFTbuffers,
+                         vlfftHostDma_t *dma,
+                         Uint32         *pNextBlk,
+                         vlfftProfileCore_t *prof,
+                         Uint32         coreNum ) {
+	Uint32 blkIdx, numBlks, numFFTs, depth, slot, q, issueSlot, outBlk;
+	Uint32 blkId[VLFFT_MAX_BUFFER_DEPTH];
+	Uint32 fftSize, fftSize2, blkFloats, bCnt, row0, row1;
+	size_t stepInSrc, stepInDst, stepOutDst, aCnt, inACnt, rowFloats;
+	float  *pW2, *pInBufInternal, *pOutBufInternal, *pWorkBuf0Internal;
+	float  *pInBlk, *pOutBlk, *pBatch, *pFftBlk;
+	char   *ptrInDDR, *ptrOutDDR;
+	float  unpackScale;
+	Bool   packed, needed;
+
+	(void)coreNum;
+
+	fftSize   = VLFFTparams->N2;
+	fftSize2  = VLFFTparams->N2*2;
+	blkFloats = fftSize2*VLFFTparams->samplesPerBlock;
+	pW2       = VLFFTparams->pW2;
+	numBlks   = VLFFTparams->numBlocksPerCore2ndIter;
+	numFFTs   = VLFFTparams->numFFTsPerBlock2ndIter;
+	depth     = VLFFTparams->bufferDepth;
+
+	packed      = VLFFTparams->intermediate != VLFFT_INTERMEDIATE_FLOAT;
+	unpackScale = VLFFTparams->intermediate == VLFFT_INTERMEDIATE_FP16 ? (float)VLFFTparams->N1 : 1.0f;
+
+	pInBufInternal    = VLFFTbuffers->pInBufInternal;
+	pOutBufInternal   = VLFFTbuffers->pOutBufInternal;
+	pWorkBuf0Internal = VLFFTbuffers->pWorkBuf0Internal;
+
+	stepInSrc  = VLFFTparams->samplesPerBlock*(packed ? BYTES_PER_PACKED_COMPLEX_SAMPLE : BYTES_PER_COMPLEX_SAMPLE);
+	stepInDst  = VLFFTparams->samplesPerBlock*BYTES_PER_COMPLEX_SAMPLE;
+	stepOutDst = VLFFTparams->samplesPerBlock*BYTES_PER_COMPLEX_SAMPLE;
+	aCnt       = stepInDst;
+	inACnt     = stepInSrc;
+	bCnt       = fftSize;
+	if( VLFFTparams->inPlace ) {
+		stepInSrc  = blkFloats*sizeof(float);
+		stepOutDst = stepInSrc;
+		aCnt       = stepInSrc;
+		inACnt     = stepInSrc;
+		bCnt       = 1;
+	}
+
+	ptrInDDR  = (char *)pIn  + VLFFTparams->offset2ndIterIn;
+	ptrOutDDR = (char *)pOut + VLFFTparams->offset2ndIterOut;
+	rowFloats = aCnt/sizeof(float);
+
+	/* N2 rows x samplesPerBlock, row pitch N1 samples, both ways, */
+	/* out only the rows with requested bins; in place one run of  */
+	/* samplesPerBlock rows of N2 samples                          */
+#define NEEDED( b )     ((b) < numBlks && (VLFFTparams->inPlace || prunedBins( VLFFTparams, b, &row0, &row1 )))
+#define DMA_IN( b, s )  dmaBlock( dma, &dma->paramSet0, NEEDED( b ) ? ptrInDDR + stepInSrc*(b) : NULL, \
+                                  pInBufInternal + blkFloats*(s), inACnt, bCnt, VLFFTparams->step2ndIterIn, inACnt )
+#define DMA_OUT( b, s ) do { row0 = 0; row1 = bCnt; needed = NEEDED( b ); \
+                             dmaBlock( dma, &dma->paramSet1, needed ? pOutBufInternal + blkFloats*(s) + rowFloats*row0 : NULL, \
+                                       ptrOutDDR + stepOutDst*(b) + (size_t)VLFFTparams->step2ndIterOut*row0, aCnt, row1-row0, \
+                                       aCnt, VLFFTparams->step2ndIterOut ); } while( 0 )
+#define DMA_ISSUE( q ) do { issueSlot = (q)%depth; outBlk = blkId[issueSlot]; blkId[issueSlot] = claimBlock( pNextBlk, q, numBlks ); \
+                            DMA_IN( blkId[issueSlot], issueSlot ); DMA_OUT( outBlk, issueSlot ); dmaStart( dma, issueSlot ); } while( 0 )
+
+	for( q=0; q<depth; q++ )
+		blkId[q] = numBlks;
+	for( q=0; q<depth-1; q++ )
+		DMA_ISSUE( q );
+
+	for( q=0; blkId[q%depth]<numBlks; q++ ) {
+		slot   = q%depth;
+		blkIdx = blkId[slot];
+		PROFILE_BEGIN( 1, blkIdx );
+		dmaWait( dma, slot );
+		DMA_ISSUE( q+depth-1 );
+		PROFILE_MARK( VLFFT_PROFILE_DMA );
+
+		pInBlk  = pInBufInternal  + blkFloats*slot;
+		pOutBlk = pOutBufInternal + blkFloats*slot;
+
+		if( !VLFFTparams->inPlace && !prunedBins( VLFFTparams, blkIdx, &row0, &row1 ) ) {
+			PROFILE_MARK( VLFFT_PROFILE_FFT );
+			continue;
+		}
+
+		/* the block's columns FFTed together in the in slot, or in */
+		/* the work buffer once unpacked, and their rows reordered  */
+		/* into the out slot.  In place the rows are turned into    */
+		/* columns in the work buffer first, and the result back    */
+		/* from the in slot into rows                               */
+		pBatch  = pInBlk;
+		pFftBlk = pOutBlk;
+		if( VLFFTparams->inPlace ) {
+			vlfftTransposeStrided( pInBlk, fftSize, pWorkBuf0Internal, numFFTs, numFFTs, fftSize );
+			pBatch  = pWorkBuf0Internal;
+			pFftBlk = pInBlk;
+		} else if( packed ) {
+			vlfftUnpackIntermediate( (const Uint16 *)pInBlk, pWorkBuf0Internal, blkFloats, VLFFTparams->intermediate, unpackScale );
+			PROFILE_MARK( VLFFT_PROFILE_PACK );
+			pBatch = pWorkBuf0Internal;
+		}
+
+		if( VLFFTparams->radix_2ndIter == VLFFT_RADIX_MIXED ) {
+			vlfftBatchMixedFFT( fftSize, numFFTs, pBatch, pFftBlk, pW2, VLFFTparams->direction, VLFFTparams->scale );
+		} else {
+			vlfftBatchFFTStages( fftSize, numFFTs, pBatch, pW2, VLFFTparams->direction, VLFFTparams->stages_2ndIter );
+			vlfftBatchFFTRows( fftSize, numFFTs, pBatch, pFftBlk, VLFFTparams->scale );
+		}
+
+		if( VLFFTparams->inPlace ) {
+			vlfftTransposeStrided( pInBlk, numFFTs, pOutBlk, fftSize, fftSize, numFFTs );
+			PROFILE_MARK( VLFFT_PROFILE_FFT );
+			continue;
+		}
+
+		/* convolution: the filter while the block is still local */
+		if( VLFFTparams->pFilterSpec != NULL )
+			vlfftSpectrumMultiply( pOutBlk, VLFFTparams->pFilterSpec + (size_t)blkFloats*blkIdx, (size_t)fftSize*numFFTs );
+		PROFILE_MARK( VLFFT_PROFILE_FFT );
+	}
+
+	PROFILE_BEGIN( 1, VLFFT_PROFILE_NO_BLOCK );
+	DMA_ISSUE( q+depth-1 );
+	for( slot=0; slot<depth; slot++ )
+		dmaWait( dma, slot );
+	PROFILE_MARK( VLFFT_PROFILE_DMA );
+
+#undef NEEDED
+#undef DMA_IN
+#undef DMA_OUT
+#undef DMA_ISSUE
+}
@@ -0,0 +1,370 @@
+/*
+ * DSPF_sp_radix4_fftSPxSP()
+ * DSPF_sp_mixedRadix_fftSPxSP()
+ * DSPF_sp_radix4_fftTwSPxSP()
+ * DSPF_sp_mixedRadix_fftTwSPxSP()
+ * multTwiddle_vec_batch()
+ * transpose_2Cols_rowsX8_cplxMatrix_sa()
+ * transpose_2Rows_8XCols_cplxMatrix_sa()
+ *
+ *    Natural C versions of the linear assembly kernels in vlfftSrc, used
+ *    when vlfft is built for a Linux host.  The interfaces, the complex
+ *    sample layout (imag at the lower address, real above it) and the
+ *    twiddle tables produced by tw_gen() are the same as on the DSP.
+ *    The ..._fftTwSPxSP() kernels fuse the FFT with the twiddle multiply
+ *    of multTwiddle_vec_1_sa() for the per column FFTs of vlfftFile.c,
+ *    as vlfftBatchFFTStagesTw() does for a block; multTwiddle_vec_batch()
+ *    does that multiply after vlfftBatchFFT() for the twiddle tables,
+ *    mixed radix and pruned blocks.  None of them has a DSP counterpart
+ *    yet.
+ *
+ * Copyright (C) {2011} Texas Instruments Incorporated - http://www.ti.com/
+ *
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *    Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ *    Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the
+ *    distribution.
+ *
+ *    Neither the name of Texas Instruments Incorporated nor the names of
+ *    its contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ *  A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ *  OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *  SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *  LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ *  DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ *  THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ *  (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ *  OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+*/
+
+
+#include <string.h>
+
+#include "vlfftHostStd.h"
+
+/* vlfft.h */
+#include "../vlfftInc/vlfftDebug.h"
+#include "../vlfftInc/vlfftMessgQ.h"
+#include "../vlfftInc/vlfft.h"
+#include "../vlfftInc/vlfftconfig.h"
+
+
+static Uint32 bitReverse( Uint32 i, Uint32 numBits ) {
+	Uint32 r = 0;
+
+	while( numBits-- ) {
+		r = (r<<1) | (i&0x1);
+		i >>= 1;
+	}
+	return r;
+}
+
+
+/* bitrev(k+1) from r = bitrev(k), the carry running down from the top bit */
+static Uint32 bitReverseNext( Uint32 r, Uint32 n ) {
+	Uint32 bit = n>>1;
+
+	while( r & bit ) {
+		r ^= bit;
+		bit >>= 1;
+	}
+	return r | bit;
+}
+
+
+/****************************************************************/
+/*  radix-4 decimation-in-frequency stages, computed in place.  */
+/*  Each butterfly stores its outputs in slot order 0,2,1,3 so  */
+/*  that the result of all stages is in bit-reversed order.     */
+/*  Stops once the remaining sub-FFTs are of size 2 or 1, and   */
+/*  returns that size.                                          */
+/****************************************************************/
+static Uint32 radix4Stages( Uint32 n, float *x, const float *w ) {
+	Uint32 stride, quarter, group, i;
+	float  *x0, *x1, *x2, *x3;
+	float  t0Re, t0Im, t1Re, t1Im, t2Re, t2Im, t3Re, t3Im;
+	float  yRe, yIm;
+
+	for( stride=n; stride>=4; stride>>=2 ) {
+		quarter = stride>>2;
+		for( group=0; group<n; group+=stride ) {
+			for( i=0; i<quarter; i++ ) {
+				x0 = &x[2*(group+i)];
+				x1 = x0 + 2*quarter;
+				x2 = x1 + 2*quarter;
+				x3 = x2 + 2*quarter;
+
+				t0Re = x0[1] + x2[1];   t0Im = x0[0] + x2[0];
+				t1Re = x0[1] - x2[1];   t1Im = x0[0] - x2[0];
+				t2Re = x1[1] + x3[1];   t2Im = x1[0] + x3[0];
+				t3Re = x1[1] - x3[1];   t3Im = x1[0] - x3[0];
+
+				// y0 = t0 + t2
+				x0[1] = t0Re + t2Re;
+				x0[0] = t0Im + t2Im;
+
+				// y2 = (t0 - t2) * W^2i   -> slot 1
+				yRe = t0Re - t2Re;
+				yIm = t0Im - t2Im;
+				x1[1] = yRe*w[6*i+3] - yIm*w[6*i+2];
+				x1[0] = yRe*w[6*i+2] + yIm*w[6*i+3];
+
+				// y1 = (t1 - j*t3) * W^i  -> slot 2
+				yRe = t1Re + t3Im;
+				yIm = t1Im - t3Re;
+				x2[1] = yRe*w[6*i+1] - yIm*w[6*i  ];
+				x2[0] = yRe*w[6*i  ] + yIm*w[6*i+1];
+
+				// y3 = (t1 + j*t3) * W^3i -> slot 3
+				yRe = t1Re - t3Im;
+				yIm = t1Im + t3Re;
+				x3[1] = yRe*w[6*i+5] - yIm*w[6*i+4];
+				x3[0] = yRe*w[6*i+4] + yIm*w[6*i+5];
+			}
+		}
+		w += 6*quarter;
+	}
+	return stride;
+}
+
+
+static void radix2Stage( Uint32 n, float *x ) {
+	Uint32 i;
+	float  aRe, aIm, bRe, bIm;
+
+	for( i=0; i<n; i+=2 ) {
+		aRe = x[2*i+1];   aIm = x[2*i  ];
+		bRe = x[2*i+3];   bIm = x[2*i+2];
+		x[2*i+1] = aRe + bRe;
+		x[2*i  ] = aIm + bIm;
+		x[2*i+3] = aRe - bRe;
+		x[2*i+2] = aIm - bIm;
+	}
+}
+
+
+static void bitReverseCopy( Uint32 n, float *pIn, float *pOut ) {
+	Uint32 i, numBits;
+
+	for( numBits=0; (1U<<numBits)<n; numBits++ );
+
+	for( i=0; i<n; i++ ) {
+		Uint32 j = bitReverse( i, numBits );
+		pOut[2*j  ] = pIn[2*i  ];
+		pOut[2*j+1] = pIn[2*i+1];
+	}
+}
+
+
+/*********************************************************/
+/*  n = 4^k.  pIn is used as scratch and is overwritten, */
+/*  as with the assembly kernel.  log4NMinus1 is only    */
+/*  needed by the software pipelined loop on the DSP.    */
+/*********************************************************/
+void DSPF_sp_radix4_fftSPxSP( Uint32 n, float *pIn, float *pTwiddle, float *pOut, Uint32 log4NMinus1 ) {
+	(void)log4NMinus1;
+
+	radix4Stages( n, pIn, pTwiddle );
+	bitReverseCopy( n, pIn, pOut );
+}
+
+
+/*********************************************************/
+/*  n = 2*4^k: radix-4 stages followed by one radix-2    */
+/*  stage.  pIn is used as scratch and is overwritten.   */
+/*********************************************************/
+void DSPF_sp_mixedRadix_fftSPxSP( Uint32 n, float *pIn, float *pTwiddle, float *pOut ) {
+	if( radix4Stages( n, pIn, pTwiddle ) == 2 )
+		radix2Stage( n, pIn );
+	bitReverseCopy( n, pIn, pOut );
+}
+
+
+/*********************************************************/
+/*  Four interleaved recurrences stepped by wStep^4, in  */
+/*  the same order of operations as multiTwiddle_1_sa.sa */
+/*  chain m starts at conj(wStep^(4-m)), so one step     */
+/*  gives wStep^m                                        */
+/*********************************************************/
+static void twiddleChainsInit( float wStepRe, float wStepIm, float *twRe, float *twIm, float *w4Re, float *w4Im ) {
+	int   m;
+	float wRe[4], wIm[4];
+
+	// wStep^1 .. wStep^4
+	wRe[0] = wStepRe;
+	wIm[0] = wStepIm;
+	for( m=1; m<4; m++ ) {
+		wRe[m] = wRe[m-1]*wStepRe - wIm[m-1]*wStepIm;
+		wIm[m] = wRe[m-1]*wStepIm + wIm[m-1]*wStepRe;
+	}
+	*w4Re = wRe[3];
+	*w4Im = wIm[3];
+
+	twRe[0] = wRe[3];   twIm[0] = -wIm[3];
+	twRe[1] = wRe[2];   twIm[1] = -wIm[2];
+	twRe[2] = wRe[1];   twIm[2] = -wIm[1];
+	twRe[3] = wRe[0];   twIm[3] = -wIm[0];
+}
+
+
+/*********************************************************/
+/*  pOut[k] = pIn[j] * W(k), k = 0 .. n-1, with j = k or */
+/*  j = bitrev(k) when numBits != 0, the samples inStride */
+/*  and outStride complex samples apart.  W(k) comes     */
+/*  from the recurrence above when pAnchor is NULL, else */
+/*  from pAnchor[k/anchorStep] stepped by wStep in       */
+/*  between; anchorStep 1 reads every twiddle from the   */
+/*  table                                                */
+/*********************************************************/
+static void twiddleOut( Uint32 n, Uint32 numBits, const float *pIn, size_t inStride, float *pOut, size_t outStride,
+                        float wStepRe, float wStepIm, const float *pAnchor, Uint32 anchorStep ) {
+	Uint32 k, m, r;
+	size_t j, o;
+	float  twRe[4], twIm[4];
+	float  w4Re, w4Im, xRe, xIm;
+	float  re = 1.0f, im = 0.0f;
+
+	/* r = j for output k, stepped along with k */
+	r = 0;
+#define NEXT_R( r ) ( numBits ? bitReverseNext( r, n ) : (r)+1 )
+
+	if( pAnchor == NULL ) {
+		twiddleChainsInit( wStepRe, wStepIm, twRe, twIm, &w4Re, &w4Im );
+
+		// mixed radix n need not be a multiple of 4
+		for( k=0; k<n; k+=4 ) {
+			for( m=0; m<4 && k+m<n; m++ ) {
+				re = twRe[m]*w4Re - twIm[m]*w4Im;
+				im = twRe[m]*w4Im + twIm[m]*w4Re;
+				twRe[m] = re;
+				twIm[m] = im;
+
+				j   = (size_t)r*inStride;
+				o   = (size_t)(k+m)*outStride;
+				r   = NEXT_R( r );
+				xRe = pIn[2*j+1];
+				xIm = pIn[2*j  ];
+				pOut[2*o+1] = xRe*re - xIm*im;
+				pOut[2*o  ] = xRe*im + xIm*re;
+			}
+		}
+		return;
+	}
+
+	for( k=0; k<n; k++ ) {
+		if( k % anchorStep == 0 ) {
+			re = pAnchor[2*(k/anchorStep)+1];
+			im = pAnchor[2*(k/anchorStep)  ];
+		} else {
+			xRe = re*wStepRe - im*wStepIm;
+			im  = re*wStepIm + im*wStepRe;
+			re  = xRe;
+		}
+
+		j   = (size_t)r*inStride;
+		o   = (size_t)k*outStride;
+		r   = NEXT_R( r );
+		xRe = pIn[2*j+1];
+		xIm = pIn[2*j  ];
+		pOut[2*o+1] = xRe*re - xIm*im;
+		pOut[2*o  ] = xRe*im + xIm*re;
+	}
+#undef NEXT_R
+}
+
+
+static Uint32 log2Size( Uint32 n ) {
+	Uint32 numBits;
+
+	for( numBits=0; (1U<<numBits)<n; numBits++ );
+	return numBits;
+}
+
+
+/*********************************************************/
+/*  DSPF_sp_radix4_fftSPxSP() followed by the inter-pass */
+/*  twiddle multiply, applied by the output stage as it  */
+/*  gathers the bit-reversed result into natural order,  */
+/*  without the round trip through an intermediate       */
+/*  buffer.  pAnchor/anchorStep as for twiddleOut()      */
+/*********************************************************/
+void DSPF_sp_radix4_fftTwSPxSP( Uint32 n, float *pIn, float *pTwiddle, float *pOut, Uint32 log4NMinus1,
+                                float wStepRe, float wStepIm, const float *pAnchor, Uint32 anchorStep ) {
+	(void)log4NMinus1;
+
+	radix4Stages( n, pIn, pTwiddle );
+	twiddleOut( n, log2Size( n ), pIn, 1, pOut, 1, wStepRe, wStepIm, pAnchor, anchorStep );
+}
+
+
+/*********************************************************/
+/*  DSPF_sp_mixedRadix_fftSPxSP() followed by the        */
+/*  inter-pass twiddle multiply, fused the same way      */
+/*********************************************************/
+void DSPF_sp_mixedRadix_fftTwSPxSP( Uint32 n, float *pIn, float *pTwiddle, float *pOut,
+                                    float wStepRe, float wStepIm, const float *pAnchor, Uint32 anchorStep ) {
+	if( radix4Stages( n, pIn, pTwiddle ) == 2 )
+		radix2Stage( n, pIn );
+	twiddleOut( n, log2Size( n ), pIn, 1, pOut, 1, wStepRe, wStepIm, pAnchor, anchorStep );
+}
+
+
+/*********************************************************/
+/*  FFT fftIdx of a vlfftBatchFFT() result of numFFTs    */
+/*  FFTs times the inter-pass twiddles, gathered into    */
+/*  natural order as the fused kernels above do, its     */
+/*  samples outStride complex samples apart in pOut.     */
+/*  A vlfftBatchMixedFFT() result, bitReversed 0, is in  */
+/*  natural order already                                */
+/*********************************************************/
+void multTwiddle_vec_batch( const float *pBatch, Uint32 numFFTs, Uint32 fftIdx, Bool bitReversed, float wStepRe, float wStepIm,
+                            int fftSize, float *pOutTwiddle, Uint32 outStride, const float *pAnchor, Uint32 anchorStep ) {
+	twiddleOut( fftSize, bitReversed ? log2Size( fftSize ) : 0, pBatch + 2*fftIdx, numFFTs, pOutTwiddle, outStride,
+	            wStepRe, wStepIm, pAnchor, anchorStep );
+}
+
+
+/*********************************************************/
+/*  two columns of a (rows x 8) complex matrix into two  */
+/*  consecutive rows of length rows                      */
+/*********************************************************/
+void transpose_2Cols_rowsX8_cplxMatrix_sa( float *pIn, float *pOut, Uint32 rows ) {
+	Uint32 r;
+
+	for( r=0; r<rows; r++ ) {
+		pOut[2*r           ] = pIn[16*r  ];
+		pOut[2*r+1         ] = pIn[16*r+1];
+		pOut[2*r  + 2*rows ] = pIn[16*r+2];
+		pOut[2*r+1+ 2*rows ] = pIn[16*r+3];
+	}
+}
+
+
+/*********************************************************/
+/*  two consecutive rows of length cols into two columns */
+/*  of a (cols x 8) complex matrix                       */
+/*********************************************************/
+void transpose_2Rows_8XCols_cplxMatrix_sa( float *pIn, float *pOut, Uint32 cols ) {
+	Uint32 c;
+
+	for( c=0; c<cols; c++ ) {
+		pOut[16*c  ] = pIn[2*c           ];
+		pOut[16*c+1] = pIn[2*c+1         ];
+		pOut[16*c+2] = pIn[2*c  + 2*cols ];
+		pOut[16*c+3] = pIn[2*c+1+ 2*cols ];
+	}
+}
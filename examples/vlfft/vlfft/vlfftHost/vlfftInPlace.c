@@ -0,0 +1,183 @@
+/*
+ * vlfftInPlaceInit()
+ * vlfftInPlaceNatural()
+ *
+ *    Natural order for in-place plans.  In place the FFT leaves
+ *    X[k1+N1*k2] at k1*N2+k2, an N1 x N2 matrix whose transpose is the
+ *    natural order.  With n = min(N1,N2) the matrix is m = N/(n*n)
+ *    n x n blocks: stacked when N1 > N2, side by side when N1 < N2.
+ *    Each block is transposed in place, the cores taking pairs of row
+ *    bands of equal area, and the rows of n samples are moved between
+ *    the blocks by following the cycles of that permutation, found once
+ *    per plan: after the blocks are transposed when they are stacked,
+ *    before when they are side by side.  vlfftInPlaceNatural() runs
+ *    after the 2nd iteration
+ *
+ * Copyright (C) {2011} Texas Instruments Incorporated - http://www.ti.com/
+ *
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *    Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ *    Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the
+ *    distribution.
+ *
+ *    Neither the name of Texas Instruments Incorporated nor the names of
+ *    its contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ *  A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ *  OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *  SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *  LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ *  DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ *  THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ *  (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ *  OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+*/
+
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "vlfftHostStd.h"
+
+/* vlfft.h */
+#include "../vlfftInc/vlfftDebug.h"
+#include "../vlfftInc/vlfftMessgQ.h"
+#include "../vlfftInc/vlfft.h"
+#include "../vlfftInc/vlfftconfig.h"
+#include "vlfftHost.h"
+
+
+/****************************************/
+/*  row j of the result comes from row  */
+/*  (j%a)*b + j/a: a = m, b = n for     */
+/*  stacked blocks, the inverse for     */
+/*  side by side ones                   */
+/****************************************/
+static inline Uint32 rowSource( Uint32 j, Uint32 a, Uint32 b ) {
+	return (j%a)*b + j/a;
+}
+
+
+static void blockShape( const VLFFTconfig_t *VLFFTconfig, Uint32 *pN, Uint32 *pM, Uint32 *pA, Uint32 *pB ) {
+	Uint32 n, m;
+
+	n = VLFFTconfig->N1 < VLFFTconfig->N2 ? VLFFTconfig->N1 : VLFFTconfig->N2;
+	m = VLFFTconfig->N/n/n;
+	*pN = n;
+	*pM = m;
+	*pA = VLFFTconfig->N1 > VLFFTconfig->N2 ? m : n;
+	*pB = VLFFTconfig->N1 > VLFFTconfig->N2 ? n : m;
+}
+
+
+/****************************************/
+/*  one row of each cycle of the row    */
+/*  permutation into plan->pCycles;     */
+/*  returns 0, -1 if out of memory      */
+/****************************************/
+Int32 vlfftInPlaceInit( vlfft_plan_t *plan ) {
+	Uint32 n, m, a, b, numRows, i, j, len;
+	char   *visited;
+
+	blockShape( &plan->VLFFTconfig, &n, &m, &a, &b );
+	plan->numCycles = 0;
+	if( m == 1 )
+		return 0;
+
+	numRows = m*n;
+	visited = (char *)calloc( numRows, 1 );
+	plan->pCycles = (Uint32 *)malloc( numRows/2*sizeof(Uint32) );
+	if( visited == NULL || plan->pCycles == NULL ) {
+		free( visited );
+		return -1;
+	}
+
+	for( i=0; i<numRows; i++ ) {
+		if( visited[i] )
+			continue;
+		len = 0;
+		j   = i;
+		do {
+			visited[j] = 1;
+			j = rowSource( j, a, b );
+			len++;
+		} while( j != i );
+		if( len > 1 )
+			plan->pCycles[plan->numCycles++] = i;
+	}
+
+	free( visited );
+	return 0;
+}
+
+
+/* rows of n samples along the cycle through row i, pTmp holds one */
+static void cycleMove( float *p, Uint32 n, Uint32 a, Uint32 b, Uint32 i, float *pTmp ) {
+	size_t rowBytes = (size_t)n*BYTES_PER_COMPLEX_SAMPLE;
+	Uint32 j, src;
+
+	memcpy( pTmp, p + (size_t)2*n*i, rowBytes );
+	for( j=i; (src = rowSource( j, a, b )) != i; j=src )
+		memcpy( p + (size_t)2*n*j, p + (size_t)2*n*src, rowBytes );
+	memcpy( p + (size_t)2*n*j, pTmp, rowBytes );
+}
+
+
+/* core's two bands of every n x n block, 2*numCores bands per block */
+static void blockBands( float *p, Uint32 n, Uint32 m, Uint32 coreNum, Uint32 numCores ) {
+	Uint32 q, numBands, band;
+	float  *pBlk;
+
+	numBands = 2*numCores;
+	for( q=0; q<m; q++ ) {
+		pBlk = p + (size_t)2*n*n*q;
+		band = coreNum;
+		vlfftTransposeSquareBand( pBlk, n, n, (Uint32)((unsigned long long)n*band/numBands),
+		                          (Uint32)((unsigned long long)n*(band+1)/numBands) );
+		band = numBands-1-coreNum;
+		vlfftTransposeSquareBand( pBlk, n, n, (Uint32)((unsigned long long)n*band/numBands),
+		                          (Uint32)((unsigned long long)n*(band+1)/numBands) );
+	}
+}
+
+
+/****************************************/
+/*  engine postPhase of natural order   */
+/*  in-place plans, arg is the plan     */
+/****************************************/
+void vlfftInPlaceNatural( void *arg, Uint32 coreNum, Uint32 numCores ) {
+	vlfft_plan_t *plan = (vlfft_plan_t *)arg;
+	float  *p    = plan->engine.pOut;
+	float  *pTmp = plan->engine.core[coreNum].pWorkBuf0;
+	Uint32 n, m, a, b, i;
+
+	blockShape( &plan->VLFFTconfig, &n, &m, &a, &b );
+
+	if( plan->VLFFTconfig.N1 >= plan->VLFFTconfig.N2 )
+		blockBands( p, n, m, coreNum, numCores );
+	if( m == 1 )
+		return;
+	if( plan->VLFFTconfig.N1 > plan->VLFFTconfig.N2 )
+		vlfftHostEngineSync( &plan->engine, coreNum );
+
+	for( i=coreNum; i<plan->numCycles; i+=numCores )
+		cycleMove( p, n, a, b, plan->pCycles[i], pTmp );
+
+	if( plan->VLFFTconfig.N1 < plan->VLFFTconfig.N2 ) {
+		vlfftHostEngineSync( &plan->engine, coreNum );
+		blockBands( p, n, m, coreNum, numCores );
+	}
+}
@@ -0,0 +1,710 @@
+/*
+ * vlfft_plan_create()
+ * vlfft_plan_create_inverse()
+ * vlfft_plan_create_twiddle()
+ * vlfft_plan_create_depth()
+ * vlfft_plan_create_inplace()
+ * vlfft_plan_create_intermediate()
+ * vlfft_plan_create_dynamic()
+ * vlfft_plan_create_r2c()
+ * vlfft_plan_create_c2r()
+ * vlfft_execute()
+ * vlfft_execute_stream()
+ * vlfft_plan_cleanup()
+ *
+ *    Run time plans: the N1*N2 split, radix and blocking are picked from
+ *    N and the core count, and the plan owns the twiddle tables, the per
+ *    core buffers, the intermediate buffer and the worker threads.
+ *    Plans are cached, asking for the same (N, numCores, direction)
+ *    again returns the plan already built.  The inter-pass twiddles are
+ *    part of the key, so plans differing only in twiddle mode coexist,
+ *    and so are the depth of the per core DMA buffer rings and
+ *    whether they run on the emulated EDMA, whether the plan works in
+ *    place, the intermediate format and the schedule
+ *
+ *
+ * Copyright (C) {2011} Texas Instruments Incorporated - http://www.ti.com/
+ *
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *    Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ *    Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the
+ *    distribution.
+ *
+ *    Neither the name of Texas Instruments Incorporated nor the names of
+ *    its contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ *  A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ *  OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *  SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *  LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ *  DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ *  THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ *  (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ *  OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+*/
+
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <pthread.h>
+
+#include "vlfftHostStd.h"
+
+/* vlfft.h */
+#include "../vlfftInc/vlfftDebug.h"
+#include "../vlfftInc/vlfftMessgQ.h"
+#include "../vlfftInc/vlfft.h"
+#include "../vlfftInc/vlfftconfig.h"
+#include "vlfftHost.h"
+
+
+static vlfft_plan_t    *planCache = NULL;
+static pthread_mutex_t planLock   = PTHREAD_MUTEX_INITIALIZER;
+
+
+static void planFree( vlfft_plan_t *plan ) {
+	vlfftHostFree( plan->pWork );
+	vlfftHostFree( plan->pWorkNext );
+	vlfftHostFree( plan->pHalf );
+	vlfftHostFree( plan->pSplit );
+	vlfftHostFree( plan->pChirp );
+	vlfftHostFree( plan->pChirpSpec );
+	vlfftHostFree( plan->pConv );
+	vlfftHostFree( plan->pConvSpec );
+	vlfftHostFree( plan->pFilterSpec );
+	vlfftHostFree( plan->pHistory );
+	free( plan->pCycles );
+	free( plan->ppPlane );
+	free( plan );
+}
+
+
+/* a plan that failed after planCreate() cached it */
+static void planDestroy( vlfft_plan_t *plan ) {
+	vlfft_plan_t **pp;
+
+	pthread_mutex_lock( &planLock );
+	for( pp=&planCache; *pp!=NULL; pp=&(*pp)->next ) {
+		if( *pp == plan ) {
+			*pp = plan->next;
+			break;
+		}
+	}
+	pthread_mutex_unlock( &planLock );
+
+	vlfftHostEngineDelete( &plan->engine );
+	planFree( plan );
+}
+
+
+/* bytes of an out of place intermediate */
+static size_t planWorkBytes( const VLFFTconfig_t *VLFFTconfig ) {
+	if( VLFFTconfig->intermediate != VLFFT_INTERMEDIATE_FLOAT )
+		return (size_t)VLFFTconfig->N*BYTES_PER_PACKED_COMPLEX_SAMPLE;
+	return (size_t)VLFFTconfig->N*BYTES_PER_COMPLEX_SAMPLE;
+}
+
+
+/****************************************/
+/*  the vlfftconfig.h defaults for the  */
+/*  plan options, in the given          */
+/*  direction                           */
+/****************************************/
+static void planOptions( VLFFTconfig_t *options, Uint32 direction, Uint32 scaleInverse ) {
+	vlfftConfigDefault( options );
+	options->direction    = direction;
+	options->scaleInverse = scaleInverse;
+}
+
+
+/****************************************/
+/*  N is the size of the complex FFT    */
+/*  the engine runs, N/2 of the real    */
+/*  size for R2C and C2R plans.  The    */
+/*  split and blocking are selected,    */
+/*  the rest comes from options.  Out   */
+/*  of place complex FFTs of a size the */
+/*  passes cannot split go through      */
+/*  Bluestein, with the options passed  */
+/*  on to its M-point plans.  2D plans  */
+/*  take their N1 x N2 from options, 3D */
+/*  ones N1 x N2 x N/(N1*N2), built of  */
+/*  a columns and a 2D plan.  Each      */
+/*  convolution plan has its own filter */
+/*  and is never shared                 */
+/****************************************/
+static vlfft_plan_t *planCreate( Uint32 N, Uint32 numCores, Uint32 type, const VLFFTconfig_t *options ) {
+	vlfft_plan_t  *plan, *convFwd, *convInv, *columns, *planes;
+	VLFFTconfig_t VLFFTconfig, convOptions, planeOptions;
+	Uint32        convN;
+
+	convFwd = NULL;
+	convInv = NULL;
+	columns = NULL;
+	planes  = NULL;
+	if( options->transform == VLFFT_TRANSFORM_3D ) {
+		// the 2D plan of the N2 x N3 planes and the N1-point FFTs
+		// down their N2*N3 columns
+		planeOptions           = *options;
+		planeOptions.transform = VLFFT_TRANSFORM_2D;
+		planeOptions.N1        = options->N2;
+		planeOptions.N2        = N/options->N1/options->N2;
+		planes  = planCreate( N/options->N1, numCores, VLFFT_PLAN_C2C, &planeOptions );
+		planeOptions.transform = VLFFT_TRANSFORM_COLUMNS;
+		planeOptions.N1        = options->N1;
+		planeOptions.N2        = N/options->N1;
+		columns = planCreate( N, numCores, VLFFT_PLAN_C2C, &planeOptions );
+		if( planes == NULL || columns == NULL )
+			return NULL;
+
+		VLFFTconfig   = *options;
+		VLFFTconfig.N = N;
+		VLFFTconfig.numCoresForFftCompute = numCores;
+	} else if( options->transform != VLFFT_TRANSFORM_1D ) {
+		if( vlfftConfigSelect2D( &VLFFTconfig, options->N1, options->N2, numCores, options->transform ) != 0 )
+			return NULL;
+	} else if( vlfftConfigSelect( &VLFFTconfig, N, numCores ) != 0 ) {
+		if( type != VLFFT_PLAN_C2C || options->inPlace != VLFFT_OUT_OF_PLACE || N < 2 ||
+		    options->inputEnd != 0 || options->outputEnd != 0 )
+			return NULL;
+		convN = vlfftBluesteinSize( N, numCores );
+		if( convN == 0 )
+			return NULL;
+
+		convOptions              = *options;
+		convOptions.direction    = VLFFT_FORWARD;
+		convOptions.scaleInverse = 0;
+		convFwd = planCreate( convN, numCores, VLFFT_PLAN_C2C, &convOptions );
+		convOptions.direction    = VLFFT_INVERSE;
+		convInv = planCreate( convN, numCores, VLFFT_PLAN_C2C, &convOptions );
+		if( convFwd == NULL || convInv == NULL )
+			return NULL;
+
+		VLFFTconfig    = *options;
+		VLFFTconfig.N  = N;
+		VLFFTconfig.N1 = 0;
+		VLFFTconfig.N2 = 0;
+		VLFFTconfig.numCoresForFftCompute = numCores;
+	}
+
+	// natural order in place transposes min(N1,N2) square blocks
+	if( options->inPlace == VLFFT_IN_PLACE_NATURAL &&
+	    (VLFFTconfig.N1 > VLFFTconfig.N2 ? VLFFTconfig.N1%VLFFTconfig.N2 : VLFFTconfig.N2%VLFFTconfig.N1) != 0 )
+		return NULL;
+
+	VLFFTconfig.direction         = options->direction;
+	VLFFTconfig.scaleInverse      = options->scaleInverse;
+	VLFFTconfig.twiddleMode       = options->twiddleMode;
+	VLFFTconfig.twiddleAnchorStep = options->twiddleAnchorStep;
+	VLFFTconfig.bufferDepth       = options->bufferDepth;
+	VLFFTconfig.emulateEdma       = options->emulateEdma;
+	VLFFTconfig.inPlace           = options->inPlace;
+	VLFFTconfig.intermediate      = options->intermediate;
+	VLFFTconfig.inputBegin        = options->inputBegin;
+	VLFFTconfig.inputEnd          = options->inputEnd;
+	VLFFTconfig.outputBegin       = options->outputBegin;
+	VLFFTconfig.outputEnd         = options->outputEnd;
+	if( options->schedule == VLFFT_SCHEDULE_DYNAMIC )
+		VLFFTconfig.schedule      = VLFFT_SCHEDULE_DYNAMIC;
+
+	pthread_mutex_lock( &planLock );
+
+	for( plan=planCache; plan!=NULL; plan=plan->next ) {
+		if( type != VLFFT_PLAN_CONV &&
+		    plan->VLFFTconfig.N == N && plan->VLFFTconfig.numCoresForFftCompute == numCores && plan->type == type &&
+		    plan->VLFFTconfig.direction == VLFFTconfig.direction && plan->VLFFTconfig.scaleInverse == VLFFTconfig.scaleInverse &&
+		    plan->VLFFTconfig.twiddleMode == VLFFTconfig.twiddleMode &&
+		    plan->VLFFTconfig.twiddleAnchorStep == VLFFTconfig.twiddleAnchorStep &&
+		    plan->VLFFTconfig.bufferDepth == VLFFTconfig.bufferDepth && plan->VLFFTconfig.emulateEdma == VLFFTconfig.emulateEdma &&
+		    plan->VLFFTconfig.inPlace == VLFFTconfig.inPlace &&
+		    plan->VLFFTconfig.intermediate == VLFFTconfig.intermediate && plan->VLFFTconfig.schedule == VLFFTconfig.schedule &&
+		    plan->VLFFTconfig.transform == VLFFTconfig.transform &&
+		    plan->VLFFTconfig.inputBegin == VLFFTconfig.inputBegin && plan->VLFFTconfig.inputEnd == VLFFTconfig.inputEnd &&
+		    plan->VLFFTconfig.outputBegin == VLFFTconfig.outputBegin && plan->VLFFTconfig.outputEnd == VLFFTconfig.outputEnd &&
+		    (VLFFTconfig.transform == VLFFT_TRANSFORM_1D ||
+		     (plan->VLFFTconfig.N1 == VLFFTconfig.N1 && plan->VLFFTconfig.N2 == VLFFTconfig.N2)) ) {
+			pthread_mutex_unlock( &planLock );
+			return plan;
+		}
+	}
+
+	plan = (vlfft_plan_t *)calloc( 1, sizeof(vlfft_plan_t) );
+	if( plan == NULL )
+		goto fail;
+
+	plan->VLFFTconfig = VLFFTconfig;
+	plan->type        = type;
+	if( convFwd != NULL ) {
+		if( vlfftBluesteinInit( plan, convFwd, convInv ) != 0 )
+			goto fail;
+		goto cache;
+	}
+	if( planes != NULL ) {
+		plan->columns = columns;
+		plan->planes  = planes;
+		plan->ppPlane = (float **)malloc( 2*(size_t)VLFFTconfig.N1*sizeof(float *) );
+		if( plan->ppPlane == NULL )
+			goto fail;
+		goto cache;
+	}
+
+	if( VLFFTconfig.inPlace == VLFFT_OUT_OF_PLACE ) {
+		plan->pWork = (float *)vlfftHostAlloc( planWorkBytes( &VLFFTconfig ) );
+		if( plan->pWork == NULL )
+			goto fail;
+	}
+	if( VLFFTconfig.inPlace == VLFFT_IN_PLACE_NATURAL && vlfftInPlaceInit( plan ) != 0 )
+		goto fail;
+
+	if( type == VLFFT_PLAN_R2C || type == VLFFT_PLAN_C2R ) {
+		plan->pHalf  = (float *)vlfftHostAlloc( (size_t)N*BYTES_PER_COMPLEX_SAMPLE );
+		plan->pSplit = (float *)vlfftHostAlloc( ((size_t)N/2+1)*BYTES_PER_COMPLEX_SAMPLE );
+		if( plan->pHalf == NULL || plan->pSplit == NULL )
+			goto fail;
+		vlfftRealSplitInit( plan->pSplit, 2*N );
+
+		// unscaled C2R returns N*x like the complex inverse
+		plan->splitScale = (type == VLFFT_PLAN_C2R && VLFFTconfig.scaleInverse) ? 0.5f : 1.0f;
+	}
+
+	if( vlfftHostEngineCreate( &plan->engine, &plan->VLFFTconfig ) != 0 )
+		goto fail;
+
+	if( type == VLFFT_PLAN_R2C )
+		plan->engine.postPhase = vlfftRealSplit;
+	if( type == VLFFT_PLAN_C2R )
+		plan->engine.prePhase  = vlfftRealMerge;
+	if( VLFFTconfig.inPlace == VLFFT_IN_PLACE_NATURAL )
+		plan->engine.postPhase = vlfftInPlaceNatural;
+	plan->engine.phaseArg = plan;
+
+cache:
+	plan->next = planCache;
+	planCache  = plan;
+
+	pthread_mutex_unlock( &planLock );
+	return plan;
+
+fail:
+	if( plan != NULL )
+		planFree( plan );
+	pthread_mutex_unlock( &planLock );
+	return NULL;
+}
+
+
+/****************************************/
+/*  look up or build the plan for an    */
+/*  N-point FFT on numCores cores,      */
+/*  NULL if the size is not supported   */
+/****************************************/
+vlfft_plan_t *vlfft_plan_create( Uint32 N, Uint32 numCores ) {
+	VLFFTconfig_t options;
+
+	planOptions( &options, VLFFT_FORWARD, 0 );
+	return planCreate( N, numCores, VLFFT_PLAN_C2C, &options );
+}
+
+
+/****************************************/
+/*  same for the inverse FFT, scaled by */
+/*  1/N in the 2nd iteration if scale   */
+/****************************************/
+vlfft_plan_t *vlfft_plan_create_inverse( Uint32 N, Uint32 numCores, Bool scale ) {
+	VLFFTconfig_t options;
+
+	planOptions( &options, VLFFT_INVERSE, scale ? 1 : 0 );
+	return planCreate( N, numCores, VLFFT_PLAN_C2C, &options );
+}
+
+
+/****************************************/
+/*  forward FFT with the inter-pass     */
+/*  twiddles from a per core table      */
+/*  (VLFFT_TWIDDLE_TABLE) or from table */
+/*  anchors every anchorStep outputs    */
+/*  (VLFFT_TWIDDLE_HYBRID, 0 for the    */
+/*  default step)                       */
+/****************************************/
+vlfft_plan_t *vlfft_plan_create_twiddle( Uint32 N, Uint32 numCores, Uint32 twiddleMode, Uint32 anchorStep ) {
+	VLFFTconfig_t options;
+
+	if( twiddleMode > VLFFT_TWIDDLE_HYBRID )
+		return NULL;
+
+	planOptions( &options, VLFFT_FORWARD, 0 );
+	options.twiddleMode = twiddleMode;
+	if( anchorStep != 0 )
+		options.twiddleAnchorStep = anchorStep;
+	return planCreate( N, numCores, VLFFT_PLAN_C2C, &options );
+}
+
+
+/****************************************/
+/*  forward FFT moving its blocks       */
+/*  through rings of bufferDepth in and */
+/*  out buffers per core, 2 to          */
+/*  VLFFT_MAX_BUFFER_DEPTH; deeper      */
+/*  rings keep more transfers in flight */
+/*  behind the compute.  The blocks go  */
+/*  through the emulated EDMA, with the */
+/*  plain copies a transfer is over     */
+/*  when it is issued and the depth     */
+/*  would change nothing                */
+/****************************************/
+vlfft_plan_t *vlfft_plan_create_depth( Uint32 N, Uint32 numCores, Uint32 bufferDepth ) {
+	VLFFTconfig_t options;
+
+	if( bufferDepth < 2 || bufferDepth > VLFFT_MAX_BUFFER_DEPTH )
+		return NULL;
+
+	planOptions( &options, VLFFT_FORWARD, 0 );
+	options.bufferDepth = bufferDepth;
+	options.emulateEdma = 1;
+	return planCreate( N, numCores, VLFFT_PLAN_C2C, &options );
+}
+
+
+/****************************************/
+/*  forward FFT whose intermediate is   */
+/*  VLFFT_INTERMEDIATE_FP16 or _BF16,   */
+/*  halving the DDR traffic between the */
+/*  passes for ~65 and ~50 dB of SNR,   */
+/*  or VLFFT_INTERMEDIATE_FLOAT         */
+/****************************************/
+vlfft_plan_t *vlfft_plan_create_intermediate( Uint32 N, Uint32 numCores, Uint32 intermediate ) {
+	VLFFTconfig_t options;
+
+	if( intermediate > VLFFT_INTERMEDIATE_BF16 )
+		return NULL;
+
+	planOptions( &options, VLFFT_FORWARD, 0 );
+	options.intermediate = intermediate;
+	return planCreate( N, numCores, VLFFT_PLAN_C2C, &options );
+}
+
+
+/****************************************/
+/*  forward FFT whose blocks go to the  */
+/*  cores from a shared counter; core   */
+/*  counts other than powers of two get */
+/*  this from every plan                */
+/****************************************/
+vlfft_plan_t *vlfft_plan_create_dynamic( Uint32 N, Uint32 numCores ) {
+	VLFFTconfig_t options;
+
+	planOptions( &options, VLFFT_FORWARD, 0 );
+	options.schedule = VLFFT_SCHEDULE_DYNAMIC;
+	return planCreate( N, numCores, VLFFT_PLAN_C2C, &options );
+}
+
+
+/****************************************/
+/*  forward FFT over its input, without */
+/*  the N-point intermediate.  The      */
+/*  result is left transposed,          */
+/*  X[k1+N1*k2] at k1*N2+k2, unless     */
+/*  naturalOrder asks for one more      */
+/*  in-place transpose by the workers.  */
+/*  NULL when the passes cannot split N */
+/*  on numCores: N below                */
+/*  1<<VLFFT_MIN_LOG2_SIZE and the      */
+/*  sizes that go through Bluestein out */
+/*  of place have no in-place plan.     */
+/*  NULL too with naturalOrder when     */
+/*  neither of N1 and N2 is a multiple  */
+/*  of the other                        */
+/****************************************/
+vlfft_plan_t *vlfft_plan_create_inplace( Uint32 N, Uint32 numCores, Bool naturalOrder ) {
+	VLFFTconfig_t options;
+
+	planOptions( &options, VLFFT_FORWARD, 0 );
+	options.inPlace = naturalOrder ? VLFFT_IN_PLACE_NATURAL : VLFFT_IN_PLACE;
+	return planCreate( N, numCores, VLFFT_PLAN_C2C, &options );
+}
+
+
+/****************************************/
+/*  N real samples -> bins 0 .. N/2,    */
+/*  through an N/2-point complex FFT    */
+/****************************************/
+vlfft_plan_t *vlfft_plan_create_r2c( Uint32 N, Uint32 numCores ) {
+	VLFFTconfig_t options;
+
+	if( N & 0x1 )
+		return NULL;
+
+	planOptions( &options, VLFFT_FORWARD, 0 );
+	return planCreate( N/2, numCores, VLFFT_PLAN_R2C, &options );
+}
+
+
+/****************************************/
+/*  bins 0 .. N/2 -> N real samples,    */
+/*  scaled by 1/N if scale              */
+/****************************************/
+vlfft_plan_t *vlfft_plan_create_c2r( Uint32 N, Uint32 numCores, Bool scale ) {
+	VLFFTconfig_t options;
+
+	if( N & 0x1 )
+		return NULL;
+
+	planOptions( &options, VLFFT_INVERSE, scale ? 1 : 0 );
+	return planCreate( N/2, numCores, VLFFT_PLAN_C2R, &options );
+}
+
+
+/****************************************/
+/*  N1 x N2 2D FFT over rows of N2      */
+/*  samples, X[k1*N2+k2] at k1*N2+k2;   */
+/*  direction VLFFT_FORWARD or          */
+/*  VLFFT_INVERSE, scaled by 1/(N1*N2)  */
+/*  if scale.  N1 and N2 are at least 8 */
+/*  and powers of two, or multiples of  */
+/*  4 with no prime factor above 7      */
+/****************************************/
+vlfft_plan_t *vlfft_plan_create_2d( Uint32 N1, Uint32 N2, Uint32 numCores, Uint32 direction, Bool scale ) {
+	VLFFTconfig_t options;
+
+	if( (unsigned long long)N1*N2 > (1U<<VLFFT_MAX_LOG2_SIZE) || direction > VLFFT_INVERSE )
+		return NULL;
+
+	planOptions( &options, direction, scale ? 1 : 0 );
+	options.transform = VLFFT_TRANSFORM_2D;
+	options.inPlace   = VLFFT_IN_PLACE;
+	options.N1        = N1;
+	options.N2        = N2;
+	return planCreate( N1*N2, numCores, VLFFT_PLAN_C2C, &options );
+}
+
+
+/****************************************/
+/*  N1 x N2 x N3 3D FFT, n3 fastest:    */
+/*  the N1-point FFTs down the N2*N3    */
+/*  columns, then the N2 x N3 2D FFTs   */
+/*  of the N1 planes in place           */
+/****************************************/
+vlfft_plan_t *vlfft_plan_create_3d( Uint32 N1, Uint32 N2, Uint32 N3, Uint32 numCores, Uint32 direction, Bool scale ) {
+	VLFFTconfig_t options;
+
+	if( N1 == 0 || N2 == 0 || N3 == 0 || (unsigned long long)N1*N2*N3 > (1U<<VLFFT_MAX_LOG2_SIZE) ||
+	    direction > VLFFT_INVERSE )
+		return NULL;
+
+	planOptions( &options, direction, scale ? 1 : 0 );
+	options.transform = VLFFT_TRANSFORM_3D;
+	options.inPlace   = VLFFT_IN_PLACE;
+	options.N1        = N1;
+	options.N2        = N2;
+	return planCreate( N1*N2*N3, numCores, VLFFT_PLAN_C2C, &options );
+}
+
+
+/****************************************/
+/*  forward FFT of an input that is     */
+/*  zero outside samples [inBegin,      */
+/*  inEnd) when only bins [outBegin,    */
+/*  outEnd) are needed: blocks of the   */
+/*  1st iteration with only zeros in,   */
+/*  and of the 2nd with none of those   */
+/*  bins out, are skipped.  The other   */
+/*  bins of pOut are left undefined.    */
+/*  NULL for sizes that need Bluestein  */
+/****************************************/
+vlfft_plan_t *vlfft_plan_create_pruned( Uint32 N, Uint32 numCores, Uint32 inBegin, Uint32 inEnd,
+                                        Uint32 outBegin, Uint32 outEnd ) {
+	VLFFTconfig_t options;
+
+	if( inBegin >= inEnd || inEnd > N || outBegin >= outEnd || outEnd > N )
+		return NULL;
+
+	planOptions( &options, VLFFT_FORWARD, 0 );
+	options.inputBegin  = inBegin;
+	options.inputEnd    = inEnd;
+	options.outputBegin = outBegin;
+	options.outputEnd   = outEnd;
+	return planCreate( N, numCores, VLFFT_PLAN_C2C, &options );
+}
+
+
+/****************************************/
+/*  plan for the convolution (or the    */
+/*  correlation if correlate) of N-     */
+/*  point windows with the filterLen    */
+/*  complex samples of pFilter, 1 <=    */
+/*  filterLen <= N, see vlfftConv.c;    */
+/*  NULL if N is not supported or out   */
+/*  of memory                           */
+/****************************************/
+vlfft_plan_t *vlfft_plan_create_conv( Uint32 N, Uint32 numCores, const float *pFilter, Uint32 filterLen, Bool correlate ) {
+	VLFFTconfig_t options;
+	vlfft_plan_t  *plan;
+
+	if( filterLen == 0 || filterLen > N )
+		return NULL;
+
+	planOptions( &options, VLFFT_FORWARD, 0 );
+	plan = planCreate( N, numCores, VLFFT_PLAN_CONV, &options );
+	if( plan == NULL )
+		return NULL;
+	if( vlfftConvInit( plan, pFilter, filterLen, correlate ) != 0 ) {
+		planDestroy( plan );
+		return NULL;
+	}
+
+	return plan;
+}
+
+
+/* numPlanes consecutive planes as a stream, ppFrame holds 2*numPlanes */
+static Int32 planesRun( vlfft_plan_t *plan, float *pIn, float *pOut, Uint32 numPlanes, float **ppFrame ) {
+	size_t planeFloats = 2*(size_t)plan->VLFFTconfig.N;
+	Uint32 p;
+
+	for( p=0; p<numPlanes; p++ ) {
+		ppFrame[p]           = pIn  + p*planeFloats;
+		ppFrame[numPlanes+p] = pOut + p*planeFloats;
+	}
+	return vlfft_execute_stream( plan, ppFrame, ppFrame+numPlanes, numPlanes );
+}
+
+
+/****************************************/
+/*  one FFT; a plan runs one FFT at a   */
+/*  time.  Real samples are plain       */
+/*  floats, spectra are complex samples */
+/*  In-place and 2D plans read pIn and  */
+/*  leave the result in pOut, which may */
+/*  be pIn.  Convolution plans give the */
+/*  circular convolution of the N       */
+/*  samples with the filter             */
+/****************************************/
+void vlfft_execute( vlfft_plan_t *plan, float *pIn, float *pOut ) {
+	if( plan->type == VLFFT_PLAN_CONV ) {
+		vlfftConvExecute( plan, pIn, pOut );
+		return;
+	}
+	if( plan->convFwd != NULL ) {
+		vlfftBluesteinExecute( plan, pIn, pOut );
+		return;
+	}
+	if( plan->planes != NULL ) {
+		vlfft_execute( plan->columns, pIn, pOut );
+		planesRun( plan->planes, pOut, pOut, plan->VLFFTconfig.N1, plan->ppPlane );
+		return;
+	}
+
+	switch( plan->type ) {
+	case VLFFT_PLAN_R2C:
+		plan->pRealOut = pOut;
+		vlfftHostEngineRun( &plan->engine, pIn, plan->pWork, plan->pHalf );
+		break;
+	case VLFFT_PLAN_C2R:
+		plan->pRealIn = pIn;
+		vlfftHostEngineRun( &plan->engine, plan->pHalf, plan->pWork, pOut );
+		break;
+	default:
+		// pass 1 reads the columns from pIn and writes them to pOut
+		if( plan->VLFFTconfig.inPlace != VLFFT_OUT_OF_PLACE ) {
+			vlfftHostEngineRun( &plan->engine, pIn, pOut, pOut );
+			break;
+		}
+		vlfftHostEngineRun( &plan->engine, pIn, plan->pWork, pOut );
+		break;
+	}
+}
+
+
+/****************************************/
+/*  numFrames FFTs ppIn[f] -> ppOut[f], */
+/*  pass 2 of frame f overlapping pass  */
+/*  1 of frame f+1; out of place        */
+/*  complex and 2D plans only.          */
+/*  Bluestein plans run the frames one  */
+/*  by one                              */
+/****************************************/
+Int32 vlfft_execute_stream( vlfft_plan_t *plan, float **ppIn, float **ppOut, Uint32 numFrames ) {
+	float  *pWork[2];
+	Uint32 f;
+
+	if( plan->type != VLFFT_PLAN_C2C ||
+	    (plan->VLFFTconfig.inPlace != VLFFT_OUT_OF_PLACE && plan->VLFFTconfig.transform != VLFFT_TRANSFORM_2D) )
+		return -1;
+
+	if( plan->convFwd != NULL ) {
+		for( f=0; f<numFrames; f++ )
+			vlfftBluesteinExecute( plan, ppIn[f], ppOut[f] );
+		return 0;
+	}
+
+	if( plan->pWorkNext == NULL && plan->VLFFTconfig.transform == VLFFT_TRANSFORM_1D ) {
+		plan->pWorkNext = (float *)vlfftHostAlloc( planWorkBytes( &plan->VLFFTconfig ) );
+		if( plan->pWorkNext == NULL )
+			return -1;
+	}
+
+	pWork[0] = plan->pWork;
+	pWork[1] = plan->pWorkNext;
+	vlfftHostEngineRunStream( &plan->engine, ppIn, ppOut, pWork, numFrames );
+
+	return 0;
+}
+
+
+/****************************************/
+/*  2D FFTs of numPlanes consecutive    */
+/*  N1 x N2 planes of pIn into those of */
+/*  pOut, as a stream; returns 0, -1 if */
+/*  the plan is not 2D or out of memory */
+/****************************************/
+Int32 vlfft_execute_planes( vlfft_plan_t *plan, float *pIn, float *pOut, Uint32 numPlanes ) {
+	float **ppFrame;
+	Int32 status;
+
+	if( plan->VLFFTconfig.transform != VLFFT_TRANSFORM_2D )
+		return -1;
+
+	ppFrame = (float **)malloc( 2*(size_t)numPlanes*sizeof(float *) );
+	if( ppFrame == NULL )
+		return -1;
+	status = planesRun( plan, pIn, pOut, numPlanes, ppFrame );
+	free( ppFrame );
+
+	return status;
+}
+
+
+/****************************************/
+/*  stop the workers and free every     */
+/*  cached plan                         */
+/****************************************/
+void vlfft_plan_cleanup( void ) {
+	vlfft_plan_t *plan;
+
+	pthread_mutex_lock( &planLock );
+
+	while( planCache != NULL ) {
+		plan      = planCache;
+		planCache = plan->next;
+
+		if( plan->convFwd == NULL && plan->planes == NULL )
+			vlfftHostEngineDelete( &plan->engine );
+		planFree( plan );
+	}
+
+	pthread_mutex_unlock( &planLock );
+}
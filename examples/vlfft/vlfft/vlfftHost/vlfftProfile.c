@@ -0,0 +1,322 @@
+/*
+ * vlfft_profile_start()
+ * vlfft_profile_stop()
+ * vlfft_profile_report()
+ * vlfft_profile_export()
+ *
+ *    Per core, per block timing of a plan's workers.  While profiled every
+ *    block a core moves leaves a record of the time it spent waiting for
+ *    and issuing transfers, in the FFTs, the 1st iteration's twiddle
+ *    multiply and packing the intermediate, and every barrier one of the
+ *    time it waited there.  The report gives min, mean and 99th percentile
+ *    per block of each phase of each pass and the totals of each core, the
+ *    export all records as CSV or JSON
+ *
+ * Copyright (C) {2011} Texas Instruments Incorporated - http://www.ti.com/
+ *
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *    Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ *    Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the
+ *    distribution.
+ *
+ *    Neither the name of Texas Instruments Incorporated nor the names of
+ *    its contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ *  A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ *  OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *  SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *  LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ *  DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ *  THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ *  (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ *  OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+*/
+
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "vlfftHostStd.h"
+
+/* vlfft.h */
+#include "../vlfftInc/vlfftDebug.h"
+#include "../vlfftInc/vlfftMessgQ.h"
+#include "../vlfftInc/vlfft.h"
+#include "../vlfftInc/vlfftconfig.h"
+#include "vlfftHost.h"
+
+
+static const char *phaseName[VLFFT_PROFILE_NUM_PHASES] = {
+	"dma", "fft", "twiddle", "pack", "barrier"
+};
+
+static const char *passName[3] = { "1st", "2nd", "sync" };
+
+
+unsigned long long vlfftProfileNowNs( void ) {
+	struct timespec ts;
+
+	clock_gettime( CLOCK_MONOTONIC, &ts );
+	return ts.tv_sec*1000000000ULL + ts.tv_nsec;
+}
+
+
+/****************************************************************/
+/*    opens the record of a block, or drops it once the core's  */
+/*    records are used up                                       */
+/****************************************************************/
+void vlfftProfileBegin( vlfftProfileCore_t *prof, Uint32 pass, Uint32 block ) {
+	vlfftProfileBlock_t *rec;
+
+	if( prof->numBlocks == prof->maxBlocks ) {
+		prof->pCur = NULL;
+		prof->numDropped++;
+		return;
+	}
+
+	rec = &prof->pBlock[prof->numBlocks++];
+	memset( rec, 0, sizeof(*rec) );
+	rec->pass    = pass;
+	rec->block   = block;
+	rec->startNs = vlfftProfileNowNs();
+
+	prof->pCur   = rec;
+	prof->lastNs = rec->startNs;
+}
+
+
+/* time since the last mark goes to phase */
+void vlfftProfileMark( vlfftProfileCore_t *prof, Uint32 phase ) {
+	unsigned long long now;
+
+	if( prof->pCur == NULL )
+		return;
+
+	now = vlfftProfileNowNs();
+	prof->pCur->ns[phase] += (Uint32)(now - prof->lastNs);
+	prof->lastNs = now;
+}
+
+
+/****************************************************************/
+/*    drops earlier records; call between executes.  Returns    */
+/*    0, or -1 if the records cannot be allocated               */
+/****************************************************************/
+Int32 vlfft_profile_start( vlfft_plan_t *plan, Uint32 maxBlocksPerCore ) {
+	vlfftHostEngine_t  *engine = &plan->engine;
+	vlfftProfileCore_t *prof;
+	Uint32 coreNum;
+
+	if( maxBlocksPerCore == 0 )
+		maxBlocksPerCore = VLFFT_PROFILE_BLOCKS;
+
+	for( coreNum=0; coreNum<engine->numCores; coreNum++ ) {
+		prof = &engine->core[coreNum].profile;
+		if( prof->maxBlocks != maxBlocksPerCore ) {
+			vlfftHostFree( prof->pBlock );
+			prof->pBlock    = (vlfftProfileBlock_t *)vlfftHostAlloc( (size_t)maxBlocksPerCore*sizeof(vlfftProfileBlock_t) );
+			prof->maxBlocks = prof->pBlock != NULL ? maxBlocksPerCore : 0;
+			if( prof->pBlock == NULL )
+				return -1;
+		}
+		prof->numBlocks  = 0;
+		prof->numDropped = 0;
+		prof->pCur       = NULL;
+	}
+
+	engine->profileStartNs = vlfftProfileNowNs();
+	engine->profiling      = TRUE;
+	return 0;
+}
+
+
+/* keeps the records for the report and export */
+void vlfft_profile_stop( vlfft_plan_t *plan ) {
+	plan->engine.profiling = FALSE;
+}
+
+
+static int compareDouble( const void *a, const void *b ) {
+	double x = *(const double *)a, y = *(const double *)b;
+
+	return x < y ? -1 : x > y;
+}
+
+
+/****************************************************************/
+/*    min, mean and 99th percentile in us of phase over the     */
+/*    blocks of pass (the barriers for VLFFT_PROFILE_PASS_SYNC) */
+/*    of all cores, ring drains left out; returns the number    */
+/*    of blocks, 0 if the phase took no time in that pass       */
+/****************************************************************/
+static Uint32 phaseStats( vlfftHostEngine_t *engine, Uint32 pass, Uint32 phase, double *pUs,
+                          double *pMin, double *pMean, double *pP99, double *pTotalMs ) {
+	const vlfftProfileCore_t *prof;
+	const vlfftProfileBlock_t *rec;
+	Uint32 coreNum, i, n = 0;
+	double sum = 0.0;
+
+	for( coreNum=0; coreNum<engine->numCores; coreNum++ ) {
+		prof = &engine->core[coreNum].profile;
+		for( i=0; i<prof->numBlocks; i++ ) {
+			rec = &prof->pBlock[i];
+			if( rec->pass != pass || (pass != VLFFT_PROFILE_PASS_SYNC && rec->block == VLFFT_PROFILE_NO_BLOCK) )
+				continue;
+			pUs[n] = rec->ns[phase]/1000.0;
+			sum   += pUs[n++];
+		}
+	}
+	if( n == 0 || sum == 0.0 )
+		return 0;
+
+	qsort( pUs, n, sizeof(double), compareDouble );
+	*pMin     = pUs[0];
+	*pMean    = sum/n;
+	*pP99     = pUs[(Uint32)(0.99*(n-1) + 0.5)];
+	*pTotalMs = sum/1000.0;
+	return n;
+}
+
+
+/****************************************************************/
+/*    summary per pass and phase, then per core; the core with  */
+/*    the most busy time (all but barriers) is the straggler    */
+/****************************************************************/
+void vlfft_profile_report( vlfft_plan_t *plan, FILE *fp ) {
+	vlfftHostEngine_t  *engine = &plan->engine;
+	const vlfftProfileCore_t *prof;
+	double  *pUs, min, mean, p99, totalMs, busyMs, maxBusyMs = 0.0;
+	double  coreMs[VLFFT_PROFILE_NUM_PHASES];
+	Uint32  coreNum, pass, phase, i, n, numRecords = 0, numDropped = 0, slowest = 0;
+
+	for( coreNum=0; coreNum<engine->numCores; coreNum++ ) {
+		numRecords += engine->core[coreNum].profile.numBlocks;
+		numDropped += engine->core[coreNum].profile.numDropped;
+	}
+	fprintf( fp, "  Profile: %u cores, %u records, %u dropped\n", engine->numCores, numRecords, numDropped );
+	if( numRecords == 0 )
+		return;
+
+	pUs = (double *)malloc( numRecords*sizeof(double) );
+	if( pUs == NULL )
+		return;
+
+	fprintf( fp, "  %-5s %-10s %8s %10s %10s %10s %10s\n", "pass", "phase", "blocks", "min us", "mean us", "p99 us", "total ms" );
+	for( pass=0; pass<=VLFFT_PROFILE_PASS_SYNC; pass++ ) {
+		for( phase=0; phase<VLFFT_PROFILE_NUM_PHASES; phase++ ) {
+			n = phaseStats( engine, pass, phase, pUs, &min, &mean, &p99, &totalMs );
+			if( n != 0 )
+				fprintf( fp, "  %-5s %-10s %8u %10.2f %10.2f %10.2f %10.3f\n",
+				         passName[pass], phaseName[phase], n, min, mean, p99, totalMs );
+		}
+	}
+	free( pUs );
+
+	fprintf( fp, "  %-5s %8s", "core", "blocks" );
+	for( phase=0; phase<VLFFT_PROFILE_NUM_PHASES; phase++ )
+		fprintf( fp, " %9s", phaseName[phase] );
+	fprintf( fp, "   (ms)\n" );
+
+	for( coreNum=0; coreNum<engine->numCores; coreNum++ ) {
+		prof = &engine->core[coreNum].profile;
+		memset( coreMs, 0, sizeof(coreMs) );
+		n = 0;
+		for( i=0; i<prof->numBlocks; i++ ) {
+			if( prof->pBlock[i].block != VLFFT_PROFILE_NO_BLOCK )
+				n++;
+			for( phase=0; phase<VLFFT_PROFILE_NUM_PHASES; phase++ )
+				coreMs[phase] += prof->pBlock[i].ns[phase]/1e6;
+		}
+
+		busyMs = 0.0;
+		fprintf( fp, "  %-5u %8u", coreNum, n );
+		for( phase=0; phase<VLFFT_PROFILE_NUM_PHASES; phase++ ) {
+			fprintf( fp, " %9.3f", coreMs[phase] );
+			if( phase != VLFFT_PROFILE_BARRIER )
+				busyMs += coreMs[phase];
+		}
+		fprintf( fp, "\n" );
+
+		if( busyMs > maxBusyMs ) {
+			maxBusyMs = busyMs;
+			slowest   = coreNum;
+		}
+	}
+	fprintf( fp, "  slowest core %u, busy %.3f ms\n", slowest, maxBusyMs );
+}
+
+
+/****************************************************************/
+/*    every record, times in us from vlfft_profile_start(); a   */
+/*    path ending in .json gives JSON, anything else CSV.       */
+/*    block is -1 for ring drains and barriers.  Returns 0, or  */
+/*    -1 if the file cannot be written                          */
+/****************************************************************/
+Int32 vlfft_profile_export( vlfft_plan_t *plan, const char *path ) {
+	vlfftHostEngine_t *engine = &plan->engine;
+	const vlfftProfileBlock_t *rec;
+	const char *ext;
+	FILE    *fp;
+	Uint32  coreNum, phase, i;
+	Bool    json, first = TRUE;
+
+	ext  = strrchr( path, '.' );
+	json = ext != NULL && strcmp( ext, ".json" ) == 0;
+
+	fp = fopen( path, "w" );
+	if( fp == NULL )
+		return -1;
+
+	if( json ) {
+		fprintf( fp, "{\n  \"N\": %u, \"N1\": %u, \"N2\": %u, \"numCores\": %u,\n  \"records\": [",
+		         plan->VLFFTconfig.N, plan->VLFFTconfig.N1, plan->VLFFTconfig.N2, engine->numCores );
+	} else {
+		fprintf( fp, "core,pass,block,start_us" );
+		for( phase=0; phase<VLFFT_PROFILE_NUM_PHASES; phase++ )
+			fprintf( fp, ",%s_us", phaseName[phase] );
+		fprintf( fp, "\n" );
+	}
+
+	for( coreNum=0; coreNum<engine->numCores; coreNum++ ) {
+		for( i=0; i<engine->core[coreNum].profile.numBlocks; i++ ) {
+			rec = &engine->core[coreNum].profile.pBlock[i];
+			if( json ) {
+				fprintf( fp, "%s\n    {\"core\": %u, \"pass\": \"%s\", \"block\": %d, \"start_us\": %.3f",
+				         first ? "" : ",", coreNum, passName[rec->pass],
+				         rec->block == VLFFT_PROFILE_NO_BLOCK ? -1 : (int)rec->block,
+				         (rec->startNs - engine->profileStartNs)/1000.0 );
+				for( phase=0; phase<VLFFT_PROFILE_NUM_PHASES; phase++ )
+					fprintf( fp, ", \"%s_us\": %.3f", phaseName[phase], rec->ns[phase]/1000.0 );
+				fprintf( fp, "}" );
+				first = FALSE;
+			} else {
+				fprintf( fp, "%u,%s,%d,%.3f", coreNum, passName[rec->pass],
+				         rec->block == VLFFT_PROFILE_NO_BLOCK ? -1 : (int)rec->block,
+				         (rec->startNs - engine->profileStartNs)/1000.0 );
+				for( phase=0; phase<VLFFT_PROFILE_NUM_PHASES; phase++ )
+					fprintf( fp, ",%.3f", rec->ns[phase]/1000.0 );
+				fprintf( fp, "\n" );
+			}
+		}
+	}
+
+	if( json )
+		fprintf( fp, "\n  ]\n}\n" );
+
+	return fclose( fp ) == 0 ? 0 : -1;
+}
@@ -0,0 +1,164 @@
+/*
+ * vlfftRealSplitInit()
+ * vlfftRealSplit()
+ * vlfftRealMerge()
+ *
+ *    Real FFT of N points through an N/2-point complex FFT.  The N real
+ *    samples, read as N/2 complex samples (imag at the lower address),
+ *    give z[n] = x[2n+1] + j*x[2n], whose FFT Z holds the transforms of
+ *    the odd and even samples:
+ *
+ *       O[k] = ( Z[k] + conj(Z[N/2-k]) ) / 2
+ *       E[k] = ( Z[k] - conj(Z[N/2-k]) ) / 2j
+ *       X[k] = E[k] + W_N^k*O[k],  X[N/2-k] = conj( E[k] - W_N^k*O[k] )
+ *
+ *    vlfftRealSplit() runs after the 2nd iteration of an R2C plan,
+ *    vlfftRealMerge() undoes it before the 1st iteration of a C2R plan.
+ *    Each core handles k = 0 .. N/4 in contiguous slices.
+ *
+ *
+ * Copyright (C) {2011} Texas Instruments Incorporated - http://www.ti.com/
+ *
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *    Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ *    Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the
+ *    distribution.
+ *
+ *    Neither the name of Texas Instruments Incorporated nor the names of
+ *    its contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ *  A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ *  OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *  SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *  LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ *  DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ *  THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ *  (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ *  OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+*/
+
+
+#include <math.h>
+
+#include "vlfftHostStd.h"
+
+/* vlfft.h */
+#include "../vlfftInc/vlfftDebug.h"
+#include "../vlfftInc/vlfftMessgQ.h"
+#include "../vlfftInc/vlfft.h"
+#include "../vlfftInc/vlfftconfig.h"
+#include "vlfftHost.h"
+
+
+/****************************************/
+/*  W_N^k for k = 0 .. N/4, same layout */
+/*  as the samples                      */
+/****************************************/
+void vlfftRealSplitInit( float *pSplit, Uint32 N ) {
+	Uint32 k;
+	double theta;
+	const double PI = 3.141592654;
+
+	for( k=0; k<=N/4; k++ ) {
+		theta = 2 * PI * k / N;
+		pSplit[2*k  ] = (float)(-sin( theta ));
+		pSplit[2*k+1] = (float)  cos( theta );
+	}
+}
+
+
+static void coreSlice( Uint32 numPairs, Uint32 coreNum, Uint32 numCores, Uint32 *pStart, Uint32 *pEnd ) {
+	Uint32 slice;
+
+	slice   = (numPairs + numCores - 1)/numCores;
+	*pStart = coreNum*slice;
+	*pEnd   = *pStart + slice;
+	if( *pStart > numPairs ) *pStart = numPairs;
+	if( *pEnd   > numPairs ) *pEnd   = numPairs;
+}
+
+
+/****************************************/
+/*  Z (N/2 complex) -> X, N/2+1 bins    */
+/****************************************/
+void vlfftRealSplit( void *arg, Uint32 coreNum, Uint32 numCores ) {
+	vlfft_plan_t *plan = (vlfft_plan_t *)arg;
+	const float  *Z = plan->pHalf;
+	const float  *W = plan->pSplit;
+	float        *X = plan->pRealOut;
+	Uint32       M, k, m, kStart, kEnd;
+	float        aRe, aIm, bRe, bIm, oRe, oIm, eRe, eIm, tRe, tIm;
+
+	M = plan->VLFFTconfig.N;
+	coreSlice( M/2+1, coreNum, numCores, &kStart, &kEnd );
+
+	for( k=kStart; k<kEnd; k++ ) {
+		m = k != 0 ? M-k : 0;
+
+		aRe = Z[2*k+1];   aIm =  Z[2*k];
+		bRe = Z[2*m+1];   bIm = -Z[2*m];
+
+		oRe = 0.5f*(aRe + bRe);   oIm = 0.5f*(aIm + bIm);
+		eRe = 0.5f*(aIm - bIm);   eIm = 0.5f*(bRe - aRe);
+
+		// t = W^k * O
+		tRe = W[2*k+1]*oRe - W[2*k]*oIm;
+		tIm = W[2*k+1]*oIm + W[2*k]*oRe;
+
+		// X[N/2-k] first so that k = N/4 ends up with X[k]
+		X[2*(M-k)+1] =   eRe - tRe;
+		X[2*(M-k)  ] = -(eIm - tIm);
+		X[2*k+1]     = eRe + tRe;
+		X[2*k  ]     = eIm + tIm;
+	}
+}
+
+
+/****************************************/
+/*  X, N/2+1 bins -> Z (N/2 complex)    */
+/****************************************/
+void vlfftRealMerge( void *arg, Uint32 coreNum, Uint32 numCores ) {
+	vlfft_plan_t *plan = (vlfft_plan_t *)arg;
+	const float  *X = plan->pRealIn;
+	const float  *W = plan->pSplit;
+	float        *Z = plan->pHalf;
+	float        s  = plan->splitScale;
+	Uint32       M, k, kStart, kEnd;
+	float        aRe, aIm, bRe, bIm, dRe, dIm, oRe, oIm, eRe, eIm;
+
+	M = plan->VLFFTconfig.N;
+	coreSlice( M/2+1, coreNum, numCores, &kStart, &kEnd );
+
+	for( k=kStart; k<kEnd; k++ ) {
+		aRe = X[2*k+1];       aIm =  X[2*k];
+		bRe = X[2*(M-k)+1];   bIm = -X[2*(M-k)];
+
+		eRe = s*(aRe + bRe);   eIm = s*(aIm + bIm);
+		dRe = s*(aRe - bRe);   dIm = s*(aIm - bIm);
+
+		// O = D * conj(W^k)
+		oRe = W[2*k+1]*dRe + W[2*k]*dIm;
+		oIm = W[2*k+1]*dIm - W[2*k]*dRe;
+
+		// Z[k] = O + j*E, Z[N/2-k] = conj(O) + j*conj(E)
+		if( k != 0 ) {
+			Z[2*(M-k)+1] =  oRe + eIm;
+			Z[2*(M-k)  ] = -oIm + eRe;
+		}
+		Z[2*k+1] = oRe - eIm;
+		Z[2*k  ] = oIm + eRe;
+	}
+}
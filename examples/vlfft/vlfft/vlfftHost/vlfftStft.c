@@ -0,0 +1,354 @@
+/*
+ * vlfft_stft_create()
+ * vlfft_stft_push()
+ * vlfft_stft_row()
+ * vlfft_stft_stats()
+ * vlfft_stft_reset()
+ * vlfft_stft_delete()
+ *
+ *    Short-time FFT of a continuous stream on the host.  The samples are
+ *    queued until a batch of frames is complete; each worker then takes a
+ *    run of consecutive frames of the batch, so the samples they overlap on
+ *    are read from its own cache, and computes them VLFFT_STFT_GROUP at a
+ *    time: the window is applied as a group is gathered into the interleaved
+ *    layout of the batched kernels, and each frame's spectrum goes straight
+ *    to its row of the ring
+ *
+ * Copyright (C) {2011} Texas Instruments Incorporated - http://www.ti.com/
+ *
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *    Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ *    Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the
+ *    distribution.
+ *
+ *    Neither the name of Texas Instruments Incorporated nor the names of
+ *    its contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ *  A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ *  OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *  SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *  LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ *  DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ *  THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ *  (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ *  OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+*/
+
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <pthread.h>
+
+#include "vlfftHostStd.h"
+
+/* vlfft.h */
+#include "../vlfftInc/vlfftDebug.h"
+#include "../vlfftInc/vlfftMessgQ.h"
+#include "../vlfftInc/vlfft.h"
+#include "../vlfftInc/vlfftconfig.h"
+#include "vlfftHost.h"
+
+
+/* kernel for n-point frames: 4, 2 or VLFFT_RADIX_MIXED, 0 if none */
+static Uint32 frameRadix( Uint32 n ) {
+	Uint32 m, p, log2n;
+
+	if( (n & (n-1)) == 0 ) {
+		for( log2n=0; (1U<<log2n)<n; log2n++ )
+			;
+		return (log2n & 1) ? 2 : 4;
+	}
+
+	m = n;
+	for( p=2; p<=VLFFT_BATCH_MAX_RADIX; p++ )
+		while( m%p == 0 )
+			m /= p;
+	return m == 1 ? VLFFT_RADIX_MIXED : 0;
+}
+
+
+/****************************************/
+/*  this core's run of the batch: its   */
+/*  frames windowed into the batch      */
+/*  layout a group at a time, FFTed and */
+/*  copied out to their rows            */
+/****************************************/
+static void stftFrames( vlfft_stft_t *stft, vlfftStftCore_t *core ) {
+	Uint32 W, first, last, f, g, numFFTs, b, i;
+	unsigned long long frame;
+	const float *pFrame;
+	float  *pFft, *pRow, w;
+
+	W     = stft->windowLen;
+	first = (Uint32)(((unsigned long long)stft->numFrames*core->coreNum)/stft->numCores);
+	last  = (Uint32)(((unsigned long long)stft->numFrames*(core->coreNum+1))/stft->numCores);
+
+	for( f=first; f<last; f+=numFFTs ) {
+		numFFTs = last-f < VLFFT_STFT_GROUP ? last-f : VLFFT_STFT_GROUP;
+
+		// sample i of frame g at i*numFFTs+g
+		for( i=0; i<W; i++ ) {
+			w = stft->pWindow[i];
+			for( g=0; g<numFFTs; g++ ) {
+				pFrame = stft->pSamples + 2*((size_t)(f+g)*stft->hop + i);
+				core->pBatch[2*(i*numFFTs+g)  ] = pFrame[0]*w;
+				core->pBatch[2*(i*numFFTs+g)+1] = pFrame[1]*w;
+			}
+		}
+
+		if( stft->radix == VLFFT_RADIX_MIXED ) {
+			vlfftBatchMixedFFT( W, numFFTs, core->pBatch, core->pBatchOut, stft->pW, VLFFT_FORWARD, 1.0f );
+			pFft = core->pBatchOut;
+		} else {
+			vlfftBatchFFT( W, numFFTs, core->pBatch, stft->pW, VLFFT_FORWARD );
+			pFft = core->pBatch;
+		}
+
+		for( b=0; b<numFFTs; b++ ) {
+			frame = stft->firstFrame + f + b;
+			pRow  = stft->pRing + 2*(size_t)W*(frame % stft->numRows);
+			vlfftBatchFFTColumn( W, numFFTs, pFft, b, stft->radix != VLFFT_RADIX_MIXED, pRow );
+		}
+	}
+}
+
+
+static void *stftWorker( void *arg ) {
+	vlfftStftCore_t *core = (vlfftStftCore_t *)arg;
+	vlfft_stft_t    *stft = core->stft;
+
+	vlfftHostPinToCpu( core->coreNum );
+
+	while(1) {
+		vlfftBarrierWait( stft->startBarrier, core->coreNum, &core->startSense );
+		if( stft->exit )
+			break;
+		stftFrames( stft, core );
+		vlfftBarrierWait( stft->doneBarrier, core->coreNum, &core->doneSense );
+	}
+
+	return NULL;
+}
+
+
+static void stftFree( vlfft_stft_t *stft ) {
+	Uint32 coreNum;
+
+	if( stft->core != NULL ) {
+		for( coreNum=0; coreNum<stft->numCores; coreNum++ ) {
+			vlfftHostFree( stft->core[coreNum].pBatch );
+			vlfftHostFree( stft->core[coreNum].pBatchOut );
+		}
+	}
+	free( stft->core );
+	vlfftHostFree( stft->pWindow );
+	vlfftHostFree( stft->pW );
+	vlfftHostFree( stft->pRing );
+	vlfftHostFree( stft->pSamples );
+	vlfftHostFree( stft->startBarrier );
+	vlfftHostFree( stft->doneBarrier );
+	free( stft );
+}
+
+
+/****************************************/
+/*  STFT of windowLen-point frames      */
+/*  every hop samples, 1 <= hop <=      */
+/*  windowLen, windowLen >= 8 with no   */
+/*  prime factor above                  */
+/*  VLFFT_BATCH_MAX_RADIX.  pWindow has */
+/*  windowLen real weights, NULL for a  */
+/*  periodic Hann window.  Frame f's    */
+/*  spectrum is row f % numRows of the  */
+/*  ring; onRows, if not NULL, is told  */
+/*  of every batch as it is done.       */
+/*  NULL if not supported or out of     */
+/*  memory                              */
+/****************************************/
+vlfft_stft_t *vlfft_stft_create( Uint32 windowLen, Uint32 hop, Uint32 numCores, const float *pWindow, Uint32 numRows,
+                                vlfftStftRows_t onRows, void *rowsArg ) {
+	vlfft_stft_t    *stft;
+	vlfftStftCore_t *core;
+	size_t groupBytes;
+	Uint32 coreNum, i;
+	const double PI = 3.141592654;
+
+	if( windowLen < 8 || hop == 0 || hop > windowLen || numCores == 0 || numRows == 0 || frameRadix( windowLen ) == 0 )
+		return NULL;
+
+	stft = (vlfft_stft_t *)calloc( 1, sizeof(vlfft_stft_t) );
+	if( stft == NULL )
+		return NULL;
+
+	stft->windowLen   = windowLen;
+	stft->hop         = hop;
+	stft->radix       = frameRadix( windowLen );
+	stft->numCores    = numCores;
+	stft->numRows     = numRows;
+	stft->batchFrames = numCores*VLFFT_STFT_FRAMES_PER_CORE;
+	stft->onRows      = onRows;
+	stft->rowsArg     = rowsArg;
+	stft->maxSamples  = windowLen + (size_t)(stft->batchFrames-1)*hop;
+
+	stft->pWindow      = (float *)vlfftHostAlloc( (size_t)windowLen*sizeof(float) );
+	stft->pW           = (float *)vlfftHostAlloc( (size_t)windowLen*BYTES_PER_COMPLEX_SAMPLE );
+	stft->pRing        = (float *)vlfftHostAlloc( (size_t)numRows*windowLen*BYTES_PER_COMPLEX_SAMPLE );
+	stft->pSamples     = (float *)vlfftHostAlloc( stft->maxSamples*BYTES_PER_COMPLEX_SAMPLE );
+	stft->startBarrier = (vlfftBarrier_t *)vlfftHostAlloc( sizeof(vlfftBarrier_t) );
+	stft->doneBarrier  = (vlfftBarrier_t *)vlfftHostAlloc( sizeof(vlfftBarrier_t) );
+	stft->core         = (vlfftStftCore_t *)calloc( numCores, sizeof(vlfftStftCore_t) );
+	if( !stft->pWindow || !stft->pW || !stft->pRing || !stft->pSamples ||
+	    !stft->startBarrier || !stft->doneBarrier || !stft->core ) {
+		stftFree( stft );
+		return NULL;
+	}
+
+	groupBytes = (size_t)windowLen*VLFFT_STFT_GROUP*BYTES_PER_COMPLEX_SAMPLE;
+	for( coreNum=0; coreNum<numCores; coreNum++ ) {
+		core = &stft->core[coreNum];
+		core->stft      = stft;
+		core->coreNum   = coreNum;
+		core->pBatch    = (float *)vlfftHostAlloc( groupBytes );
+		core->pBatchOut = stft->radix == VLFFT_RADIX_MIXED ? (float *)vlfftHostAlloc( groupBytes ) : NULL;
+		if( core->pBatch == NULL || (stft->radix == VLFFT_RADIX_MIXED && core->pBatchOut == NULL) ) {
+			stftFree( stft );
+			return NULL;
+		}
+	}
+
+	for( i=0; i<windowLen; i++ )
+		stft->pWindow[i] = pWindow != NULL ? pWindow[i] : (float)(0.5 - 0.5*cos( 2*PI*i/windowLen ));
+	if( stft->radix == VLFFT_RADIX_MIXED )
+		genTwiddleMixed( stft->pW, windowLen, VLFFT_FORWARD );
+	else
+		tw_gen( stft->pW, windowLen, VLFFT_FORWARD );
+
+	vlfftBarrierInit( stft->startBarrier, numCores+1 );
+	vlfftBarrierInit( stft->doneBarrier,  numCores+1 );
+	for( coreNum=0; coreNum<numCores; coreNum++ ) {
+		if( pthread_create( &stft->core[coreNum].thread, NULL, stftWorker, &stft->core[coreNum] ) != 0 ) {
+			fprintf( stderr, "vlfft: cannot create STFT worker thread %u\n", coreNum );
+			exit( 1 );
+		}
+	}
+
+	return stft;
+}
+
+
+/****************************************/
+/*  numSamples more complex samples of  */
+/*  the stream: every frame they        */
+/*  complete is computed before this    */
+/*  returns, a batch at a time.         */
+/*  Returns the number of frames        */
+/****************************************/
+Int32 vlfft_stft_push( vlfft_stft_t *stft, const float *pIn, size_t numSamples ) {
+	unsigned long long startNs;
+	size_t num, consumed;
+	Int32  numFrames = 0;
+
+	startNs = vlfftProfileNowNs();
+	stft->stats.numSamples += numSamples;
+
+	while( numSamples > 0 ) {
+		num = stft->maxSamples - stft->numSamples;
+		if( num > numSamples )
+			num = numSamples;
+		memcpy( stft->pSamples + 2*stft->numSamples, pIn, num*BYTES_PER_COMPLEX_SAMPLE );
+		stft->numSamples += num;
+		pIn        += 2*num;
+		numSamples -= num;
+		if( stft->numSamples < stft->windowLen )
+			break;
+
+		stft->firstFrame = stft->framesDone;
+		stft->numFrames  = (Uint32)((stft->numSamples - stft->windowLen)/stft->hop + 1);
+		vlfftBarrierWait( stft->startBarrier, stft->numCores, &stft->startSense );
+		vlfftBarrierWait( stft->doneBarrier,  stft->numCores, &stft->doneSense );
+
+		stft->framesDone += stft->numFrames;
+		numFrames        += stft->numFrames;
+		if( stft->onRows != NULL )
+			stft->onRows( stft->rowsArg, stft->firstFrame, stft->numFrames );
+
+		// the next frame starts numFrames hops on
+		consumed = (size_t)stft->numFrames*stft->hop;
+		memmove( stft->pSamples, stft->pSamples + 2*consumed, (stft->numSamples - consumed)*BYTES_PER_COMPLEX_SAMPLE );
+		stft->numSamples -= consumed;
+	}
+
+	stft->stats.numFrames  += numFrames;
+	stft->stats.totalMs    += (vlfftProfileNowNs() - startNs)/1e6;
+
+	return numFrames;
+}
+
+
+/****************************************/
+/*  spectrum of frame, windowLen bins   */
+/*  in the ring; NULL if the frame is   */
+/*  not done yet or already overwritten */
+/****************************************/
+float *vlfft_stft_row( vlfft_stft_t *stft, unsigned long long frame ) {
+	if( frame >= stft->framesDone || stft->framesDone - frame > stft->numRows )
+		return NULL;
+	return stft->pRing + 2*(size_t)stft->windowLen*(frame % stft->numRows);
+}
+
+
+/****************************************/
+/*  samples pushed, frames computed and */
+/*  time spent in vlfft_stft_push()     */
+/*  since the engine was made or reset, */
+/*  and the throughput                  */
+/****************************************/
+void vlfft_stft_stats( vlfft_stft_t *stft, vlfftStftStats_t *pStats, Bool reset ) {
+	*pStats = stft->stats;
+	pStats->samplesPerSec = pStats->totalMs > 0.0 ? pStats->numSamples/(pStats->totalMs/1000.0) : 0.0;
+	if( reset )
+		memset( &stft->stats, 0, sizeof(stft->stats) );
+}
+
+
+/****************************************/
+/*  start a new stream at frame 0:      */
+/*  queued samples dropped, statistics  */
+/*  zeroed                              */
+/****************************************/
+void vlfft_stft_reset( vlfft_stft_t *stft ) {
+	stft->numSamples = 0;
+	stft->framesDone = 0;
+	memset( &stft->stats, 0, sizeof(stft->stats) );
+}
+
+
+/****************************************/
+/*  stop the workers and free the       */
+/*  engine                              */
+/****************************************/
+void vlfft_stft_delete( vlfft_stft_t *stft ) {
+	Uint32 coreNum;
+
+	stft->exit = TRUE;
+	vlfftBarrierWait( stft->startBarrier, stft->numCores, &stft->startSense );
+	for( coreNum=0; coreNum<stft->numCores; coreNum++ )
+		pthread_join( stft->core[coreNum].thread, NULL );
+
+	stftFree( stft );
+}
@@ -0,0 +1,270 @@
+/*
+ * vlfftTransposeStrided()
+ * vlfftTransposeSquareBand()
+ *
+ *    Complex (rows x cols) -> (cols x rows) transposes of any shape.
+ *    The matrix is halved along its longer side until a block fits in
+ *    VLFFT_TRANSPOSE_TILE x VLFFT_TRANSPOSE_TILE samples, which keeps
+ *    both the source and destination block in L1 whatever the sizes
+ *    (cache oblivious).  Blocks are done 4x4 samples at a time, with
+ *    AVX or SSE2 when the compiler targets them.  vlfftTransposeStrided()
+ *    turns a block of a larger array into another (vlfft_execute_file()),
+ *    vlfftTransposeSquareBand() transposes one band of rows of a square
+ *    matrix in place so that cores can share the work (the natural order
+ *    in place plans)
+ *
+ * Copyright (C) {2011} Texas Instruments Incorporated - http://www.ti.com/
+ *
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *    Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ *    Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the
+ *    distribution.
+ *
+ *    Neither the name of Texas Instruments Incorporated nor the names of
+ *    its contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ *  A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ *  OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *  SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *  LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ *  DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ *  THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ *  (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ *  OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+*/
+
+
+#include <string.h>
+#if defined(__AVX__) || defined(__SSE2__)
+#include <immintrin.h>
+#endif
+
+#include "vlfftHostStd.h"
+
+/* vlfft.h */
+#include "../vlfftInc/vlfftDebug.h"
+#include "../vlfftInc/vlfftMessgQ.h"
+#include "../vlfftInc/vlfft.h"
+#include "../vlfftInc/vlfftconfig.h"
+#include "vlfftHost.h"
+
+
+/*********************************************************/
+/*  4x4 complex samples, row pitch ldIn, into 4x4 with   */
+/*  row pitch ldOut (pitches in complex samples).  All   */
+/*  of pIn is read before pOut is written, so pIn may    */
+/*  equal pOut                                           */
+/*********************************************************/
+static inline void transpose4x4( const float *pIn, size_t ldIn, float *pOut, size_t ldOut ) {
+#if defined(__AVX__)
+	// a complex float is one double lane
+	__m256d r0, r1, r2, r3, t0, t1, t2, t3;
+
+	r0 = _mm256_castps_pd( _mm256_loadu_ps( pIn          ) );
+	r1 = _mm256_castps_pd( _mm256_loadu_ps( pIn + 2*ldIn ) );
+	r2 = _mm256_castps_pd( _mm256_loadu_ps( pIn + 4*ldIn ) );
+	r3 = _mm256_castps_pd( _mm256_loadu_ps( pIn + 6*ldIn ) );
+
+	t0 = _mm256_unpacklo_pd( r0, r1 );
+	t1 = _mm256_unpackhi_pd( r0, r1 );
+	t2 = _mm256_unpacklo_pd( r2, r3 );
+	t3 = _mm256_unpackhi_pd( r2, r3 );
+
+	_mm256_storeu_ps( pOut,           _mm256_castpd_ps( _mm256_permute2f128_pd( t0, t2, 0x20 ) ) );
+	_mm256_storeu_ps( pOut + 2*ldOut, _mm256_castpd_ps( _mm256_permute2f128_pd( t1, t3, 0x20 ) ) );
+	_mm256_storeu_ps( pOut + 4*ldOut, _mm256_castpd_ps( _mm256_permute2f128_pd( t0, t2, 0x31 ) ) );
+	_mm256_storeu_ps( pOut + 6*ldOut, _mm256_castpd_ps( _mm256_permute2f128_pd( t1, t3, 0x31 ) ) );
+#elif defined(__SSE2__)
+	// four 2x2 blocks of two complex per register
+	__m128d r[4][2];
+	int     i, j;
+
+	for( i=0; i<4; i++ ) {
+		r[i][0] = _mm_castps_pd( _mm_loadu_ps( pIn + 2*i*ldIn     ) );
+		r[i][1] = _mm_castps_pd( _mm_loadu_ps( pIn + 2*i*ldIn + 4 ) );
+	}
+	for( i=0; i<4; i+=2 ) {
+		for( j=0; j<2; j++ ) {
+			_mm_storeu_ps( pOut + 2*(2*j  )*ldOut + 2*i, _mm_castpd_ps( _mm_unpacklo_pd( r[i][j], r[i+1][j] ) ) );
+			_mm_storeu_ps( pOut + 2*(2*j+1)*ldOut + 2*i, _mm_castpd_ps( _mm_unpackhi_pd( r[i][j], r[i+1][j] ) ) );
+		}
+	}
+#else
+	float t[32];
+	int   i, j;
+
+	for( i=0; i<4; i++ )
+		memcpy( &t[8*i], pIn + 2*i*ldIn, 8*sizeof(float) );
+	for( i=0; i<4; i++ ) {
+		for( j=0; j<4; j++ ) {
+			pOut[2*(j*ldOut+i)  ] = t[8*i+2*j  ];
+			pOut[2*(j*ldOut+i)+1] = t[8*i+2*j+1];
+		}
+	}
+#endif
+}
+
+
+/* out-of-place block that fits the tile, ragged edges sample by sample */
+static void transposeLeaf( const float *pIn, size_t ldIn, float *pOut, size_t ldOut, Uint32 rows, Uint32 cols ) {
+	Uint32 r, c, rows4, cols4;
+
+	rows4 = rows & ~3U;
+	cols4 = cols & ~3U;
+
+	for( r=0; r<rows4; r+=4 )
+		for( c=0; c<cols4; c+=4 )
+			transpose4x4( pIn + 2*(r*ldIn+c), ldIn, pOut + 2*(c*ldOut+r), ldOut );
+
+	for( r=0; r<rows; r++ ) {
+		for( c=(r<rows4 ? cols4 : 0); c<cols; c++ ) {
+			pOut[2*(c*ldOut+r)  ] = pIn[2*(r*ldIn+c)  ];
+			pOut[2*(c*ldOut+r)+1] = pIn[2*(r*ldIn+c)+1];
+		}
+	}
+}
+
+
+/* splits stay multiples of 4 so the halves keep whole 4x4 kernels */
+static Uint32 splitPoint( Uint32 n ) {
+	Uint32 h = ((n>>1)+3) & ~3U;
+
+	return h < n ? h : n>>1;
+}
+
+
+static void transposeRec( const float *pIn, size_t ldIn, float *pOut, size_t ldOut, Uint32 rows, Uint32 cols ) {
+	Uint32 h;
+
+	if( rows <= VLFFT_TRANSPOSE_TILE && cols <= VLFFT_TRANSPOSE_TILE ) {
+		transposeLeaf( pIn, ldIn, pOut, ldOut, rows, cols );
+		return;
+	}
+
+	if( rows >= cols ) {
+		h = splitPoint( rows );
+		transposeRec( pIn,             ldIn, pOut,       ldOut, h,      cols );
+		transposeRec( pIn + 2*h*ldIn,  ldIn, pOut + 2*h, ldOut, rows-h, cols );
+	} else {
+		h = splitPoint( cols );
+		transposeRec( pIn,       ldIn, pOut,              ldOut, rows, h      );
+		transposeRec( pIn + 2*h, ldIn, pOut + 2*h*ldOut,  ldOut, rows, cols-h );
+	}
+}
+
+
+/*********************************************************/
+/*  A (rows x cols) and B (cols x rows), both with pitch */
+/*  ld, become B^T and A^T: the off-diagonal halves of   */
+/*  an in-place square transpose                         */
+/*********************************************************/
+static void swapLeaf( float *pA, float *pB, size_t ld, Uint32 rows, Uint32 cols ) {
+	Uint32 r, c, rows4, cols4;
+	float  t[32], x;
+
+	rows4 = rows & ~3U;
+	cols4 = cols & ~3U;
+
+	for( r=0; r<rows4; r+=4 ) {
+		for( c=0; c<cols4; c+=4 ) {
+			vlfftHostCopy2D( t, 8*sizeof(float), pA + 2*(r*ld+c), 2*ld*sizeof(float), 8*sizeof(float), 4 );
+			transpose4x4( pB + 2*(c*ld+r), ld, pA + 2*(r*ld+c), ld );
+			transpose4x4( t, 4, pB + 2*(c*ld+r), ld );
+		}
+	}
+
+	for( r=0; r<rows; r++ ) {
+		for( c=(r<rows4 ? cols4 : 0); c<cols; c++ ) {
+			x = pA[2*(r*ld+c)  ];  pA[2*(r*ld+c)  ] = pB[2*(c*ld+r)  ];  pB[2*(c*ld+r)  ] = x;
+			x = pA[2*(r*ld+c)+1];  pA[2*(r*ld+c)+1] = pB[2*(c*ld+r)+1];  pB[2*(c*ld+r)+1] = x;
+		}
+	}
+}
+
+
+static void swapRec( float *pA, float *pB, size_t ld, Uint32 rows, Uint32 cols ) {
+	Uint32 h;
+
+	if( rows <= VLFFT_TRANSPOSE_TILE && cols <= VLFFT_TRANSPOSE_TILE ) {
+		swapLeaf( pA, pB, ld, rows, cols );
+		return;
+	}
+
+	if( rows >= cols ) {
+		h = splitPoint( rows );
+		swapRec( pA,            pB,       ld, h,      cols );
+		swapRec( pA + 2*h*ld,   pB + 2*h, ld, rows-h, cols );
+	} else {
+		h = splitPoint( cols );
+		swapRec( pA,            pB,            ld, rows, h      );
+		swapRec( pA + 2*h,      pB + 2*h*ld,   ld, rows, cols-h );
+	}
+}
+
+
+static void squareRec( float *p, size_t ld, Uint32 n ) {
+	Uint32 i, r, c, n4;
+	float  x;
+
+	if( n > VLFFT_TRANSPOSE_TILE ) {
+		i = splitPoint( n );
+		squareRec( p,                 ld, i   );
+		squareRec( p + 2*(i*ld+i),    ld, n-i );
+		swapRec( p + 2*i, p + 2*i*ld, ld, i, n-i );
+		return;
+	}
+
+	// 4x4 diagonal blocks in place, each 4 row band swapped with
+	// the 4 column band below it, then the ragged corner
+	n4 = n & ~3U;
+	for( i=0; i<n4; i+=4 ) {
+		transpose4x4( p + 2*(i*ld+i), ld, p + 2*(i*ld+i), ld );
+		if( i+4 < n )
+			swapLeaf( p + 2*(i*ld+i+4), p + 2*((i+4)*ld+i), ld, 4, n-i-4 );
+	}
+	for( r=n4; r<n; r++ ) {
+		for( c=r+1; c<n; c++ ) {
+			x = p[2*(r*ld+c)  ];  p[2*(r*ld+c)  ] = p[2*(c*ld+r)  ];  p[2*(c*ld+r)  ] = x;
+			x = p[2*(r*ld+c)+1];  p[2*(r*ld+c)+1] = p[2*(c*ld+r)+1];  p[2*(c*ld+r)+1] = x;
+		}
+	}
+}
+
+
+/*********************************************************/
+/*  pIn (rows x cols) -> pOut (cols x rows), complex     */
+/*  samples with row pitches inStride and outStride in   */
+/*  complex samples, for corner turns of a block inside  */
+/*  a larger array; pIn and pOut must not overlap        */
+/*********************************************************/
+void vlfftTransposeStrided( const float *pIn, size_t inStride, float *pOut, size_t outStride, Uint32 rows, Uint32 cols ) {
+	transposeRec( pIn, inStride, pOut, outStride, rows, cols );
+}
+
+
+/*********************************************************/
+/*  rows row0 .. row1-1 of an in-place n x n transpose,  */
+/*  pitch ld: the diagonal block and the swap of the     */
+/*  band right of it with the columns below it.  Bands   */
+/*  that do not overlap touch disjoint samples           */
+/*********************************************************/
+void vlfftTransposeSquareBand( float *p, size_t ld, Uint32 n, Uint32 row0, Uint32 row1 ) {
+	if( row1 <= row0 )
+		return;
+	squareRec( p + 2*(row0*ld+row0), ld, row1-row0 );
+	if( row1 < n )
+		swapRec( p + 2*(row0*ld+row1), p + 2*(row1*ld+row0), ld, row1-row0, n-row1 );
+}
@@ -0,0 +1,172 @@
+/*
+ * vlfft_tune()
+ *
+ *    Times every legal N1*N2 split, radix pair (4, 2 or VLFFT_RADIX_MIXED)
+ *    and block size for an N-point FFT on numCores cores, then the
+ *    vlfftBatchFFTStages() sequences of radix 4, up to 8 and up to 16 for
+ *    each pass of the fastest, and stores the winner in the wisdom file,
+ *    where vlfftConfigSelect() picks it up
+ *
+ *
+ * Copyright (C) {2011} Texas Instruments Incorporated - http://www.ti.com/
+ *
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *    Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ *    Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the
+ *    distribution.
+ *
+ *    Neither the name of Texas Instruments Incorporated nor the names of
+ *    its contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ *  A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ *  OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *  SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *  LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ *  DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ *  THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ *  (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ *  OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+*/
+
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "vlfftHostStd.h"
+
+/* vlfft.h */
+#include "../vlfftInc/vlfftDebug.h"
+#include "../vlfftInc/vlfftMessgQ.h"
+#include "../vlfftInc/vlfft.h"
+#include "../vlfftInc/vlfftconfig.h"
+#include "vlfftHost.h"
+
+
+static double timeNowMs( void ) {
+	struct timespec ts;
+
+	clock_gettime( CLOCK_MONOTONIC, &ts );
+	return ts.tv_sec*1000.0 + ts.tv_nsec/1000000.0;
+}
+
+
+/****************************************/
+/*  best of VLFFT_TUNE_RUNS, after one  */
+/*  warm-up run; < 0 on failure         */
+/****************************************/
+static double timeConfig( const VLFFTconfig_t *VLFFTconfig, float *pIn, float *pWork, float *pOut ) {
+	vlfftHostEngine_t engine;
+	double            timer0, t, best;
+	Uint32            run;
+
+	if( vlfftHostEngineCreate( &engine, VLFFTconfig ) != 0 )
+		return -1.0;
+
+	vlfftHostEngineRun( &engine, pIn, pWork, pOut );
+
+	best = -1.0;
+	for( run=0; run<VLFFT_TUNE_RUNS; run++ ) {
+		timer0 = timeNowMs();
+		vlfftHostEngineRun( &engine, pIn, pWork, pOut );
+		t = timeNowMs() - timer0;
+		if( best < 0.0 || t < best )
+			best = t;
+	}
+
+	vlfftHostEngineDelete( &engine );
+	return best;
+}
+
+
+/*******************************************************/
+/*    returns 0 with the fastest configuration in      */
+/*    pBest (and its time in *pMsPerFft when not NULL) */
+/*    -1 if nothing could be timed                     */
+/*******************************************************/
+Int32 vlfft_tune( Uint32 N, Uint32 numCores, VLFFTconfig_t *pBest, double *pMsPerFft ) {
+	static const Uint32 radix[3] = { 4, 2, VLFFT_RADIX_MIXED };
+	static const Uint32 maxRadix[3] = { 4, 8, 16 };
+	VLFFTconfig_t VLFFTconfig;
+	float   *pIn, *pWork, *pOut;
+	double  t, best;
+	Uint32  N1, r1, r2, samplesPerBlock, i, pass, r;
+
+	pIn   = (float *)vlfftHostAlloc( (size_t)N*BYTES_PER_COMPLEX_SAMPLE );
+	pWork = (float *)vlfftHostAlloc( (size_t)N*BYTES_PER_COMPLEX_SAMPLE );
+	pOut  = (float *)vlfftHostAlloc( (size_t)N*BYTES_PER_COMPLEX_SAMPLE );
+	if( pIn == NULL || pWork == NULL || pOut == NULL ) {
+		vlfftHostFree( pIn );
+		vlfftHostFree( pWork );
+		vlfftHostFree( pOut );
+		return -1;
+	}
+
+	for( i=0; i<2*N; i++ )
+		pIn[i] = (float)((i*2654435761U)>>16)/65536.0f - 0.5f;
+
+	best = -1.0;
+	for( N1=1U<<VLFFT_MIN_LOG2_FFT_SIZE; N1<N; N1++ ) {
+		if( N%N1 != 0 )
+			continue;
+		for( r1=0; r1<3; r1++ ) {
+			for( r2=0; r2<3; r2++ ) {
+				for( samplesPerBlock=1; samplesPerBlock<=VLFFT_MAX_SAMPLES_PER_BLOCK; samplesPerBlock<<=1 ) {
+					if( vlfftConfigFactor( &VLFFTconfig, N, numCores, N1, radix[r1], radix[r2], samplesPerBlock ) != 0 )
+						continue;
+
+					t = timeConfig( &VLFFTconfig, pIn, pWork, pOut );
+					if( t >= 0.0 && (best < 0.0 || t < best) ) {
+						best   = t;
+						*pBest = VLFFTconfig;
+					}
+				}
+			}
+		}
+	}
+
+	// the stages of the winner's passes, one pass at a time
+	for( pass=0; pass<2 && best >= 0.0; pass++ ) {
+		if( (pass == 0 ? pBest->radix_1stIter : pBest->radix_2ndIter) == VLFFT_RADIX_MIXED )
+			continue;
+		for( r=0; r<3; r++ ) {
+			VLFFTconfig = *pBest;
+			if( pass == 0 )
+				VLFFTconfig.stages_1stIter = vlfftBatchStages( VLFFTconfig.N1, maxRadix[r] );
+			else
+				VLFFTconfig.stages_2ndIter = vlfftBatchStages( VLFFTconfig.N2, maxRadix[r] );
+
+			t = timeConfig( &VLFFTconfig, pIn, pWork, pOut );
+			if( t >= 0.0 && t < best ) {
+				best   = t;
+				*pBest = VLFFTconfig;
+			}
+		}
+	}
+
+	vlfftHostFree( pIn );
+	vlfftHostFree( pWork );
+	vlfftHostFree( pOut );
+
+	if( best < 0.0 )
+		return -1;
+
+	if( pMsPerFft != NULL )
+		*pMsPerFft = best;
+
+	return vlfftWisdomStore( pBest, best );
+}
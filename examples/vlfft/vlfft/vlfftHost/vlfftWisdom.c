@@ -0,0 +1,211 @@
+/*
+ * vlfftWisdomLookup()
+ * vlfftWisdomStore()
+ *
+ *    Tuned plans kept across runs.  The wisdom file holds one line per
+ *    (N, numCores): the N1*N2 split, radices and block size the tuner
+ *    found fastest on this machine.  It is read once, on the first
+ *    lookup, from $VLFFT_WISDOM or ./vlfft.wisdom
+ *
+ *
+ * Copyright (C) {2011} Texas Instruments Incorporated - http://www.ti.com/
+ *
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *    Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ *    Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the
+ *    distribution.
+ *
+ *    Neither the name of Texas Instruments Incorporated nor the names of
+ *    its contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ *  A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ *  OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *  SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *  LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ *  DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ *  THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ *  (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ *  OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+*/
+
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <pthread.h>
+
+#include "vlfftHostStd.h"
+
+/* vlfft.h */
+#include "../vlfftInc/vlfftDebug.h"
+#include "../vlfftInc/vlfftMessgQ.h"
+#include "../vlfftInc/vlfft.h"
+#include "../vlfftInc/vlfftconfig.h"
+#include "vlfftHost.h"
+
+
+typedef struct {
+	VLFFTconfig_t VLFFTconfig;
+	double        msPerFft;
+} vlfftWisdom_t;
+
+static vlfftWisdom_t   wisdom[VLFFT_MAX_WISDOM];
+static Uint32          numWisdom  = 0;
+static Bool            wisdomRead = FALSE;
+static pthread_mutex_t wisdomLock = PTHREAD_MUTEX_INITIALIZER;
+
+
+const char *vlfftWisdomPath( void ) {
+	const char *path = getenv( "VLFFT_WISDOM" );
+
+	return path != NULL && path[0] != '\0' ? path : VLFFT_WISDOM_FILE;
+}
+
+
+static vlfftWisdom_t *wisdomFind( Uint32 N, Uint32 numCores ) {
+	Uint32 i;
+
+	for( i=0; i<numWisdom; i++ )
+		if( wisdom[i].VLFFTconfig.N == N && wisdom[i].VLFFTconfig.numCoresForFftCompute == numCores )
+			return &wisdom[i];
+	return NULL;
+}
+
+
+/****************************************/
+/*  N numCores N1 N2 radix1 radix2      */
+/*  samplesPerBlock msPerFft and, if    */
+/*  tuned, stages1 stages2, the packed  */
+/*  vlfftBatchFFTStages() sequences;    */
+/*  without them the default ones.      */
+/*  Lines that do not give a legal      */
+/*  configuration are skipped, columns  */
+/*  after stages2 ignored               */
+/****************************************/
+static void wisdomLoad( void ) {
+	FILE          *fp;
+	char          line[256];
+	unsigned      N, numCores, N1, N2, radix1, radix2, samplesPerBlock, stages1, stages2;
+	double        msPerFft;
+	int           numFields;
+	VLFFTconfig_t VLFFTconfig;
+
+	wisdomRead = TRUE;
+
+	fp = fopen( vlfftWisdomPath(), "r" );
+	if( fp == NULL )
+		return;
+
+	while( fgets( line, sizeof(line), fp ) != NULL && numWisdom < VLFFT_MAX_WISDOM ) {
+		if( line[0] == '#' )
+			continue;
+		numFields = sscanf( line, "%u %u %u %u %u %u %u %lf %u %u", &N, &numCores, &N1, &N2,
+		                    &radix1, &radix2, &samplesPerBlock, &msPerFft, &stages1, &stages2 );
+		if( numFields != 8 && numFields != 10 )
+			continue;
+		if( N1*N2 != N || vlfftConfigFactor( &VLFFTconfig, N, numCores, N1, radix1, radix2, samplesPerBlock ) != 0 )
+			continue;
+		if( numFields == 10 ) {
+			if( (radix1 != VLFFT_RADIX_MIXED && !vlfftBatchStagesValid( N1, stages1 )) ||
+			    (radix2 != VLFFT_RADIX_MIXED && !vlfftBatchStagesValid( N2, stages2 )) )
+				continue;
+			VLFFTconfig.stages_1stIter = radix1 != VLFFT_RADIX_MIXED ? stages1 : 0;
+			VLFFTconfig.stages_2ndIter = radix2 != VLFFT_RADIX_MIXED ? stages2 : 0;
+		}
+		if( wisdomFind( N, numCores ) != NULL )
+			continue;
+
+		wisdom[numWisdom].VLFFTconfig = VLFFTconfig;
+		wisdom[numWisdom].msPerFft    = msPerFft;
+		numWisdom++;
+	}
+
+	fclose( fp );
+}
+
+
+/****************************************/
+/*  0 and the tuned configuration if    */
+/*  the wisdom file has (N, numCores),  */
+/*  -1 otherwise                        */
+/****************************************/
+Int32 vlfftWisdomLookup( VLFFTconfig_t *VLFFTconfig, Uint32 N, Uint32 numCores ) {
+	vlfftWisdom_t *entry;
+
+	pthread_mutex_lock( &wisdomLock );
+
+	if( !wisdomRead )
+		wisdomLoad();
+
+	entry = wisdomFind( N, numCores );
+	if( entry != NULL )
+		*VLFFTconfig = entry->VLFFTconfig;
+
+	pthread_mutex_unlock( &wisdomLock );
+
+	return entry != NULL ? 0 : -1;
+}
+
+
+/****************************************/
+/*  add or replace the entry for        */
+/*  VLFFTconfig and rewrite the file    */
+/****************************************/
+Int32 vlfftWisdomStore( const VLFFTconfig_t *VLFFTconfig, double msPerFft ) {
+	vlfftWisdom_t *entry;
+	FILE          *fp;
+	Uint32        i;
+	Int32         status = 0;
+
+	pthread_mutex_lock( &wisdomLock );
+
+	if( !wisdomRead )
+		wisdomLoad();
+
+	entry = wisdomFind( VLFFTconfig->N, VLFFTconfig->numCoresForFftCompute );
+	if( entry == NULL ) {
+		if( numWisdom == VLFFT_MAX_WISDOM ) {
+			pthread_mutex_unlock( &wisdomLock );
+			return -1;
+		}
+		entry = &wisdom[numWisdom++];
+	}
+	entry->VLFFTconfig = *VLFFTconfig;
+	entry->msPerFft    = msPerFft;
+
+	fp = fopen( vlfftWisdomPath(), "w" );
+	if( fp == NULL ) {
+		pthread_mutex_unlock( &wisdomLock );
+		return -1;
+	}
+
+	fprintf( fp, "# vlfft wisdom: N numCores N1 N2 radix_1stIter radix_2ndIter samplesPerBlock msPerFft"
+	             " stages_1stIter stages_2ndIter\n" );
+	for( i=0; i<numWisdom; i++ ) {
+		fprintf( fp, "%u %u %u %u %u %u %u %f %u %u\n",
+		         wisdom[i].VLFFTconfig.N, wisdom[i].VLFFTconfig.numCoresForFftCompute,
+		         wisdom[i].VLFFTconfig.N1, wisdom[i].VLFFTconfig.N2,
+		         wisdom[i].VLFFTconfig.radix_1stIter, wisdom[i].VLFFTconfig.radix_2ndIter,
+		         wisdom[i].VLFFTconfig.samplesPerBlock, wisdom[i].msPerFft,
+		         wisdom[i].VLFFTconfig.stages_1stIter, wisdom[i].VLFFTconfig.stages_2ndIter );
+	}
+
+	if( fclose( fp ) != 0 )
+		status = -1;
+
+	pthread_mutex_unlock( &wisdomLock );
+	return status;
+}
@@ -38,10 +38,14 @@
 
 
 
+#ifdef	VLFFT_HOST
+#include	"../vlfftHost/vlfftHostStd.h"
+#else
 #include	<ti/sdo/edma3/drv/sample/bios6_edma3_drv_sample.h>
+#endif
 
 
-
+#ifndef	VLFFT_HOST
 typedef	struct {
 	Int32		instNum;
 	Uint32		dmaChannelIn;
@@ -172,6 +176,7 @@ typedef	struct {
 
 
 }	DMAparams_t;
+#endif	//	VLFFT_HOST
 
 /****************************************/
 /*		N=N1*N2														*/
@@ -189,12 +194,17 @@ typedef	struct {
 	Uint32				log4N_1stIter;
 	Uint32				radix_2ndIter;
 	Uint32				log4N_2ndIter;
+	Uint32				stages_1stIter;			//	vlfftBatchFFTStages()	radices,	vlfftBatchStages()
+	Uint32				stages_2ndIter;
 
 	Uint32				N;
 	Uint32				N1;
 	Uint32				N2;
 	Uint32				samplesPerBlock;
 
+	Uint32				direction;						//	VLFFT_FORWARD	or	VLFFT_INVERSE
+	float				scale;								//	applied	in	the	2nd	iteration,	1	or	1/N;	_COLUMNS:	in	the	1st,	1/N1
+
 	//	1st	iteration
 	Uint32				offset1stIterIn;
 	Uint32				step1stIterIn;
@@ -224,10 +234,101 @@ typedef	struct {
 	float				*pW1;
 	float				*pW2;
 	float				*pTwiddle;
+	float				*pTwiddleTable;				//	anchors	W_N^(n2*k1),	k1	=	0,	K,	2K	..
+	Uint32				twiddleAnchorStep;		//	K,	0	when	pTwiddle	alone	is	used
+
+	Uint32				bufferDepth;					//	in/out	blocks	in	the	internal	buffers
+	Uint32				inPlace;							//	output	over	the	input,	no	intermediate
+	Uint32				intermediate;					//	VLFFT_INTERMEDIATE_FLOAT,	_FP16	or	_BF16
+	Uint32				transform;						//	VLFFT_TRANSFORM_1D,	_2D	or	_COLUMNS
+	const	float		*pFilterSpec;					//	host	convolution:	H[k]/N	in	the	order	the	2nd	iteration	writes,	or	NULL
+	Uint32				inputBegin;						//	pruned:	samples	outside	[inputBegin,	inputEnd)	are	zero,
+	Uint32				inputEnd;						//	bins	outside	[outputBegin,	outputEnd)	not	needed
+	Uint32				outputBegin;
+	Uint32				outputEnd;
 
 } VLFFTparams_t;
 
 
+/****************************************/
+/*		FFT	size,	N1*N2	split,	radix		*/
+/*		and	blocking										*/
+/****************************************/
+typedef	struct {
+	Uint32				N;
+	Uint32				N1;
+	Uint32				N2;
+	Uint32				radix_1stIter;
+	Uint32				log4N_1stIter;
+	Uint32				radix_2ndIter;
+	Uint32				log4N_2ndIter;
+	Uint32				stages_1stIter;			//	vlfftBatchFFTStages()	radices,	vlfftBatchStages()
+	Uint32				stages_2ndIter;
+
+	Uint32				maxNumCores;
+	Uint32				numCoresForFftCompute;
+	Uint32				log2NumCoresForFftCompute;		//	0	unless	numCores	is	a	power	of	2
+
+	Uint32				samplesPerBlock;				//	also	FFTs	per	block
+	Uint32				log2SamplesPerBlock;
+
+	Uint32				direction;						//	VLFFT_FORWARD	or	VLFFT_INVERSE
+	Uint32				scaleInverse;					//	scale	the	inverse	by	1/N
+
+	Uint32				twiddleMode;					//	VLFFT_TWIDDLE_RECURSIVE,	_TABLE	or	_HYBRID
+	Uint32				twiddleAnchorStep;		//	K	for	VLFFT_TWIDDLE_HYBRID
+
+	Uint32				bufferDepth;					//	2	(ping-pong)	..	VLFFT_MAX_BUFFER_DEPTH,	2	on	the	DSP
+	Uint32				emulateEdma;					//	host:	emulated	asynchronous	EDMA	even	without	VLFFT_EDMA=1
+	Uint32				inPlace;							//	VLFFT_OUT_OF_PLACE,	VLFFT_IN_PLACE	or	_NATURAL
+	Uint32				intermediate;					//	VLFFT_INTERMEDIATE_FLOAT,	_FP16	or	_BF16
+	Uint32				schedule;							//	VLFFT_SCHEDULE_STATIC	or	_DYNAMIC,	any	numCores
+	Uint32				transform;						//	VLFFT_TRANSFORM_1D	..	_COLUMNS;	3D:	N1	x	N2	x	N/(N1*N2)
+	Uint32				inputBegin;						//	pruned	FFT:	nonzero	input	range	and	bins	needed,
+	Uint32				inputEnd;						//	an	end	of	0	for	N
+	Uint32				outputBegin;
+	Uint32				outputEnd;
+} VLFFTconfig_t;
+
+
+
+/****************************************/
+/*		sense	reversing	barrier	between		*/
+/*		the	cores,	vlfftBarrier.c.	Each	*/
+/*		flag	has	a	cache	line	to	itself	*/
+/****************************************/
+#define	VLFFT_CACHE_LINE_BYTES		128		//	C66x	L2	line,	two	x86	lines
+#define	VLFFT_BARRIER_MAX_CORES		8
+
+typedef	struct {
+	volatile	Uint32		value;
+	Uint32				pad[VLFFT_CACHE_LINE_BYTES/sizeof(Uint32)-1];
+}	vlfftBarrierFlag_t;
+
+typedef	struct {
+	vlfftBarrierFlag_t	sense;							//	flipped	once	all	cores	are	in
+#ifdef	VLFFT_HOST
+	vlfftBarrierFlag_t	count;							//	cores	in	so	far
+	vlfftBarrierFlag_t	numSleepers;				//	waiters	blocked	in	the	kernel
+	Uint32				spins;								//	polls	before	a	waiter	sleeps
+#else
+	vlfftBarrierFlag_t	arrive[VLFFT_BARRIER_MAX_CORES];	//	sense	of	each	core's	last	arrival
+#endif
+	Uint32				numCores;
+}	vlfftBarrier_t;
+
+
+/****************************************/
+/*		FFT	output	against	the	double				*/
+/*		reference,	vlfftValidate.c					*/
+/****************************************/
+typedef	struct {
+	double				maxAbsError;					//	largest	|X	-	Xref|
+	Uint32				maxErrorBin;
+	double				rmsError;
+	double				snrDb;								//	sum	|Xref|^2	over	sum	|X	-	Xref|^2
+}	vlfftErrorStats_t;
+
 
 typedef	struct {
 
@@ -243,6 +344,7 @@ typedef	struct {
 #endif
 }	VLFFTbuffers_t;
 
+#ifndef	VLFFT_HOST
 void	vlfftEdmaInit(	DMAparams_t	*DMAparams);
 void	vlfftEdmaConfig_1stIter(	DMAparams_t	*DMAparams);
 void	vlfftEdmaConfig_2ndIter(	DMAparams_t	*DMAparams);
@@ -257,18 +359,46 @@ void	vlfftEdmaConfig_srcAddrdstAddr_aCntbCntcCnt(	EDMA3_DRV_Handle		hEdma,
 void	vlfftEdmaConfig_srcAddrdstAddr(	EDMA3_DRV_Handle	hEdma,	EDMA3_DRV_PaRAMRegs	*pParamSet,	Uint32	chId,	Uint32	srcAddr,	Uint32	dstAddr	);
 void	edmaTrigger(	EDMA3_DRV_Handle	hEdma,	Uint32	chId	);
 void	edmaPoll(	EDMA3_DRV_Handle	hEdma,	Uint32	tcc	);
+#endif	//	VLFFT_HOST
 
-void	genTwiddle(float	*pTwiddle,	int	numFFTsPerCore,	int	coreNum);
+void	genTwiddle(float	*pTwiddle,	int	n,	int	numFFTsPerCore,	int	coreNum,	int	direction);
+void	genTwiddleTable(float	*pTable,	int	n,	int	n1,	int	numFFTsPerCore,	int	coreNum,	int	anchorStep,	int	direction);
 
 void	DSPF_sp_mixedRadix_fftSPxSP(	Uint32	n,	float	*pIn,	float	*pTwiddle,	float	*pOut	);
 void	DSPF_sp_radix4_fftSPxSP(	Uint32	n,	float	*pIn,	float	*pTwiddle,	float	*pOut,	Uint32	log4NMinus1	);
+void	DSPF_sp_mixedRadix_ifftSPxSP(	Uint32	n,	float	*pIn,	float	*pTwiddle,	float	*pOut,	float	scale	);
+void	DSPF_sp_radix4_ifftSPxSP(	Uint32	n,	float	*pIn,	float	*pTwiddle,	float	*pOut,	Uint32	log4NMinus1,	float	scale	);
+Uint32	vlfftBatchStages(	Uint32	n,	Uint32	maxRadix	);
+Bool	vlfftBatchStagesValid(	Uint32	n,	Uint32	stages	);
+void	vlfftBatchFFTStages(	Uint32	n,	Uint32	numFFTs,	float	*x,	const	float	*pTwiddle,	Uint32	direction,	Uint32	stages	);
+void	vlfftBatchFFTStagesTw(	Uint32	n,	Uint32	numFFTs,	float	*x,	const	float	*pTwiddle,	Uint32	direction,	Uint32	stages,	const	float	*pWStep,	float	*pOut,	Uint32	fftStride,	Uint32	outStride	);
+void	vlfftBatchFFT(	Uint32	n,	Uint32	numFFTs,	float	*x,	const	float	*pTwiddle,	Uint32	direction	);
+void	vlfftBatchFFTRows(	Uint32	n,	Uint32	numFFTs,	const	float	*x,	float	*pOut,	float	scale	);
+void	vlfftBatchFFTColumn(	Uint32	n,	Uint32	numFFTs,	const	float	*x,	Uint32	fftIdx,	Bool	bitReversed,	float	*pOut	);
+void	vlfftBatchMixedFFT(	Uint32	n,	Uint32	numFFTs,	float	*x,	float	*pOut,	const	float	*pTwiddle,	Uint32	direction,	float	scale	);
 
 void	transpose_1(	float	*pIn,	float	*pOut,	Int32	rows,	Int32	cols	);
 void	transpose_2(	float	*pIn,	float	*pOut,	Int32	rows,	Int32	cols	);
+void	vlfftColumnFFT(	Uint32	n,	Uint32	radix,	Uint32	log4N,	Uint32	direction,	float	scale,	float	*pW,	float	*pIn,	float	*pOut	);
 void	transpose_2Cols_rowsX8_cplxMatrix_sa	(	float	*pIn,	float	*pOut,	Uint32	rows	);
 void	transpose_2Rows_8XCols_cplxMatrix_sa	(	float	*pIn,	float	*pOut,	Uint32	cols	);
 
 void	vlfftParamsInit(VLFFTparams_t	*VLFFTparams,	float	*pW1,	float	*pW2,	float	*pTwiddle,	Uint32	coreNum	);
+void	vlfftParamsConfigInit(VLFFTparams_t	*VLFFTparams,	const	VLFFTconfig_t	*VLFFTconfig,	float	*pW1,	float	*pW2,	float	*pTwiddle,	float	*pTwiddleTable,	Uint32	coreNum	);
+Uint32	vlfftTwiddleTableSize(	const	VLFFTconfig_t	*VLFFTconfig	);
+void	vlfftConfigDefault(	VLFFTconfig_t	*VLFFTconfig	);
+Int32	vlfftConfigSelect(	VLFFTconfig_t	*VLFFTconfig,	Uint32	N,	Uint32	numCores	);
+Int32	vlfftConfigSelect2D(	VLFFTconfig_t	*VLFFTconfig,	Uint32	N1,	Uint32	N2,	Uint32	numCores,	Uint32	transform	);
+Int32	vlfftConfigFactor(	VLFFTconfig_t	*VLFFTconfig,	Uint32	N,	Uint32	numCores,	Uint32	N1,
+                         Uint32	radix_1stIter,	Uint32	radix_2ndIter,	Uint32	samplesPerBlock	);
+Int32	vlfftReferenceFFT(	Uint32	N,	const	float	*pIn,	Uint32	direction,	double	scale,	double	*pWork	);
+void	vlfftCompareReference(	Uint32	N,	const	float	*pOut,	const	double	*pRef,	vlfftErrorStats_t	*pStats	);
+double	vlfftEnergyCheck(	Uint32	N,	const	float	*pIn,	const	float	*pOut,	double	scale	);
+void	vlfftBarrierInit(	vlfftBarrier_t	*barrier,	Uint32	numCores	);
+void	vlfftBarrierWait(	vlfftBarrier_t	*barrier,	Uint32	coreNum,	Uint32	*pSense	);
+#ifdef	VLFFT_HOST
+Int32	vlfftWisdomLookup(	VLFFTconfig_t	*VLFFTconfig,	Uint32	N,	Uint32	numCores	);
+#endif
 void	vlfftBuffersInit(	VLFFTbuffers_t	*VLFFTbuffers,
                         float						*pInBufInternal,
                         float						*pOutBufInternal,
@@ -276,6 +406,7 @@ void	vlfftBuffersInit(	VLFFTbuffers_t	*VLFFTbuffers,
                         float						*pfftInBuf,
                         float						*pfftOutBuf
                      );
+#ifndef	VLFFT_HOST
 void	DMAparamInit(	DMAparams_t	*DMAparams,	VLFFTparams_t	*VLFFTparams,	Uint32	coreNum	);
 void	dmaConfigVLFFT_1stIter(	DMAparams_t	*DMAparams,	VLFFTparams_t	*VLFFTparams	);
 void	dmaConfigVLFFT_2ndIter(	DMAparams_t	*DMAparams,	VLFFTparams_t	*VLFFTparams	);
@@ -301,8 +432,10 @@ void	broadcastMessagesToActiveCores(	vlfftMessageQParams_t	*messageQParams,	cons
 void	broadcastMessagesToAllCores(	vlfftMessageQParams_t	*messageQParams,	const	UInt32	maxNumCores,	const	UInt32	numCoresForFftCompute,	const	vlfftMode	cmd	);
 Int32	getAllMessages(	vlfftMessageQParams_t	*messageQParams,	const	UInt32	maxNumCores,	const	UInt32	numCoresForFftCompute	);
 void	initMessageQueues(	vlfftMessageQParams_t	*messageQParams,	const	UInt32	maxNumCores	);
+#endif	//	VLFFT_HOST
 
-void	tw_gen	(float	*w,	int	n);
+void	tw_gen	(float	*w,	int	n,	int	direction);
+void	genTwiddleMixed	(float	*w,	int	n,	int	direction);
 
 
 
@@ -50,10 +50,12 @@ typedef enum vlfftMode {
 } vlfftMode;
 
 
+#ifndef VLFFT_HOST
 typedef struct vlfftMessageQ_Msg {
 	MessageQ_MsgHeader header;
 	vlfftMode          mode;
-	Int32              fill[7];
+	Uint32             numFFTs;     // VLFFT_PROCESS_1stITER: FFTs to run
+	Int32              fill[6];
 } vlfftMessageQ_Msg;
 
 
@@ -86,4 +88,5 @@ typedef struct {
 
 	MessageQ_QueueId remoteQueueIdCore[8];
 } vlfftMessageQParams_t;
+#endif  // VLFFT_HOST
 
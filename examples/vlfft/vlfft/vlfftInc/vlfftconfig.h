@@ -67,6 +67,15 @@
 #define VLFFT_1024K 1
 
 
+//////////////////////////////////////////////
+// 4) Select the direction, VLFFT_FORWARD or
+//    VLFFT_INVERSE; the inverse is scaled by
+//    1/N when VLFFT_SCALE_INVERSE is 1
+//////////////////////////////////////////////
+#define VLFFT_DIRECTION       VLFFT_FORWARD
+#define VLFFT_SCALE_INVERSE   1
+
+
 
 //////////////////////////////////////////////////////////////
 // STOP!  No need to change any of the following settings
@@ -74,11 +83,107 @@
 
 #define BYTES_PER_COMPLEX_SAMPLE   8
 
+#define VLFFT_FORWARD              0
+#define VLFFT_INVERSE              1
+
+// inter-pass twiddles W_N^(n2*k1): recurrence from W_N^n2 as in
+// multTwiddle_vec_1_sa, a full per-core table, or table anchors every
+// VLFFT_TWIDDLE_ANCHOR_STEP points with a short recurrence in between
+#define VLFFT_TWIDDLE_RECURSIVE    0
+#define VLFFT_TWIDDLE_TABLE        1
+#define VLFFT_TWIDDLE_HYBRID       2
+#define VLFFT_TWIDDLE_ANCHOR_STEP  16
+
+// blocks buffered per pass: the transfers of the next depth-1 blocks in
+// and of the previous block out run while a block is computed.  The DSP
+// ping-pongs (2); host plans can ask for up to VLFFT_MAX_BUFFER_DEPTH
+#define VLFFT_BUFFER_DEPTH         2
+#define VLFFT_MAX_BUFFER_DEPTH     8
+#if !defined(VLFFT_HOST) && VLFFT_BUFFER_DEPTH != 2
+#error "the DSP iterations ping-pong their buffers, VLFFT_BUFFER_DEPTH must be 2"
+#endif
+
+// out of place through the N2 x N1 intermediate, or in place: pass 1
+// writes back over the input columns, pass 2 over the rows, leaving
+// X[k1+N1*k2] at k1*N2+k2 (transposed) unless the host transposes it
+// to natural order afterwards
+#define VLFFT_OUT_OF_PLACE         0
+#define VLFFT_IN_PLACE             1
+#define VLFFT_IN_PLACE_NATURAL     2
+
+// samples of the out of place intermediate: complex float, or packed
+// IEEE half (scaled by 1/N1 on the way out so it cannot overflow) or
+// bfloat16 complex, BYTES_PER_PACKED_COMPLEX_SAMPLE each; host only
+#define VLFFT_INTERMEDIATE_FLOAT   0
+#define VLFFT_INTERMEDIATE_FP16    1
+#define VLFFT_INTERMEDIATE_BF16    2
+#define BYTES_PER_PACKED_COMPLEX_SAMPLE 4
+
+// blocks of a pass per core: a fixed 1/numCores share (numCores a power
+// of two, as on the DSP), or claimed one at a time from a counter shared
+// by the cores, which takes any core count and evens out slow cores;
+// host only
+#define VLFFT_SCHEDULE_STATIC      0
+#define VLFFT_SCHEDULE_DYNAMIC     1
+
+// what the passes compute: the N-point FFT, twiddles between them; the
+// N1 x N2 2D FFT of rows of N2 samples, laid out as in place without
+// the twiddles; or pass 1 alone, the N1-point FFTs down the N2 columns.
+// A 3D plan, N1 x N2 x N/(N1*N2), runs the columns, then a 2D plan
+// over its planes; host only
+#define VLFFT_TRANSFORM_1D         0
+#define VLFFT_TRANSFORM_2D         1
+#define VLFFT_TRANSFORM_3D         2
+#define VLFFT_TRANSFORM_COLUMNS    3
+
+// polls of the barrier between the passes before a host waiter sleeps,
+// none when there are more workers than CPUs
+#define VLFFT_BARRIER_SPINS        4000
+
+// vlfftReferenceFFT(): largest prime factor of N it takes, doubles of
+// pWork it needs (reference and twiddles), SNR reported for no error
+#define VLFFT_VALIDATE_MAX_RADIX   64
+#define VLFFT_REFERENCE_WORK_SIZE(N) (4*(size_t)(N))
+#define VLFFT_VALIDATE_EXACT_DB    999.0
+
+// radix_1stIter/_2ndIter of an N1 or N2 with factors 3, 5 or 7: the
+// FFTs of a block go through vlfftBatchMixedFFT(), Stockham passes of
+// radix 4, 2, 3, 5 and 7 (the largest), twiddles W_n^j for j < n
+#define VLFFT_RADIX_MIXED          7
+#define VLFFT_BATCH_MAX_RADIX      7
+#define VLFFT_BATCH_MAX_PASSES     32
+
+// DSP iterations of radix 2 and 4 sizes: the DSPLIB kernels one column
+// at a time between transposes (0), or vlfftBatchFFT() on the
+// block in place (1).  The host always runs the batched kernel; on the
+// DSP it stays off until it has been built and timed on the EVM
+#define VLFFT_DSP_BATCH_FFT        0
+
+// vlfftBatchFFT() stages: radix 2, 4, 8 or 16, VLFFT_BATCH_STAGE_BITS
+// each in a packed sequence of up to VLFFT_BATCH_MAX_STAGES, by default
+// as few as radices up to VLFFT_BATCH_STAGE_RADIX allow (1024 points in
+// 8x8x4x4, 16x16x4 with 16).  Radix 16 makes half the passes of radix 4
+// over a block but its 16 rows, a power of 2 apart, compete for the same
+// L1 sets once the rows are long; the tuner times the 4, 8 and 16
+// sequences and keeps the fastest in the wisdom file
+#define VLFFT_BATCH_STAGE_RADIX    8
+#define VLFFT_BATCH_STAGE_BITS     2
+#define VLFFT_BATCH_MAX_STAGES     16
+
 #define SAMPLES_PER_TRANSFER_BLOCK 8
 #define LOG2_SAMPLES_PER_TRANSFER_BLOCK 3
 #define NUM_FFTS_PER_BLOCK         8
 #define LOG2_NUM_FFTS_PER_BLOCK    3
 
+// sizes accepted by vlfftConfigSelect(): 64 .. 256M points with no
+// prime factor above VLFFT_BATCH_MAX_RADIX, byte offsets into the
+// external buffers must fit in 32 bits
+#define VLFFT_MIN_LOG2_SIZE        6
+#define VLFFT_MAX_LOG2_SIZE        28
+// smallest N1 or N2, largest block vlfftConfigFactor() allows
+#define VLFFT_MIN_LOG2_FFT_SIZE    3
+#define VLFFT_MAX_SAMPLES_PER_BLOCK 32
+
 
 
 #if EIGHT_CORE_DEVICE
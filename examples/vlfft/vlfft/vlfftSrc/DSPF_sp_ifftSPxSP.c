@@ -0,0 +1,162 @@
+/*
+ * DSPF_sp_radix4_ifftSPxSP()
+ * DSPF_sp_mixedRadix_ifftSPxSP()
+ *
+ *    Inverse counterparts of the radix-4 and mixed radix FFT kernels.
+ *    They take the conjugated table from tw_gen( w, n, VLFFT_INVERSE ),
+ *    so the data is never conjugated, and scale the result while it is
+ *    written out in natural order
+ *
+ *
+ * Copyright (C) {2011} Texas Instruments Incorporated - http://www.ti.com/
+ *
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *    Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ *    Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the
+ *    distribution.
+ *
+ *    Neither the name of Texas Instruments Incorporated nor the names of
+ *    its contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ *  A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ *  OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *  SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *  LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ *  DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ *  THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ *  (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ *  OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+*/
+
+
+#ifndef VLFFT_HOST
+#include <xdc/std.h>
+#endif
+
+/* vlfft.h */
+#include "../vlfftInc/vlfftDebug.h"
+#include "../vlfftInc/vlfftMessgQ.h"
+#include "../vlfftInc/vlfft.h"
+#include "../vlfftInc/vlfftconfig.h"
+
+
+/****************************************************************/
+/*  radix-4 decimation-in-frequency stages with W^-k twiddles   */
+/*  and +j butterflies, computed in place; outputs go to slot   */
+/*  order 0,2,1,3 so the result is in bit-reversed order.       */
+/*  Returns the size of the sub-FFTs left over, 2 or 1.         */
+/****************************************************************/
+static Uint32 radix4InvStages( Uint32 n, float *x, const float *w ) {
+	Uint32 stride, quarter, group, i;
+	float  *x0, *x1, *x2, *x3;
+	float  t0Re, t0Im, t1Re, t1Im, t2Re, t2Im, t3Re, t3Im;
+	float  yRe, yIm;
+
+	for( stride=n; stride>=4; stride>>=2 ) {
+		quarter = stride>>2;
+		for( group=0; group<n; group+=stride ) {
+			for( i=0; i<quarter; i++ ) {
+				x0 = &x[2*(group+i)];
+				x1 = x0 + 2*quarter;
+				x2 = x1 + 2*quarter;
+				x3 = x2 + 2*quarter;
+
+				t0Re = x0[1] + x2[1];   t0Im = x0[0] + x2[0];
+				t1Re = x0[1] - x2[1];   t1Im = x0[0] - x2[0];
+				t2Re = x1[1] + x3[1];   t2Im = x1[0] + x3[0];
+				t3Re = x1[1] - x3[1];   t3Im = x1[0] - x3[0];
+
+				// y0 = t0 + t2
+				x0[1] = t0Re + t2Re;
+				x0[0] = t0Im + t2Im;
+
+				// y2 = (t0 - t2) * W^-2i   -> slot 1
+				yRe = t0Re - t2Re;
+				yIm = t0Im - t2Im;
+				x1[1] = yRe*w[6*i+3] - yIm*w[6*i+2];
+				x1[0] = yRe*w[6*i+2] + yIm*w[6*i+3];
+
+				// y1 = (t1 + j*t3) * W^-i  -> slot 2
+				yRe = t1Re - t3Im;
+				yIm = t1Im + t3Re;
+				x2[1] = yRe*w[6*i+1] - yIm*w[6*i  ];
+				x2[0] = yRe*w[6*i  ] + yIm*w[6*i+1];
+
+				// y3 = (t1 - j*t3) * W^-3i -> slot 3
+				yRe = t1Re + t3Im;
+				yIm = t1Im - t3Re;
+				x3[1] = yRe*w[6*i+5] - yIm*w[6*i+4];
+				x3[0] = yRe*w[6*i+4] + yIm*w[6*i+5];
+			}
+		}
+		w += 6*quarter;
+	}
+	return stride;
+}
+
+
+static void radix2Stage( Uint32 n, float *x ) {
+	Uint32 i;
+	float  aRe, aIm, bRe, bIm;
+
+	for( i=0; i<n; i+=2 ) {
+		aRe = x[2*i+1];   aIm = x[2*i  ];
+		bRe = x[2*i+3];   bIm = x[2*i+2];
+		x[2*i+1] = aRe + bRe;
+		x[2*i  ] = aIm + bIm;
+		x[2*i+3] = aRe - bRe;
+		x[2*i+2] = aIm - bIm;
+	}
+}
+
+
+static void bitReverseScale( Uint32 n, float *pIn, float *pOut, float scale ) {
+	Uint32 i, j, k, numBits;
+
+	for( numBits=0; (1U<<numBits)<n; numBits++ );
+
+	for( i=0; i<n; i++ ) {
+		j = 0;
+		for( k=0; k<numBits; k++ )
+			j |= ((i>>k)&0x1) << (numBits-1-k);
+		pOut[2*j  ] = pIn[2*i  ]*scale;
+		pOut[2*j+1] = pIn[2*i+1]*scale;
+	}
+}
+
+
+/*********************************************************/
+/*  n = 4^k.  pIn is used as scratch and is overwritten. */
+/*  log4NMinus1 is kept for the same interface as the    */
+/*  forward kernel.                                      */
+/*********************************************************/
+void DSPF_sp_radix4_ifftSPxSP( Uint32 n, float *pIn, float *pTwiddle, float *pOut, Uint32 log4NMinus1, float scale ) {
+	(void)log4NMinus1;
+
+	radix4InvStages( n, pIn, pTwiddle );
+	bitReverseScale( n, pIn, pOut, scale );
+}
+
+
+/*********************************************************/
+/*  n = 2*4^k or 4^k: radix-4 stages and, when needed,   */
+/*  one radix-2 stage.  pIn is overwritten.              */
+/*********************************************************/
+void DSPF_sp_mixedRadix_ifftSPxSP( Uint32 n, float *pIn, float *pTwiddle, float *pOut, float scale ) {
+	if( radix4InvStages( n, pIn, pTwiddle ) == 2 )
+		radix2Stage( n, pIn );
+	bitReverseScale( n, pIn, pOut, scale );
+}
@@ -1,7 +1,8 @@
 /*
  * tw_gen()
+ * genTwiddleMixed()
  *
- *    Generate twiddle for FFT computation
+ *    Generate twiddle for FFT computation, conjugated for the inverse
  *
  * Copyright (C) {2011} Texas Instruments Incorporated - http://www.ti.com/
  *
@@ -43,29 +44,34 @@
 #include <limits.h>
 #include <math.h>
 
+/*  vlfft local define */
+#include "../vlfftInc/vlfftDebug.h"
+#include "../vlfftInc/vlfftconfig.h"
 
-void tw_gen (float *w, int n) {
+
+void tw_gen (float *w, int n, int direction) {
 	int i, j, k;
 	double x_t, y_t, theta1, theta2, theta3;
 	const double PI = 3.141592654;
+	const double sign = (direction == VLFFT_INVERSE) ? -1.0 : 1.0;
 
 	for (j = 1, k = 0; j <= n >> 2; j = j << 2) {
 		for (i = 0; i < n >> 2; i += j) {
 			theta1 = 2 * PI * i / n;
 			y_t = cos (theta1);
-			x_t =-sin (theta1);
+			x_t =-sign*sin (theta1);
 			w[k] = (float) x_t;
 			w[k + 1] = (float) y_t;
 
 			theta2 = 4 * PI * i / n;
 			y_t = cos (theta2);
-			x_t =-sin (theta2);
+			x_t =-sign*sin (theta2);
 			w[k + 2] = (float) x_t;
 			w[k + 3] = (float) y_t;
 
 			theta3 = 6 * PI * i / n;
 			y_t = cos (theta3);
-			x_t =-sin (theta3);
+			x_t =-sign*sin (theta3);
 			w[k + 4] = (float) x_t;
 			w[k + 5] = (float) y_t;
 			k += 6;
@@ -73,3 +79,18 @@ void tw_gen (float *w, int n) {
 	}
 }
 
+
+/* W_n^j, j = 0 .. n-1, for vlfftBatchMixedFFT(), stored like the */
+/* samples, imag first                                           */
+void genTwiddleMixed (float *w, int n, int direction) {
+	int j;
+	double theta;
+	const double PI = 3.141592654;
+	const double sign = (direction == VLFFT_INVERSE) ? -1.0 : 1.0;
+
+	for (j = 0; j < n; j++) {
+		theta = 2 * PI * j / n;
+		w[2 * j] = (float) (-sign * sin (theta));
+		w[2 * j + 1] = (float) cos (theta);
+	}
+}
@@ -94,20 +94,47 @@ void multTwiddle_vec_1(float *pInTwiddle, float wStepRe, float wStepIm, int fftS
 
 
 
-void genTwiddle(float *pTwiddle, int numFFTsPerCore, int coreNum) {
-	int  n2, n2_start, n;
+void genTwiddle(float *pTwiddle, int n, int numFFTsPerCore, int coreNum, int direction) {
+	int  n2, n2_start;
 
 	double theta;
 	const double PI = 3.141592654;
+	const double sign = (direction == VLFFT_INVERSE) ? -1.0 : 1.0;
 
 	n2_start = numFFTsPerCore*coreNum;
-	n = VLFFT_SIZE;
 
 	for(n2=n2_start; n2<n2_start+numFFTsPerCore; n2++) {
 		theta = 2 * PI * n2 / n;
 		pTwiddle[2*(n2-n2_start)  ] = ((float)  cos (theta)  );
-		pTwiddle[2*(n2-n2_start)+1] = ((float)(-sin (theta)) );
+		pTwiddle[2*(n2-n2_start)+1] = ((float)(-sign*sin (theta)) );
 	}
 
 }
 
+
+/*  anchors W_n^(n2*k1) for k1 = 0, anchorStep, 2*anchorStep .. < n1, */
+/*  per FFT of this core in the order the blocks are processed;       */
+/*  n2*k1 is reduced mod n first so the angle is exact; stored like   */
+/*  the samples, imag first                                           */
+void genTwiddleTable(float *pTable, int n, int n1, int numFFTsPerCore, int coreNum, int anchorStep, int direction) {
+	int  n2, n2_start, k1, idx;
+	unsigned long long nk;
+
+	double theta;
+	const double PI = 3.141592654;
+	const double sign = (direction == VLFFT_INVERSE) ? -1.0 : 1.0;
+
+	n2_start = numFFTsPerCore*coreNum;
+	idx = 0;
+
+	for(n2=n2_start; n2<n2_start+numFFTsPerCore; n2++) {
+		for(k1=0; k1<n1; k1+=anchorStep) {
+			nk = ((unsigned long long)n2*k1) % (unsigned long long)n;
+			theta = 2 * PI * (double)nk / n;
+			pTable[2*idx  ] = ((float)(-sign*sin (theta)) );
+			pTable[2*idx+1] = ((float)  cos (theta)  );
+			idx++;
+		}
+	}
+
+}
@@ -0,0 +1,183 @@
+/*
+ * vlfftBarrierInit()
+ * vlfftBarrierWait()
+ *
+ *    Sense reversing barrier in shared memory between the cores of an FFT,
+ *    the hand-off between the 1st and the 2nd iteration.  On the DSP it
+ *    sits in MSMC and every core sets a flag of its own, which core 0
+ *    gathers before it flips the sense; on the host the cores count
+ *    themselves in atomically and the last one flips it
+ *
+ * Copyright (C) {2011} Texas Instruments Incorporated - http://www.ti.com/
+ *
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *    Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ *    Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the
+ *    distribution.
+ *
+ *    Neither the name of Texas Instruments Incorporated nor the names of
+ *    its contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ *  A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ *  OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *  SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *  LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ *  DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ *  THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ *  (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ *  OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+*/
+
+
+#include <string.h>
+
+#ifndef VLFFT_HOST
+#include <xdc/std.h>
+
+/*  ----------------------------------- IPC module Headers           */
+#include <ti/ipc/MessageQ.h>
+
+/*  ----------------------------------- BIOS6 module Headers         */
+#include <ti/sysbios/hal/Cache.h>
+#else
+#include <limits.h>
+#include <unistd.h>
+#include <sys/syscall.h>
+#include <linux/futex.h>
+
+#include "../vlfftHost/vlfftHostStd.h"
+#endif
+
+/* vlfft.h */
+#include "../vlfftInc/vlfftDebug.h"
+#include "../vlfftInc/vlfftMessgQ.h"
+#include "../vlfftInc/vlfft.h"
+#include "../vlfftInc/vlfftconfig.h"
+
+
+#ifndef VLFFT_HOST
+/****************************************************************/
+/*    MSMC is cached in L1D and the C66x has no atomic add on   */
+/*    it, so each core writes back its own arrival flag and     */
+/*    invalidates the lines it polls                            */
+/****************************************************************/
+static void flagWrite( vlfftBarrierFlag_t *flag, Uint32 value ) {
+	flag->value = value;
+	Cache_wb( (Ptr)flag, sizeof(*flag), Cache_Type_ALLD, TRUE );
+}
+
+static void flagWaitFor( vlfftBarrierFlag_t *flag, Uint32 value ) {
+	do {
+		Cache_inv( (Ptr)flag, sizeof(*flag), Cache_Type_ALLD, TRUE );
+	} while( flag->value != value );
+}
+
+
+/****************************************************************/
+/*    called by core 0 before the cores are started             */
+/****************************************************************/
+void vlfftBarrierInit( vlfftBarrier_t *barrier, Uint32 numCores ) {
+	memset( barrier, 0, sizeof(*barrier) );
+	barrier->numCores = numCores;
+	Cache_wb( (Ptr)barrier, sizeof(*barrier), Cache_Type_ALLD, TRUE );
+}
+
+
+/****************************************************************/
+/*    *pSense is the core's own, 0 before its first wait        */
+/****************************************************************/
+void vlfftBarrierWait( vlfftBarrier_t *barrier, Uint32 coreNum, Uint32 *pSense ) {
+	Uint32 sense, indexCore;
+
+	sense   = *pSense ^ 0x1;
+	*pSense = sense;
+
+	if( coreNum == 0 ) {
+		for( indexCore=1; indexCore<barrier->numCores; indexCore++ )
+			flagWaitFor( &barrier->arrive[indexCore], sense );
+		flagWrite( &barrier->sense, sense );
+	} else {
+		flagWrite( &barrier->arrive[coreNum], sense );
+		flagWaitFor( &barrier->sense, sense );
+	}
+}
+
+#else
+/****************************************************************/
+/*    a waiter polls VLFFT_BARRIER_SPINS times, then sleeps on  */
+/*    the sense word; there is no point in spinning when there  */
+/*    are more threads than CPUs to run them                    */
+/****************************************************************/
+static void cpuRelax( void ) {
+#if defined(__x86_64__) || defined(__i386__)
+	__builtin_ia32_pause();
+#endif
+}
+
+static void futexWait( volatile Uint32 *p, Uint32 value ) {
+	syscall( SYS_futex, p, FUTEX_WAIT_PRIVATE, value, NULL, NULL, 0 );
+}
+
+static void futexWakeAll( volatile Uint32 *p ) {
+	syscall( SYS_futex, p, FUTEX_WAKE_PRIVATE, INT_MAX, NULL, NULL, 0 );
+}
+
+
+void vlfftBarrierInit( vlfftBarrier_t *barrier, Uint32 numCores ) {
+	long numCpus;
+
+	memset( barrier, 0, sizeof(*barrier) );
+	barrier->numCores = numCores;
+
+	numCpus = sysconf( _SC_NPROCESSORS_ONLN );
+	barrier->spins = numCpus >= (long)numCores ? VLFFT_BARRIER_SPINS : 0;
+}
+
+
+/****************************************************************/
+/*    the last core in resets the count before it flips the     */
+/*    sense, nobody can count in again before that.  Sense and  */
+/*    numSleepers are stored and loaded sequentially consistent */
+/*    on both sides, so either the waker sees the sleeper or    */
+/*    the sleeper's futexWait() sees the new sense              */
+/****************************************************************/
+void vlfftBarrierWait( vlfftBarrier_t *barrier, Uint32 coreNum, Uint32 *pSense ) {
+	Uint32 sense, spin;
+
+	(void)coreNum;
+	sense   = *pSense ^ 0x1;
+	*pSense = sense;
+
+	if( __atomic_add_fetch( &barrier->count.value, 1, __ATOMIC_ACQ_REL ) == barrier->numCores ) {
+		__atomic_store_n( &barrier->count.value, 0, __ATOMIC_RELAXED );
+		__atomic_store_n( &barrier->sense.value, sense, __ATOMIC_SEQ_CST );
+		if( __atomic_load_n( &barrier->numSleepers.value, __ATOMIC_SEQ_CST ) != 0 )
+			futexWakeAll( &barrier->sense.value );
+		return;
+	}
+
+	for( spin=0; spin<barrier->spins; spin++ ) {
+		if( __atomic_load_n( &barrier->sense.value, __ATOMIC_ACQUIRE ) == sense )
+			return;
+		cpuRelax();
+	}
+
+	__atomic_add_fetch( &barrier->numSleepers.value, 1, __ATOMIC_SEQ_CST );
+	while( __atomic_load_n( &barrier->sense.value, __ATOMIC_SEQ_CST ) != sense )
+		futexWait( &barrier->sense.value, sense ^ 0x1 );
+	__atomic_sub_fetch( &barrier->numSleepers.value, 1, __ATOMIC_RELAXED );
+}
+#endif  // VLFFT_HOST
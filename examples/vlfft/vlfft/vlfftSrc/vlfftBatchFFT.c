@@ -0,0 +1,862 @@
+/*
+ * vlfftBatchStages()
+ * vlfftBatchStagesValid()
+ * vlfftBatchFFTStages()
+ * vlfftBatchFFTStagesTw()
+ * vlfftBatchFFT()
+ * vlfftBatchFFTRows()
+ * vlfftBatchFFTColumn()
+ * vlfftBatchMixedFFT()
+ *
+ *    numFFTs FFTs of the same size computed together, laid out as the
+ *    blocks come in: sample i of FFT b at complex index i*numFFTs+b, so the
+ *    innermost loop of every butterfly runs across the FFTs, in AVX or SSE2
+ *    vectors on the host, and each twiddle is loaded once per butterfly
+ *    for all of them.  Replaces the per column DSPF_sp_*fftSPxSP() calls
+ *    and the transposes around them in both iterations.
+ *    Power of 2 sizes go through radix 16, 8, 4 and 2 stages, each a
+ *    butterfly held in registers, in a sequence vlfftBatchStages() plans
+ *    and the tuner can time; radix 16 takes half the passes over the
+ *    block that radix 4 does; vlfftBatchFFTStagesTw() takes the twiddle
+ *    multiply of the 1st iteration into the last of them.
+ *    vlfftBatchMixedFFT() takes the sizes with factors 3, 5 and 7 the same
+ *    way, in radix 4, 2, 3, 5 and 7 Stockham passes between two buffers
+ *
+ * Copyright (C) {2011} Texas Instruments Incorporated - http://www.ti.com/
+ *
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *    Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ *    Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the
+ *    distribution.
+ *
+ *    Neither the name of Texas Instruments Incorporated nor the names of
+ *    its contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ *  A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ *  OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *  SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *  LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ *  DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ *  THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ *  (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ *  OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+*/
+
+
+#include <stddef.h>
+#include <string.h>
+#include <math.h>
+#if defined(VLFFT_HOST) && (defined(__AVX__) || defined(__SSE2__))
+#include <immintrin.h>
+#endif
+
+#ifndef VLFFT_HOST
+#include <xdc/std.h>
+
+/*  ----------------------------------- IPC module Headers           */
+#include <ti/ipc/MessageQ.h>
+#else
+#include "../vlfftHost/vlfftHostStd.h"
+#endif
+
+/* vlfft.h */
+#include "../vlfftInc/vlfftDebug.h"
+#include "../vlfftInc/vlfftMessgQ.h"
+#include "../vlfftInc/vlfft.h"
+#include "../vlfftInc/vlfftconfig.h"
+
+
+static Uint32 bitReverse( Uint32 i, Uint32 numBits ) {
+	Uint32 r = 0;
+
+	while( numBits-- ) {
+		r = (r<<1) | (i&0x1);
+		i >>= 1;
+	}
+	return r;
+}
+
+
+static Uint32 log2Size( Uint32 n ) {
+	Uint32 numBits;
+
+	for( numBits=0; (1U<<numBits)<n; numBits++ );
+	return numBits;
+}
+
+
+/****************************************************************/
+/*  batchVec_t: BATCH_VEC_FLOATS floats of a row, the [im, re]  */
+/*  samples of consecutive FFTs: 4 of them with AVX, 2 with     */
+/*  SSE2 and 1 on the DSP, where the compiler schedules the     */
+/*  scalar code.  vecSwap() swaps im and re of every sample,    */
+/*  vecPair() repeats one [im, re] pair across the vector       */
+/****************************************************************/
+#if defined(VLFFT_HOST) && defined(__AVX__)
+typedef __m256 batchVec_t;
+#define BATCH_VEC_FLOATS	8
+
+static inline batchVec_t vecLoad( const float *p )             { return _mm256_loadu_ps( p ); }
+static inline void       vecStore( float *p, batchVec_t a )    { _mm256_storeu_ps( p, a ); }
+static inline batchVec_t vecAdd( batchVec_t a, batchVec_t b ) { return _mm256_add_ps( a, b ); }
+static inline batchVec_t vecSub( batchVec_t a, batchVec_t b ) { return _mm256_sub_ps( a, b ); }
+static inline batchVec_t vecMul( batchVec_t a, batchVec_t b ) { return _mm256_mul_ps( a, b ); }
+static inline batchVec_t vecSwap( batchVec_t a )               { return _mm256_permute_ps( a, 0xB1 ); }
+static inline batchVec_t vecPair( float im, float re )         { return _mm256_setr_ps( im, re, im, re, im, re, im, re ); }
+#elif defined(VLFFT_HOST) && defined(__SSE2__)
+typedef __m128 batchVec_t;
+#define BATCH_VEC_FLOATS	4
+
+static inline batchVec_t vecLoad( const float *p )             { return _mm_loadu_ps( p ); }
+static inline void       vecStore( float *p, batchVec_t a )    { _mm_storeu_ps( p, a ); }
+static inline batchVec_t vecAdd( batchVec_t a, batchVec_t b ) { return _mm_add_ps( a, b ); }
+static inline batchVec_t vecSub( batchVec_t a, batchVec_t b ) { return _mm_sub_ps( a, b ); }
+static inline batchVec_t vecMul( batchVec_t a, batchVec_t b ) { return _mm_mul_ps( a, b ); }
+static inline batchVec_t vecSwap( batchVec_t a )               { return _mm_shuffle_ps( a, a, _MM_SHUFFLE( 2, 3, 0, 1 ) ); }
+static inline batchVec_t vecPair( float im, float re )         { return _mm_setr_ps( im, re, im, re ); }
+#else
+typedef struct {
+	float im, re;
+} batchVec_t;
+#define BATCH_VEC_FLOATS	2
+
+static inline batchVec_t vecLoad( const float *p )             { batchVec_t a; a.im = p[0]; a.re = p[1]; return a; }
+static inline void       vecStore( float *p, batchVec_t a )    { p[0] = a.im; p[1] = a.re; }
+static inline batchVec_t vecAdd( batchVec_t a, batchVec_t b ) { a.im += b.im; a.re += b.re; return a; }
+static inline batchVec_t vecSub( batchVec_t a, batchVec_t b ) { a.im -= b.im; a.re -= b.re; return a; }
+static inline batchVec_t vecMul( batchVec_t a, batchVec_t b ) { a.im *= b.im; a.re *= b.re; return a; }
+static inline batchVec_t vecSwap( batchVec_t a )               { batchVec_t s; s.im = a.re; s.re = a.im; return s; }
+static inline batchVec_t vecPair( float im, float re )         { batchVec_t a; a.im = im; a.re = re; return a; }
+#endif
+
+/* the loops over a butterfly's R rows unrolled, which keeps them in registers */
+#if defined(__GNUC__)
+#define BATCH_UNROLL	_Pragma( "GCC unroll 16" )
+#else
+#define BATCH_UNROLL
+#endif
+
+/* a twiddle w ready for vecCmul(): [wRe, wRe] and [wIm, -wIm] */
+typedef struct {
+	batchVec_t re, im;
+} batchTw_t;
+
+/* a*w = a*wRe + swap(a)*[wIm, -wIm] */
+static inline batchVec_t vecCmul( batchVec_t a, const batchTw_t *w ) {
+	return vecAdd( vecMul( a, w->re ), vecMul( vecSwap( a ), w->im ) );
+}
+
+
+/****************************************************************/
+/*  W_n^e, e < n, from the first stage's block of a radix-4     */
+/*  twiddle table (pTwiddle of vlfftBatchFFT()), which holds    */
+/*  W_n^r for r < n/4 at 6*r: W_n^e is W_n^r turned e/(n/4)     */
+/*  quarters, by -j (+j inverse, sgn -1) each.  n a power of 2  */
+/****************************************************************/
+static inline void batchTwiddle( const float *pTwiddle, Uint32 log2N, Uint32 e, float sgn, batchTw_t *w ) {
+	Uint32 r, q;
+	float  wRe, wIm, t;
+
+	r   = e & ((1U<<(log2N-2))-1);
+	q   = e >> (log2N-2);
+	wIm = pTwiddle[6*r  ];
+	wRe = pTwiddle[6*r+1];
+	t   = q&0x1 ? sgn*wIm : wRe;
+	wIm = q&0x1 ? -sgn*wRe : wIm;
+	wRe = q&0x2 ? -t : t;
+	wIm = q&0x2 ? -wIm : wIm;
+	w->re = vecPair( wRe, wRe );
+	w->im = vecPair( wIm, -wIm );
+}
+
+
+/****************************************************************/
+/*  radix-R decimation in frequency on v[0] .. v[R-1], R = 2,   */
+/*  4, 8 or 16, as log2(R) radix-2 levels in registers: the     */
+/*  level of span L takes the pairs t, t+L/2 of each group of   */
+/*  L and multiplies their difference by W_L^t, wInt[t*R/L],    */
+/*  or for the quarter turn swaps it and applies jSign.  Slot s */
+/*  ends up holding output bitrev(s) of the R, as the radix-4   */
+/*  DSPF_sp_radix4_fftSPxSP() butterfly leaves 0,2,1,3.  Called */
+/*  with R constant so that the loops unroll                    */
+/****************************************************************/
+static inline void batchDif( Uint32 R, batchVec_t *v, const batchTw_t *wInt, batchVec_t jSign ) {
+	Uint32     L, g, t;
+	batchVec_t d;
+
+	BATCH_UNROLL
+	for( L=R; L>=2; L>>=1 ) {
+		BATCH_UNROLL
+		for( g=0; g<R; g+=L ) {
+			BATCH_UNROLL
+			for( t=0; t<L/2; t++ ) {
+				d      = vecSub( v[g+t], v[g+t+L/2] );
+				v[g+t] = vecAdd( v[g+t], v[g+t+L/2] );
+				if( t == 0 )
+					v[g+t+L/2] = d;
+				else if( 4*t == L )
+					v[g+t+L/2] = vecMul( vecSwap( d ), jSign );
+				else
+					v[g+t+L/2] = vecCmul( d, &wInt[t*(R/L)] );
+			}
+		}
+	}
+}
+
+
+/* one vector of rows p, p + rowStep, .. through batchDif(), slot s times wExt[s] if twiddled */
+static inline void batchButterfly( Uint32 R, float *p, size_t rowStep, const batchTw_t *wInt, const batchTw_t *wExt,
+                                   Bool twiddled, batchVec_t jSign ) {
+	batchVec_t v[16];
+	Uint32     j;
+
+	BATCH_UNROLL
+	for( j=0; j<R; j++ )
+		v[j] = vecLoad( p + rowStep*j );
+	batchDif( R, v, wInt, jSign );
+
+	vecStore( p, v[0] );
+	if( twiddled ) {
+		BATCH_UNROLL
+		for( j=1; j<R; j++ )
+			vecStore( p + rowStep*j, vecCmul( v[j], &wExt[j] ) );
+	} else {
+		BATCH_UNROLL
+		for( j=1; j<R; j++ )
+			vecStore( p + rowStep*j, v[j] );
+	}
+}
+
+
+/****************************************************************/
+/*  one radix-R stage of an n-point decimation in frequency on  */
+/*  groups of S = R*m rows: rows group + i + j*m, j = 0 .. R-1, */
+/*  go through batchDif() and, for i > 0, slot s is multiplied  */
+/*  by W_S^(i*bitrev(s)).  The i are taken BATCH_STAGE_TWIDDLES */
+/*  twiddles at a time, looked up once for every group and      */
+/*  every FFT, the groups in memory order within that.  What is */
+/*  left of a row after whole vectors goes through the same     */
+/*  code in a zero padded copy, so that an FFT comes out the    */
+/*  same wherever it sits in the batch.  The twiddles are on    */
+/*  the stack, fewer on the DSP's                               */
+/****************************************************************/
+#ifdef VLFFT_HOST
+#define BATCH_STAGE_TWIDDLES	256
+#else
+#define BATCH_STAGE_TWIDDLES	64
+#endif
+
+static inline void batchStage( Uint32 R, Uint32 n, Uint32 S, size_t rowFloats, float *x, const float *pTwiddle,
+                               float sgn ) {
+	batchTw_t  wInt[8], wExt[BATCH_STAGE_TWIDDLES];
+	batchVec_t jSign;
+	float      tail[16*BATCH_VEC_FLOATS];
+	float      *p;
+	size_t     b, whole, rest;
+	Uint32     m, i, i0, i1, j, group, numBits, log2N;
+
+	m       = S/R;
+	numBits = log2Size( R );
+	log2N   = log2Size( n );
+	jSign   = vecPair( -sgn, sgn );
+	for( j=1; j<R/2; j++ )
+		if( 4*j != R )
+			batchTwiddle( pTwiddle, log2N, j*(n/R), sgn, &wInt[j] );
+
+	whole = rowFloats - rowFloats%BATCH_VEC_FLOATS;
+	rest  = rowFloats - whole;
+	memset( tail, 0, sizeof(tail) );
+
+	for( i0=0; i0<m; i0=i1 ) {
+		i1 = i0 + BATCH_STAGE_TWIDDLES/R < m ? i0 + BATCH_STAGE_TWIDDLES/R : m;
+		for( i=i0; i<i1; i++ )
+			for( j=1; j<R && i>0; j++ )
+				batchTwiddle( pTwiddle, log2N, i*bitReverse( j, numBits )*(n/S), sgn, &wExt[R*(i-i0)+j] );
+
+		for( group=0; group<n; group+=S ) {
+			for( i=i0; i<i1; i++ ) {
+				p = x + rowFloats*(group+i);
+				for( b=0; b<whole; b+=BATCH_VEC_FLOATS )
+					batchButterfly( R, p + b, rowFloats*m, wInt, &wExt[R*(i-i0)], i > 0, jSign );
+
+				if( rest ) {
+					for( j=0; j<R; j++ )
+						memcpy( &tail[BATCH_VEC_FLOATS*j], p + whole + rowFloats*m*j, rest*sizeof(float) );
+					batchButterfly( R, tail, BATCH_VEC_FLOATS, wInt, &wExt[R*(i-i0)], i > 0, jSign );
+					for( j=0; j<R; j++ )
+						memcpy( p + whole + rowFloats*m*j, &tail[BATCH_VEC_FLOATS*j], rest*sizeof(float) );
+				}
+			}
+		}
+	}
+}
+
+
+/****************************************************************/
+/*  the last stage, radix R on groups of R rows, with the       */
+/*  twiddle multiply of the 1st iteration in it instead of a    */
+/*  pass of its own: group g holds outputs k0 + t*n/R of every  */
+/*  FFT, k0 = bitrev(g), in slots bitrev(t), so taking the      */
+/*  groups in k0 order FFT b steps one recurrence w_b^k0 and    */
+/*  multiplies it by w_b^(t*n/R), both kept in double, and its  */
+/*  R outputs times those go straight to pOut.  The FFTs are    */
+/*  taken VLFFT_MAX_SAMPLES_PER_BLOCK at a time for the stack   */
+/****************************************************************/
+static inline void batchStageTw( Uint32 R, Uint32 n, Uint32 numFFTs, float *x, const float *pTwiddle, float sgn,
+                                 const float *pWStep, float *pOut, size_t fftStride, size_t outStride ) {
+	batchTw_t  wInt[8];
+	batchVec_t v[16], jSign;
+	float      buf[16*BATCH_VEC_FLOATS];
+	double     wK[2*VLFFT_MAX_SAMPLES_PER_BLOCK], wT[2*16*VLFFT_MAX_SAMPLES_PER_BLOCK];
+	double     re, im, tRe, *pT;
+	float      xRe, xIm, wRe, wIm;
+	float      *p;
+	size_t     rowFloats, b, b0, b1, l, floats, o;
+	Uint32     k0, j, t, numBits, log2N, slot[16];
+
+	rowFloats = 2*(size_t)numFFTs;
+	numBits   = log2Size( R );
+	log2N     = log2Size( n );
+	jSign     = vecPair( -sgn, sgn );
+	for( j=1; j<R/2; j++ )
+		if( 4*j != R )
+			batchTwiddle( pTwiddle, log2N, j*(n/R), sgn, &wInt[j] );
+	for( t=0; t<R; t++ )
+		slot[t] = bitReverse( t, numBits );
+	memset( buf, 0, sizeof(buf) );
+
+	for( b0=0; b0<numFFTs; b0=b1 ) {
+		b1 = b0 + VLFFT_MAX_SAMPLES_PER_BLOCK < numFFTs ? b0 + VLFFT_MAX_SAMPLES_PER_BLOCK : numFFTs;
+
+		/* w_b^(n/R) by squaring, then its R powers */
+		for( b=b0; b<b1; b++ ) {
+			re = pWStep[2*b  ];
+			im = pWStep[2*b+1];
+			for( j=numBits; j<log2N; j++ ) {
+				tRe = re*re - im*im;
+				im  = 2.0*re*im;
+				re  = tRe;
+			}
+			pT    = &wT[2*R*(b-b0)];
+			pT[0] = 1.0;
+			pT[1] = 0.0;
+			for( t=1; t<R; t++ ) {
+				pT[2*t  ] = pT[2*t-2]*re - pT[2*t-1]*im;
+				pT[2*t+1] = pT[2*t-2]*im + pT[2*t-1]*re;
+			}
+			wK[2*(b-b0)  ] = 1.0;
+			wK[2*(b-b0)+1] = 0.0;
+		}
+
+		for( k0=0; k0<n/R; k0++ ) {
+			p = x + rowFloats*R*bitReverse( k0, log2N-numBits );
+			for( b=2*b0; b<2*b1; b+=BATCH_VEC_FLOATS ) {
+				floats = 2*b1-b < BATCH_VEC_FLOATS ? 2*b1-b : BATCH_VEC_FLOATS;
+				BATCH_UNROLL
+				for( j=0; j<R; j++ ) {
+					if( floats == BATCH_VEC_FLOATS ) {
+						v[j] = vecLoad( p + b + rowFloats*j );
+					} else {
+						memcpy( &buf[BATCH_VEC_FLOATS*j], p + b + rowFloats*j, floats*sizeof(float) );
+						v[j] = vecLoad( &buf[BATCH_VEC_FLOATS*j] );
+					}
+				}
+				batchDif( R, v, wInt, jSign );
+				BATCH_UNROLL
+				for( j=0; j<R; j++ )
+					vecStore( &buf[BATCH_VEC_FLOATS*j], v[j] );
+
+				for( l=0; l<floats; l+=2 ) {
+					pT = &wT[2*R*((b+l)/2-b0)];
+					re = wK[2*((b+l)/2-b0)  ];
+					im = wK[2*((b+l)/2-b0)+1];
+					for( t=0; t<R; t++ ) {
+						xIm = buf[BATCH_VEC_FLOATS*slot[t]+l  ];
+						xRe = buf[BATCH_VEC_FLOATS*slot[t]+l+1];
+						wRe = (float)(re*pT[2*t  ] - im*pT[2*t+1]);
+						wIm = (float)(re*pT[2*t+1] + im*pT[2*t  ]);
+						o   = (b+l)/2*fftStride + (k0 + (size_t)t*(n/R))*outStride;
+						pOut[2*o+1] = xRe*wRe - xIm*wIm;
+						pOut[2*o  ] = xRe*wIm + xIm*wRe;
+					}
+				}
+			}
+
+			for( b=b0; b<b1; b++ ) {
+				re  = wK[2*(b-b0)  ];
+				im  = wK[2*(b-b0)+1];
+				wK[2*(b-b0)  ] = re*pWStep[2*b] - im*pWStep[2*b+1];
+				wK[2*(b-b0)+1] = re*pWStep[2*b+1] + im*pWStep[2*b];
+			}
+		}
+	}
+}
+
+
+/****************************************************************/
+/*  Stockham passes: x holds numFFTs interleaved FFTs of length */
+/*  L split into strides of s rows; row q+s*(p+r*m), m = L/P,   */
+/*  r = 0 .. P-1, goes through a radix-P DFT whose output k,    */
+/*  times W_L^(p*k), lands in row q+s*(P*p+k) of y.  The s rows  */
+/*  of a stride are contiguous, so every butterfly runs over    */
+/*  lanes = 2*s*numFFTs floats with its twiddles fixed.  After  */
+/*  the last pass the rows are in natural order.  xStep is the  */
+/*  distance of inputs r and r+1, lanes that of outputs k and   */
+/*  k+1; tw holds W_L^(p*k) for k = 1 .. P-1 at 2*k             */
+/****************************************************************/
+static void stockhamRadix2( size_t lanes, const float *restrict x, size_t xStep, float *restrict y, const float *tw ) {
+	size_t b;
+	float  aRe, aIm, bRe, bIm, w1Re, w1Im;
+
+	w1Im = tw[2];   w1Re = tw[3];
+
+	for( b=0; b<lanes; b+=2 ) {
+		aRe = x[b+1];         aIm = x[b];
+		bRe = x[xStep+b+1];   bIm = x[xStep+b];
+
+		y[b+1] = aRe + bRe;
+		y[b  ] = aIm + bIm;
+
+		aRe -= bRe;
+		aIm -= bIm;
+		y[lanes+b+1] = aRe*w1Re - aIm*w1Im;
+		y[lanes+b  ] = aRe*w1Im + aIm*w1Re;
+	}
+}
+
+
+/* with inverse the -j and +j outputs swap, as in the inverse kernels */
+static void stockhamRadix4( size_t lanes, const float *restrict x, size_t xStep, float *restrict y, const float *tw,
+                            Bool inverse ) {
+	size_t b;
+	float  w1Re, w1Im, w2Re, w2Im, w3Re, w3Im;
+	float  t0Re, t0Im, t1Re, t1Im, t2Re, t2Im, t3Re, t3Im;
+	float  yRe, yIm;
+
+	w1Im = tw[2];   w1Re = tw[3];
+	w2Im = tw[4];   w2Re = tw[5];
+	w3Im = tw[6];   w3Re = tw[7];
+
+	for( b=0; b<lanes; b+=2 ) {
+		t0Re = x[b+1] + x[2*xStep+b+1];         t0Im = x[b] + x[2*xStep+b];
+		t1Re = x[b+1] - x[2*xStep+b+1];         t1Im = x[b] - x[2*xStep+b];
+		t2Re = x[xStep+b+1] + x[3*xStep+b+1];   t2Im = x[xStep+b] + x[3*xStep+b];
+		t3Re = x[xStep+b+1] - x[3*xStep+b+1];   t3Im = x[xStep+b] - x[3*xStep+b];
+		if( inverse ) {
+			t3Re = -t3Re;
+			t3Im = -t3Im;
+		}
+
+		y[b+1] = t0Re + t2Re;
+		y[b  ] = t0Im + t2Im;
+
+		// (t1 - j*t3) * W
+		yRe = t1Re + t3Im;
+		yIm = t1Im - t3Re;
+		y[lanes+b+1] = yRe*w1Re - yIm*w1Im;
+		y[lanes+b  ] = yRe*w1Im + yIm*w1Re;
+
+		// (t0 - t2) * W^2
+		yRe = t0Re - t2Re;
+		yIm = t0Im - t2Im;
+		y[2*lanes+b+1] = yRe*w2Re - yIm*w2Im;
+		y[2*lanes+b  ] = yRe*w2Im + yIm*w2Re;
+
+		// (t1 + j*t3) * W^3
+		yRe = t1Re - t3Im;
+		yIm = t1Im + t3Re;
+		y[3*lanes+b+1] = yRe*w3Re - yIm*w3Im;
+		y[3*lanes+b  ] = yRe*w3Im + yIm*w3Re;
+	}
+}
+
+
+/****************************************************************/
+/*  radix P = 3, 5 or 7 from the pairs r, P-r: with             */
+/*  s_r = x_r + x_P-r and d_r = x_r - x_P-r, output k and P-k   */
+/*  are x_0 + sum cos(2pi*rk/P)*s_r  -/+ j*sum sin(..)*d_r.      */
+/*  c and sn hold cos and sin(2pi*i/P), sn negated for the      */
+/*  inverse.  Called with P constant so the loops over r and k  */
+/*  unroll and the one over the lanes vectorizes                */
+/****************************************************************/
+static inline void stockhamRadixOdd( Uint32 P, size_t lanes, const float *restrict x, size_t xStep, float *restrict y,
+                                     const float *tw, const float *c, const float *sn ) {
+	size_t b;
+	Uint32 r, k, i, half;
+	float  sRe[(VLFFT_BATCH_MAX_RADIX+1)/2], sIm[(VLFFT_BATCH_MAX_RADIX+1)/2];
+	float  dRe[(VLFFT_BATCH_MAX_RADIX+1)/2], dIm[(VLFFT_BATCH_MAX_RADIX+1)/2];
+	float  aRe, aIm, mRe, mIm, uRe, uIm, yRe, yIm;
+
+	half = P>>1;
+
+	for( b=0; b<lanes; b+=2 ) {
+		aRe = x[b+1];
+		aIm = x[b];
+		mRe = aRe;
+		mIm = aIm;
+		for( r=1; r<=half; r++ ) {
+			sRe[r] = x[r*xStep+b+1] + x[(P-r)*xStep+b+1];
+			sIm[r] = x[r*xStep+b  ] + x[(P-r)*xStep+b  ];
+			dRe[r] = x[r*xStep+b+1] - x[(P-r)*xStep+b+1];
+			dIm[r] = x[r*xStep+b  ] - x[(P-r)*xStep+b  ];
+			mRe += sRe[r];
+			mIm += sIm[r];
+		}
+		y[b+1] = mRe;
+		y[b  ] = mIm;
+
+		for( k=1; k<=half; k++ ) {
+			mRe = aRe;
+			mIm = aIm;
+			uRe = 0.0f;
+			uIm = 0.0f;
+			for( r=1; r<=half; r++ ) {
+				i = (r*k)%P;
+				mRe += c[i]*sRe[r];
+				mIm += c[i]*sIm[r];
+				uRe += sn[i]*dRe[r];
+				uIm += sn[i]*dIm[r];
+			}
+
+			// (m - j*u) * W^k
+			yRe = mRe + uIm;
+			yIm = mIm - uRe;
+			y[k*lanes+b+1] = yRe*tw[2*k+1] - yIm*tw[2*k];
+			y[k*lanes+b  ] = yRe*tw[2*k] + yIm*tw[2*k+1];
+
+			// (m + j*u) * W^(P-k)
+			yRe = mRe - uIm;
+			yIm = mIm + uRe;
+			y[(P-k)*lanes+b+1] = yRe*tw[2*(P-k)+1] - yIm*tw[2*(P-k)];
+			y[(P-k)*lanes+b  ] = yRe*tw[2*(P-k)] + yIm*tw[2*(P-k)+1];
+		}
+	}
+}
+
+
+/****************************************************************/
+/*  radices of the passes, 4s first, then a 2 and the odd ones; */
+/*  one radix-4 pass becomes two radix-2 passes when that makes */
+/*  their number odd, so the ping-pong ends in the output       */
+/*  buffer.  Returns the number of passes, 0 if n has a prime   */
+/*  factor above VLFFT_BATCH_MAX_RADIX                          */
+/****************************************************************/
+static Uint32 stockhamRadices( Uint32 n, Uint32 *pRadix ) {
+	static const Uint32 oddRadix[3] = { 3, 5, 7 };
+	Uint32 numPasses, i;
+
+	numPasses = 0;
+	while( n%4 == 0 ) {
+		pRadix[numPasses++] = 4;
+		n /= 4;
+	}
+	if( n%2 == 0 ) {
+		pRadix[numPasses++] = 2;
+		n /= 2;
+	}
+	for( i=0; i<3; i++ ) {
+		while( n%oddRadix[i] == 0 ) {
+			pRadix[numPasses++] = oddRadix[i];
+			n /= oddRadix[i];
+		}
+	}
+	if( n != 1 )
+		return 0;
+
+	if( (numPasses&0x1) == 0 && pRadix[0] == 4 ) {
+		for( i=numPasses; i>1; i-- )
+			pRadix[i] = pRadix[i-1];
+		pRadix[0] = 2;
+		pRadix[1] = 2;
+		numPasses++;
+	}
+	return numPasses;
+}
+
+
+/*********************************************************/
+/*  stages of an n-point vlfftBatchFFTStages(), n a      */
+/*  power of 2: as few as radices up to maxRadix (4, 8   */
+/*  or 16) allow, the largest first, so 1024 is 16x16x4  */
+/*  and 512 16x8x4; a radix 2 only to end an odd power   */
+/*  of 2 with maxRadix 4.  Packed VLFFT_BATCH_STAGE_BITS */
+/*  per stage, log2 of the radix less 1, the first stage */
+/*  in the low bits                                      */
+/*********************************************************/
+Uint32 vlfftBatchStages( Uint32 n, Uint32 maxRadix ) {
+	Uint32 radixLog2[VLFFT_BATCH_MAX_STAGES];
+	Uint32 log2N, maxLog2, numStages, stages;
+
+	log2N   = log2Size( n );
+	maxLog2 = log2Size( maxRadix );
+
+	numStages = 0;
+	while( log2N >= maxLog2 ) {
+		radixLog2[numStages++] = maxLog2;
+		log2N -= maxLog2;
+	}
+	if( log2N == 1 && numStages > 0 && maxLog2 > 2 ) {
+		radixLog2[numStages-1]--;
+		log2N = 2;
+	}
+	if( log2N > 0 )
+		radixLog2[numStages++] = log2N;
+
+	stages = 0;
+	while( numStages > 0 )
+		stages = (stages<<VLFFT_BATCH_STAGE_BITS) | (radixLog2[--numStages]-1);
+	return stages;
+}
+
+
+/*********************************************************/
+/*  1 if the radices of stages multiply to n with no     */
+/*  stage packed beyond the last, as vlfftBatchStages()  */
+/*  leaves them; stages from wisdom are checked with it  */
+/*********************************************************/
+Bool vlfftBatchStagesValid( Uint32 n, Uint32 stages ) {
+	Uint32 S, R, t;
+
+	if( n == 0 || (n&(n-1)) != 0 )
+		return 0;
+
+	S = n;
+	for( t=0; S>1 && t<VLFFT_BATCH_MAX_STAGES; t++ ) {
+		R = 1U << (((stages>>(VLFFT_BATCH_STAGE_BITS*t))&((1U<<VLFFT_BATCH_STAGE_BITS)-1))+1);
+		if( S%R != 0 )
+			return 0;
+		S /= R;
+	}
+	return S == 1 && (t == VLFFT_BATCH_MAX_STAGES || (stages>>(VLFFT_BATCH_STAGE_BITS*t)) == 0);
+}
+
+
+/*********************************************************/
+/*  n-point FFTs, n a power of 2, of the numFFTs columns */
+/*  of x (n rows of numFFTs complex samples) in place,   */
+/*  in the radix 2, 4, 8 and 16 stages of stages (from   */
+/*  vlfftBatchStages()), leaving the rows in bit-        */
+/*  reversed order.  pTwiddle as for                     */
+/*  DSPF_sp_radix4_fftSPxSP(), or for the inverse        */
+/*  kernels when direction is VLFFT_INVERSE              */
+/*********************************************************/
+void vlfftBatchFFTStages( Uint32 n, Uint32 numFFTs, float *x, const float *pTwiddle, Uint32 direction, Uint32 stages ) {
+	Uint32 S, R;
+	size_t rowFloats;
+	float  sgn;
+
+	rowFloats = 2*(size_t)numFFTs;
+	sgn       = direction == VLFFT_INVERSE ? -1.0f : 1.0f;
+
+	for( S=n; S>1; S/=R ) {
+		R       = 1U << ((stages&((1U<<VLFFT_BATCH_STAGE_BITS)-1))+1);
+		stages >>= VLFFT_BATCH_STAGE_BITS;
+
+		switch( R ) {
+		case 2:
+			batchStage( 2, n, S, rowFloats, x, pTwiddle, sgn );
+			break;
+		case 4:
+			batchStage( 4, n, S, rowFloats, x, pTwiddle, sgn );
+			break;
+		case 8:
+			batchStage( 8, n, S, rowFloats, x, pTwiddle, sgn );
+			break;
+		default:
+			batchStage( 16, n, S, rowFloats, x, pTwiddle, sgn );
+			break;
+		}
+	}
+}
+
+
+/*********************************************************/
+/*  vlfftBatchFFTStages() with the twiddle multiply      */
+/*  between the passes in its last stage, the batched    */
+/*  DSPF_sp_radix4_fftTwSPxSP(): output k of FFT b times */
+/*  W^k, W the complex (re, im) at pWStep[2*b], goes to  */
+/*  complex index b*fftStride + k*outStride of pOut, in  */
+/*  natural order.  x is left after the other stages     */
+/*********************************************************/
+void vlfftBatchFFTStagesTw( Uint32 n, Uint32 numFFTs, float *x, const float *pTwiddle, Uint32 direction, Uint32 stages,
+                            const float *pWStep, float *pOut, Uint32 fftStride, Uint32 outStride ) {
+	Uint32 S, R;
+	size_t rowFloats;
+	float  sgn;
+
+	rowFloats = 2*(size_t)numFFTs;
+	sgn       = direction == VLFFT_INVERSE ? -1.0f : 1.0f;
+
+	for( S=n; ; S/=R ) {
+		R       = 1U << ((stages&((1U<<VLFFT_BATCH_STAGE_BITS)-1))+1);
+		stages >>= VLFFT_BATCH_STAGE_BITS;
+		if( R == S )
+			break;
+
+		switch( R ) {
+		case 2:
+			batchStage( 2, n, S, rowFloats, x, pTwiddle, sgn );
+			break;
+		case 4:
+			batchStage( 4, n, S, rowFloats, x, pTwiddle, sgn );
+			break;
+		case 8:
+			batchStage( 8, n, S, rowFloats, x, pTwiddle, sgn );
+			break;
+		default:
+			batchStage( 16, n, S, rowFloats, x, pTwiddle, sgn );
+			break;
+		}
+	}
+
+	switch( R ) {
+	case 2:
+		batchStageTw( 2, n, numFFTs, x, pTwiddle, sgn, pWStep, pOut, fftStride, outStride );
+		break;
+	case 4:
+		batchStageTw( 4, n, numFFTs, x, pTwiddle, sgn, pWStep, pOut, fftStride, outStride );
+		break;
+	case 8:
+		batchStageTw( 8, n, numFFTs, x, pTwiddle, sgn, pWStep, pOut, fftStride, outStride );
+		break;
+	default:
+		batchStageTw( 16, n, numFFTs, x, pTwiddle, sgn, pWStep, pOut, fftStride, outStride );
+		break;
+	}
+}
+
+
+/*********************************************************/
+/*  vlfftBatchFFTStages() in the stages                  */
+/*  vlfftBatchStages() picks up to                       */
+/*  VLFFT_BATCH_STAGE_RADIX                              */
+/*********************************************************/
+void vlfftBatchFFT( Uint32 n, Uint32 numFFTs, float *x, const float *pTwiddle, Uint32 direction ) {
+	vlfftBatchFFTStages( n, numFFTs, x, pTwiddle, direction, vlfftBatchStages( n, VLFFT_BATCH_STAGE_RADIX ) );
+}
+
+
+/*********************************************************/
+/*  rows of a vlfftBatchFFT() result back in natural     */
+/*  order, times scale: still numFFTs interleaved        */
+/*********************************************************/
+void vlfftBatchFFTRows( Uint32 n, Uint32 numFFTs, const float *x, float *pOut, float scale ) {
+	Uint32 k, numBits;
+	size_t b, rowFloats;
+	const float *pRow;
+
+	rowFloats = 2*numFFTs;
+	numBits   = log2Size( n );
+
+	for( k=0; k<n; k++ ) {
+		pRow = &x[rowFloats*bitReverse( k, numBits )];
+		for( b=0; b<rowFloats; b++ )
+			pOut[rowFloats*k+b] = pRow[b]*scale;
+	}
+}
+
+
+/*********************************************************/
+/*  FFT fftIdx of a vlfftBatchFFT() result in natural    */
+/*  order, n contiguous complex samples; of a            */
+/*  vlfftBatchMixedFFT() one, already in natural order,  */
+/*  when bitReversed is 0                                */
+/*********************************************************/
+void vlfftBatchFFTColumn( Uint32 n, Uint32 numFFTs, const float *x, Uint32 fftIdx, Bool bitReversed, float *pOut ) {
+	Uint32 k, j, numBits;
+
+	numBits = log2Size( n );
+
+	for( k=0; k<n; k++ ) {
+		j = bitReversed ? bitReverse( k, numBits ) : k;
+		pOut[2*k  ] = x[2*(numFFTs*j+fftIdx)  ];
+		pOut[2*k+1] = x[2*(numFFTs*j+fftIdx)+1];
+	}
+}
+
+
+/*********************************************************/
+/*  n-point FFTs of the numFFTs columns of x, n with no  */
+/*  prime factor above VLFFT_BATCH_MAX_RADIX, into pOut  */
+/*  in natural order times scale, still interleaved; x   */
+/*  is overwritten.  pTwiddle holds W_n^j, j = 0 .. n-1  */
+/*  from genTwiddleMixed() in the same direction         */
+/*********************************************************/
+void vlfftBatchMixedFFT( Uint32 n, Uint32 numFFTs, float *x, float *pOut, const float *pTwiddle, Uint32 direction,
+                         float scale ) {
+	Uint32 radix[VLFFT_BATCH_MAX_PASSES];
+	Uint32 numPasses, pass, P, L, m, p, k, i, wStep;
+	size_t lanes, j, numFloats;
+	float  *pSrc, *pDst, *pTmp;
+	float  tw[2*VLFFT_BATCH_MAX_RADIX], c[VLFFT_BATCH_MAX_RADIX], sn[VLFFT_BATCH_MAX_RADIX];
+	Bool   inverse;
+	const double PI = 3.141592654;
+
+	numPasses = stockhamRadices( n, radix );
+	inverse   = direction == VLFFT_INVERSE;
+
+	pSrc  = x;
+	pDst  = pOut;
+	lanes = 2*numFFTs;
+	L     = n;
+
+	for( pass=0; pass<numPasses; pass++ ) {
+		P     = radix[pass];
+		m     = L/P;
+		wStep = n/L;
+		for( i=0; i<P; i++ ) {
+			c[i]  = (float)cos( 2*PI*i/P );
+			sn[i] = (float)(inverse ? -sin( 2*PI*i/P ) : sin( 2*PI*i/P ));
+		}
+
+		for( p=0; p<m; p++ ) {
+			for( k=1; k<P; k++ ) {
+				tw[2*k  ] = pTwiddle[2*(p*k*wStep)  ];
+				tw[2*k+1] = pTwiddle[2*(p*k*wStep)+1];
+			}
+
+			switch( P ) {
+			case 2:
+				stockhamRadix2( lanes, pSrc + lanes*p, lanes*m, pDst + lanes*P*p, tw );
+				break;
+			case 4:
+				stockhamRadix4( lanes, pSrc + lanes*p, lanes*m, pDst + lanes*P*p, tw, inverse );
+				break;
+			case 3:
+				stockhamRadixOdd( 3, lanes, pSrc + lanes*p, lanes*m, pDst + lanes*P*p, tw, c, sn );
+				break;
+			case 5:
+				stockhamRadixOdd( 5, lanes, pSrc + lanes*p, lanes*m, pDst + lanes*P*p, tw, c, sn );
+				break;
+			default:
+				stockhamRadixOdd( 7, lanes, pSrc + lanes*p, lanes*m, pDst + lanes*P*p, tw, c, sn );
+				break;
+			}
+		}
+
+		lanes *= P;
+		L      = m;
+		pTmp   = pSrc;
+		pSrc   = pDst;
+		pDst   = pTmp;
+	}
+
+	// an even number of passes ends in x
+	numFloats = 2*(size_t)n*numFFTs;
+	if( pSrc != pOut || scale != 1.0f )
+		for( j=0; j<numFloats; j++ )
+			pOut[j] = pSrc[j]*scale;
+}
@@ -2,6 +2,21 @@
  * vlfftParamsInit()
  *   Initialize parameters for multicore FFT
  *
+ * vlfftParamsConfigInit()
+ *   Initialize parameters for multicore FFT from a run time configuration
+ *
+ * vlfftConfigSelect()
+ *   Choose the N1*N2 split, radix and blocking for a given size and core count
+ *
+ * vlfftConfigFactor()
+ *   Check and fill in one given N1*N2 split, radix and blocking
+ *
+ * vlfftConfigSelect2D()
+ *   Choose the radix and blocking of an N1 x N2 2D FFT
+ *
+ * vlfftTwiddleTableSize()
+ *   Per core size of the inter-pass twiddle table
+ *
  * vlfftBuffersInit()
  *   Initialize buffer pointers for multicore FFT
  *
@@ -39,9 +54,11 @@
 */
 
 
-#include <xdc/std.h>
 #include <string.h>
 
+#ifndef VLFFT_HOST
+#include <xdc/std.h>
+
 /*  -----------------------------------XDC.RUNTIME module Headers    */
 #include <xdc/runtime/System.h>
 #include <xdc/runtime/IHeap.h>
@@ -59,6 +76,7 @@
 
 /*  ----------------------------------- To get globals from .cfg Header */
 #include <xdc/cfg/global.h>
+#endif
 
 /*  vlfft local define */
 #include "../vlfftInc/vlfftDebug.h"
@@ -67,6 +85,279 @@
 #include "../vlfftInc/vlfftconfig.h"
 
 
+/* the vlfftBatchFFTStages() stages a pass starts with, none for VLFFT_RADIX_MIXED */
+static Uint32 batchStages( Uint32 radix, Uint32 n ) {
+	return radix == VLFFT_RADIX_MIXED ? 0 : vlfftBatchStages( n, VLFFT_BATCH_STAGE_RADIX );
+}
+
+
+/****************************************/
+/*    vlfftconfig.h settings            */
+/****************************************/
+void vlfftConfigDefault( VLFFTconfig_t *VLFFTconfig ) {
+	VLFFTconfig->N  = VLFFT_SIZE;
+	VLFFTconfig->N1 = VLFFT_N1;
+	VLFFTconfig->N2 = VLFFT_N2;
+
+	VLFFTconfig->radix_1stIter = RADIX_1stIter;
+	VLFFTconfig->log4N_1stIter = LOG4N_1stIter;
+	VLFFTconfig->radix_2ndIter = RADIX_2ndIter;
+	VLFFTconfig->log4N_2ndIter = LOG4N_2ndIter;
+	VLFFTconfig->stages_1stIter = batchStages( RADIX_1stIter, VLFFT_N1 );
+	VLFFTconfig->stages_2ndIter = batchStages( RADIX_2ndIter, VLFFT_N2 );
+
+	VLFFTconfig->maxNumCores = MAX_NUMBER_CORES;
+	VLFFTconfig->numCoresForFftCompute = NUM_CORES_FOR_FFT_COMPUTE;
+	VLFFTconfig->log2NumCoresForFftCompute = LOG2_NUM_CORES_FOR_COMPUTE;
+
+	VLFFTconfig->samplesPerBlock = SAMPLES_PER_TRANSFER_BLOCK;
+	VLFFTconfig->log2SamplesPerBlock = LOG2_SAMPLES_PER_TRANSFER_BLOCK;
+
+	VLFFTconfig->direction    = VLFFT_DIRECTION;
+	VLFFTconfig->scaleInverse = VLFFT_SCALE_INVERSE;
+
+	VLFFTconfig->twiddleMode       = VLFFT_TWIDDLE_RECURSIVE;
+	VLFFTconfig->twiddleAnchorStep = VLFFT_TWIDDLE_ANCHOR_STEP;
+
+	VLFFTconfig->bufferDepth  = VLFFT_BUFFER_DEPTH;
+	VLFFTconfig->emulateEdma  = 0;
+	VLFFTconfig->inPlace      = VLFFT_OUT_OF_PLACE;
+	VLFFTconfig->intermediate = VLFFT_INTERMEDIATE_FLOAT;
+	VLFFTconfig->schedule     = VLFFT_SCHEDULE_STATIC;
+	VLFFTconfig->transform    = VLFFT_TRANSFORM_1D;
+	VLFFTconfig->inputBegin   = 0;
+	VLFFTconfig->inputEnd     = 0;
+	VLFFTconfig->outputBegin  = 0;
+	VLFFTconfig->outputEnd    = 0;
+}
+
+
+static Int32 log2Exact( Uint32 n ) {
+	Int32 log2n = 0;
+
+	if( n == 0 || (n & (n-1)) != 0 )
+		return -1;
+	while( (1U<<log2n) < n )
+		log2n++;
+	return log2n;
+}
+
+
+/* no prime factor above VLFFT_BATCH_MAX_RADIX */
+static Bool mixedSize( Uint32 n ) {
+	static const Uint32 prime[4] = { 2, 3, 5, 7 };
+	Uint32 i;
+
+	for( i=0; i<4 && n!=0; i++ )
+		while( n%prime[i] == 0 )
+			n /= prime[i];
+	return n == 1;
+}
+
+
+/* radix 4 needs a power of 4, radix 2 a power of 2; */
+/* VLFFT_RADIX_MIXED takes the rest, radix 2, 3, 5   */
+/* and 7 Stockham passes need no factor 4            */
+static Bool radixLegal( Uint32 radix, Uint32 n ) {
+	Int32 log2n = log2Exact( n );
+
+	if( radix == VLFFT_RADIX_MIXED )
+		return mixedSize( n );
+	if( radix == 4 )
+		return log2n >= 0 && (log2n&0x1) == 0;
+	return radix == 2 && log2n >= 0;
+}
+
+
+static Uint32 log4Size( Uint32 radix, Uint32 n ) {
+	return radix == 4 ? (log2Exact( n )>>1)-2 : 0;
+}
+
+
+/* the radix vlfftConfigSelect() gives a pass of size n */
+static Uint32 sizeRadix( Uint32 n ) {
+	Int32 log2n = log2Exact( n );
+
+	if( log2n < 0 )
+		return VLFFT_RADIX_MIXED;
+	return (log2n&0x1) ? 2 : 4;
+}
+
+
+/*******************************************************/
+/*    N = N1*N2 with the given radices and block size  */
+/*    radix 4 needs a power of 4 FFT size, radix 2     */
+/*    (mixed radix) takes any power of 2, and          */
+/*    VLFFT_RADIX_MIXED any size with factors up to 7, */
+/*    but on the DSP N1 must be a multiple of 4 for    */
+/*    multTwiddle_vec_1_sa(); every core needs at      */
+/*    least one whole block in both passes.  Any       */
+/*    numCores but a power of 2, and                   */
+/*    any split they cannot share evenly, is scheduled */
+/*    dynamically                                      */
+/*                                                     */
+/*    returns 0, or -1 if the combination is illegal   */
+/*******************************************************/
+Int32 vlfftConfigFactor( VLFFTconfig_t *VLFFTconfig, Uint32 N, Uint32 numCores, Uint32 N1,
+                         Uint32 radix_1stIter, Uint32 radix_2ndIter, Uint32 samplesPerBlock ) {
+	Int32  log2Cores, log2Block;
+	Uint32 N2;
+	Bool   dynamic;
+
+	log2Cores = log2Exact( numCores );
+	log2Block = log2Exact( samplesPerBlock );
+	if( N < (1U<<VLFFT_MIN_LOG2_SIZE) || N > (1U<<VLFFT_MAX_LOG2_SIZE) || numCores == 0 )
+		return -1;
+	if( N1 < (1U<<VLFFT_MIN_LOG2_FFT_SIZE) || N%N1 != 0 || N/N1 < (1U<<VLFFT_MIN_LOG2_FFT_SIZE) )
+		return -1;
+	if( log2Block < 0 || samplesPerBlock > VLFFT_MAX_SAMPLES_PER_BLOCK )
+		return -1;
+
+	N2 = N/N1;
+	if( N1/numCores < samplesPerBlock || N2/numCores < samplesPerBlock )
+		return -1;
+
+	// whole blocks, and in every core's share unless the cores claim
+	// them one at a time; both always so for powers of 2
+	if( N1%samplesPerBlock != 0 || N2%samplesPerBlock != 0 )
+		return -1;
+	dynamic = log2Cores < 0 || N1%(samplesPerBlock*numCores) != 0 || N2%(samplesPerBlock*numCores) != 0;
+
+	if( !radixLegal( radix_1stIter, N1 ) || !radixLegal( radix_2ndIter, N2 ) )
+		return -1;
+#ifndef VLFFT_HOST
+	// the pass 1 twiddle multiply steps 4 outputs at a time
+	if( N1%4 != 0 )
+		return -1;
+#endif
+
+	VLFFTconfig->N  = N;
+	VLFFTconfig->N1 = N1;
+	VLFFTconfig->N2 = N2;
+
+	VLFFTconfig->radix_1stIter = radix_1stIter;
+	VLFFTconfig->log4N_1stIter = log4Size( radix_1stIter, N1 );
+	VLFFTconfig->radix_2ndIter = radix_2ndIter;
+	VLFFTconfig->log4N_2ndIter = log4Size( radix_2ndIter, N2 );
+	VLFFTconfig->stages_1stIter = batchStages( radix_1stIter, N1 );
+	VLFFTconfig->stages_2ndIter = batchStages( radix_2ndIter, N2 );
+
+	VLFFTconfig->maxNumCores = numCores > MAX_NUMBER_CORES ? numCores : MAX_NUMBER_CORES;
+	VLFFTconfig->numCoresForFftCompute = numCores;
+	VLFFTconfig->log2NumCoresForFftCompute = log2Cores < 0 ? 0 : log2Cores;
+
+	VLFFTconfig->samplesPerBlock = samplesPerBlock;
+	VLFFTconfig->log2SamplesPerBlock = log2Block;
+
+	// forward, recursive twiddles unless the caller asks otherwise
+	VLFFTconfig->direction    = VLFFT_FORWARD;
+	VLFFTconfig->scaleInverse = 0;
+
+	VLFFTconfig->twiddleMode       = VLFFT_TWIDDLE_RECURSIVE;
+	VLFFTconfig->twiddleAnchorStep = VLFFT_TWIDDLE_ANCHOR_STEP;
+
+	VLFFTconfig->bufferDepth  = VLFFT_BUFFER_DEPTH;
+	VLFFTconfig->emulateEdma  = 0;
+	VLFFTconfig->inPlace      = VLFFT_OUT_OF_PLACE;
+	VLFFTconfig->intermediate = VLFFT_INTERMEDIATE_FLOAT;
+	VLFFTconfig->schedule     = dynamic ? VLFFT_SCHEDULE_DYNAMIC : VLFFT_SCHEDULE_STATIC;
+	VLFFTconfig->transform    = VLFFT_TRANSFORM_1D;
+	VLFFTconfig->inputBegin   = 0;
+	VLFFTconfig->inputEnd     = 0;
+	VLFFTconfig->outputBegin  = 0;
+	VLFFTconfig->outputEnd    = 0;
+
+	return 0;
+}
+
+
+/*******************************************************/
+/*    pick the split, radix and blocking for an        */
+/*    N-point FFT on numCores cores.  On the host a    */
+/*    tuned entry from the wisdom file wins, otherwise */
+/*    follow the vlfftconfig.h table:                  */
+/*    N1 = 2^ceil(log2N/2), N2 = 2^floor(log2N/2),     */
+/*    radix-4 when the size is a power of 4, radix-4 + */
+/*    radix-2 otherwise.  Other sizes take the         */
+/*    largest block, then the smallest N1 >= sqrt(N),  */
+/*    both passes can split into, with                 */
+/*    VLFFT_RADIX_MIXED for both                       */
+/*                                                     */
+/*    returns 0, or -1 if N or numCores is unsupported */
+/*******************************************************/
+Int32 vlfftConfigSelect( VLFFTconfig_t *VLFFTconfig, Uint32 N, Uint32 numCores ) {
+	Int32  log2N, log2N1, log2N2;
+	Uint32 N1, N2, samplesPerBlock;
+
+#ifdef VLFFT_HOST
+	if( vlfftWisdomLookup( VLFFTconfig, N, numCores ) == 0 )
+		return 0;
+#endif
+
+	log2N = log2Exact( N );
+	if( log2N < 0 ) {
+		if( !mixedSize( N ) || numCores == 0 )
+			return -1;
+
+		for( samplesPerBlock=SAMPLES_PER_TRANSFER_BLOCK; samplesPerBlock>0; samplesPerBlock>>=1 ) {
+			for( N1=1U<<VLFFT_MIN_LOG2_FFT_SIZE; N1<=(N>>VLFFT_MIN_LOG2_FFT_SIZE); N1++ ) {
+				if( N%N1 != 0 || (unsigned long long)N1*N1 < N )
+					continue;
+				if( vlfftConfigFactor( VLFFTconfig, N, numCores, N1, VLFFT_RADIX_MIXED, VLFFT_RADIX_MIXED,
+				                       samplesPerBlock ) == 0 )
+					return 0;
+			}
+		}
+		return -1;
+	}
+
+	log2N1 = (log2N+1)>>1;
+	log2N2 = log2N>>1;
+	N1 = 1U<<log2N1;
+	N2 = 1U<<log2N2;
+
+	// blocks of 8 unless a core has fewer FFTs than that
+	samplesPerBlock = SAMPLES_PER_TRANSFER_BLOCK;
+	while( samplesPerBlock > 1 && samplesPerBlock*numCores > N2 )
+		samplesPerBlock >>= 1;
+
+	return vlfftConfigFactor( VLFFTconfig, N, numCores, N1,
+	                          (log2N1&0x1) ? 2 : 4, (log2N2&0x1) ? 2 : 4, samplesPerBlock );
+}
+
+
+/*******************************************************/
+/*    N1 x N2 2D FFT: pass 1 the N1-point FFTs down    */
+/*    the columns, pass 2 the N2-point FFTs along the  */
+/*    rows, both in place over rows of N2 samples and  */
+/*    no twiddles between them.  VLFFT_TRANSFORM_      */
+/*    COLUMNS runs pass 1 alone, the first axis of a   */
+/*    3D FFT with its planes as the N2 columns.  Each  */
+/*    size takes the radix vlfftConfigSelect() would  */
+/*    give it, blocks of 8 unless a core has fewer     */
+/*    FFTs than that                                   */
+/*                                                     */
+/*    returns 0, or -1 if a size or numCores is        */
+/*    unsupported                                      */
+/*******************************************************/
+Int32 vlfftConfigSelect2D( VLFFTconfig_t *VLFFTconfig, Uint32 N1, Uint32 N2, Uint32 numCores, Uint32 transform ) {
+	Uint32 samplesPerBlock;
+
+	if( N1 == 0 || N2 == 0 || (unsigned long long)N1*N2 > (1U<<VLFFT_MAX_LOG2_SIZE) )
+		return -1;
+
+	for( samplesPerBlock=SAMPLES_PER_TRANSFER_BLOCK; samplesPerBlock>0; samplesPerBlock>>=1 ) {
+		if( vlfftConfigFactor( VLFFTconfig, N1*N2, numCores, N1, sizeRadix( N1 ), sizeRadix( N2 ),
+		                       samplesPerBlock ) == 0 ) {
+			VLFFTconfig->inPlace   = VLFFT_IN_PLACE;
+			VLFFTconfig->transform = transform;
+			return 0;
+		}
+	}
+	return -1;
+}
+
+
 /****************************************/
 /*    N=N1*N2                           */
 /*      1st iteration                   */
@@ -76,31 +367,84 @@
 /*                                      */
 /****************************************/
 void vlfftParamsInit(VLFFTparams_t *VLFFTparams, float *pW1, float *pW2, float *pTwiddle, Uint32 coreNum ) {
-	VLFFTparams->maxNumCores = MAX_NUMBER_CORES;
-	VLFFTparams->numCoresForFftCompute = NUM_CORES_FOR_FFT_COMPUTE;
-	VLFFTparams->log2NumCoresForFftCompute = LOG2_NUM_CORES_FOR_COMPUTE;
+	VLFFTconfig_t VLFFTconfig;
+
+	vlfftConfigDefault( &VLFFTconfig );
+	vlfftParamsConfigInit( VLFFTparams, &VLFFTconfig, pW1, pW2, pTwiddle, NULL, coreNum );
+}
+
+
+/* log2 of the share of a pass's blocks a core is set up for: dynamic */
+/* scheduling sets every core up for all of them                      */
+static Uint32 log2CoreShare( const VLFFTconfig_t *VLFFTconfig ) {
+	return VLFFTconfig->schedule == VLFFT_SCHEDULE_DYNAMIC ? 0 : VLFFTconfig->log2NumCoresForFftCompute;
+}
+
+
+/****************************************/
+/*    floats of pTwiddleTable per core, */
+/*    0 for recursive twiddles          */
+/****************************************/
+Uint32 vlfftTwiddleTableSize( const VLFFTconfig_t *VLFFTconfig ) {
+	Uint32 anchorStep;
+
+	if( VLFFTconfig->twiddleMode == VLFFT_TWIDDLE_RECURSIVE )
+		return 0;
+
+	anchorStep = VLFFTconfig->twiddleMode == VLFFT_TWIDDLE_TABLE ? 1 : VLFFTconfig->twiddleAnchorStep;
+	return 2*(VLFFTconfig->N2>>log2CoreShare( VLFFTconfig ))*((VLFFTconfig->N1+anchorStep-1)/anchorStep);
+}
 
-	VLFFTparams->radix_1stIter = RADIX_1stIter;
-	VLFFTparams->log4N_1stIter = LOG4N_1stIter;
-	VLFFTparams->radix_2ndIter = RADIX_2ndIter;
-	VLFFTparams->log4N_2ndIter = LOG4N_2ndIter;
 
-	VLFFTparams->N  = VLFFT_SIZE;
-	VLFFTparams->N1 = VLFFT_N1;
-	VLFFTparams->N2 = VLFFT_N2;
-	VLFFTparams->samplesPerBlock = SAMPLES_PER_TRANSFER_BLOCK;
+void vlfftParamsConfigInit(VLFFTparams_t *VLFFTparams, const VLFFTconfig_t *VLFFTconfig, float *pW1, float *pW2, float *pTwiddle, float *pTwiddleTable, Uint32 coreNum ) {
+	Uint32 workBytes, log2Share;
+
+	// dynamic: every core is set up as core 0 of 1 and takes the
+	// blocks from the engine's counter
+	log2Share = log2CoreShare( VLFFTconfig );
+	if( VLFFTconfig->schedule == VLFFT_SCHEDULE_DYNAMIC )
+		coreNum = 0;
+
+	VLFFTparams->maxNumCores = VLFFTconfig->maxNumCores;
+	VLFFTparams->numCoresForFftCompute = VLFFTconfig->numCoresForFftCompute;
+	VLFFTparams->log2NumCoresForFftCompute = VLFFTconfig->log2NumCoresForFftCompute;
+
+	VLFFTparams->radix_1stIter = VLFFTconfig->radix_1stIter;
+	VLFFTparams->log4N_1stIter = VLFFTconfig->log4N_1stIter;
+	VLFFTparams->radix_2ndIter = VLFFTconfig->radix_2ndIter;
+	VLFFTparams->log4N_2ndIter = VLFFTconfig->log4N_2ndIter;
+	VLFFTparams->stages_1stIter = VLFFTconfig->stages_1stIter;
+	VLFFTparams->stages_2ndIter = VLFFTconfig->stages_2ndIter;
+
+	VLFFTparams->N  = VLFFTconfig->N;
+	VLFFTparams->N1 = VLFFTconfig->N1;
+	VLFFTparams->N2 = VLFFTconfig->N2;
+	VLFFTparams->samplesPerBlock = VLFFTconfig->samplesPerBlock;
+
+	// the 1/N of the inverse is applied as the 2nd iteration writes its
+	// output, the 1/N1 of the columns alone as the 1st does
+	VLFFTparams->direction = VLFFTconfig->direction;
+	VLFFTparams->transform = VLFFTconfig->transform;
+	VLFFTparams->scale     = 1.0f;
+	if( VLFFTconfig->direction == VLFFT_INVERSE && VLFFTconfig->scaleInverse )
+		VLFFTparams->scale = 1.0f/(float)(VLFFTconfig->transform == VLFFT_TRANSFORM_COLUMNS ? VLFFTconfig->N1 : VLFFTconfig->N);
 
 	VLFFTparams->fftSize1stIter       = VLFFTparams->N1;
 	VLFFTparams->numFFTs1stIter       = VLFFTparams->N2;
-	VLFFTparams->numFFTsPerCore1stIter= VLFFTparams->N2>>(VLFFTparams->log2NumCoresForFftCompute);
-	VLFFTparams->numBlocksPerCore1stIter= (VLFFTparams->numFFTsPerCore1stIter) >> LOG2_SAMPLES_PER_TRANSFER_BLOCK;
-	VLFFTparams->numFFTsPerBlock1stIter = NUM_FFTS_PER_BLOCK;
+	VLFFTparams->numFFTsPerCore1stIter= VLFFTparams->N2>>log2Share;
+	VLFFTparams->numBlocksPerCore1stIter= (VLFFTparams->numFFTsPerCore1stIter) >> VLFFTconfig->log2SamplesPerBlock;
+	VLFFTparams->numFFTsPerBlock1stIter = VLFFTconfig->samplesPerBlock;
 
 	VLFFTparams->fftSize2ndIter       = VLFFTparams->N2;
 	VLFFTparams->numFFTs2ndIter       = VLFFTparams->N1;
-	VLFFTparams->numFFTsPerCore2ndIter  = VLFFTparams->N1>>VLFFTparams->log2NumCoresForFftCompute;
-	VLFFTparams->numBlocksPerCore2ndIter= (VLFFTparams->numFFTsPerCore2ndIter) >> (LOG2_SAMPLES_PER_TRANSFER_BLOCK);
-	VLFFTparams->numFFTsPerBlock2ndIter = NUM_FFTS_PER_BLOCK;
+	VLFFTparams->numFFTsPerCore2ndIter  = VLFFTparams->N1>>log2Share;
+	VLFFTparams->numBlocksPerCore2ndIter= (VLFFTparams->numFFTsPerCore2ndIter) >> VLFFTconfig->log2SamplesPerBlock;
+	VLFFTparams->numFFTsPerBlock2ndIter = VLFFTconfig->samplesPerBlock;
+
+	VLFFTparams->bufferDepth  = VLFFTconfig->bufferDepth;
+	VLFFTparams->inPlace      = VLFFTconfig->inPlace != VLFFT_OUT_OF_PLACE;
+	VLFFTparams->intermediate = VLFFTconfig->intermediate;
+	workBytes = VLFFTparams->intermediate == VLFFT_INTERMEDIATE_FLOAT ? BYTES_PER_COMPLEX_SAMPLE : BYTES_PER_PACKED_COMPLEX_SAMPLE;
 
 
 	VLFFTparams->offset1stIterIn      = coreNum*BYTES_PER_COMPLEX_SAMPLE;
@@ -108,25 +452,58 @@ void vlfftParamsInit(VLFFTparams_t *VLFFTparams, float *pW1, float *pW2, float *
 	VLFFTparams->offset1stIterIn     *= VLFFTparams->numBlocksPerCore1stIter;
 
 	VLFFTparams->step1stIterIn = VLFFTparams->N2*BYTES_PER_COMPLEX_SAMPLE;
-	VLFFTparams->offset1stIterOut = coreNum*VLFFTparams->fftSize1stIter*BYTES_PER_COMPLEX_SAMPLE*VLFFTparams->numFFTsPerCore1stIter;
+	VLFFTparams->offset1stIterOut = coreNum*VLFFTparams->fftSize1stIter*workBytes*VLFFTparams->numFFTsPerCore1stIter;
 
 
-	VLFFTparams->offset2ndIterIn      = coreNum*BYTES_PER_COMPLEX_SAMPLE;
-	VLFFTparams->offset2ndIterIn     *= VLFFTparams->samplesPerBlock;
-	VLFFTparams->offset2ndIterIn     *= VLFFTparams->numBlocksPerCore2ndIter;
-
-	VLFFTparams->step2ndIterIn = VLFFTparams->N1*BYTES_PER_COMPLEX_SAMPLE;
-	VLFFTparams->offset2ndIterOut = VLFFTparams->offset2ndIterIn;
+	VLFFTparams->offset2ndIterOut     = coreNum*BYTES_PER_COMPLEX_SAMPLE;
+	VLFFTparams->offset2ndIterOut    *= VLFFTparams->samplesPerBlock;
+	VLFFTparams->offset2ndIterOut    *= VLFFTparams->numBlocksPerCore2ndIter;
 	VLFFTparams->step2ndIterOut = VLFFTparams->N1*BYTES_PER_COMPLEX_SAMPLE;
 
+	// same columns of the intermediate, which may be packed
+	VLFFTparams->offset2ndIterIn = VLFFTparams->offset2ndIterOut/BYTES_PER_COMPLEX_SAMPLE*workBytes;
+	VLFFTparams->step2ndIterIn   = VLFFTparams->N1*workBytes;
+
+	// in place: pass 1 writes back over its input columns, pass 2
+	// reads and writes whole rows k1 of N2 samples
+	if( VLFFTparams->inPlace ) {
+		VLFFTparams->offset1stIterOut = VLFFTparams->offset1stIterIn;
+		VLFFTparams->step1stIterOut   = VLFFTparams->step1stIterIn;
+		VLFFTparams->offset2ndIterIn  = coreNum*VLFFTparams->numFFTsPerCore2ndIter*VLFFTparams->N2*BYTES_PER_COMPLEX_SAMPLE;
+		VLFFTparams->step2ndIterIn    = VLFFTparams->N2*BYTES_PER_COMPLEX_SAMPLE;
+		VLFFTparams->offset2ndIterOut = VLFFTparams->offset2ndIterIn;
+		VLFFTparams->step2ndIterOut   = VLFFTparams->step2ndIterIn;
+	}
+
 	VLFFTparams->pW1 = pW1;
 	VLFFTparams->pW2 = pW2;
+	VLFFTparams->pFilterSpec = NULL;
 
-	tw_gen (VLFFTparams->pW1, VLFFT_N1);
-	tw_gen (VLFFTparams->pW2, VLFFT_N2);
+	VLFFTparams->inputBegin  = VLFFTconfig->inputBegin;
+	VLFFTparams->inputEnd    = VLFFTconfig->inputEnd  ? VLFFTconfig->inputEnd  : VLFFTconfig->N;
+	VLFFTparams->outputBegin = VLFFTconfig->outputBegin;
+	VLFFTparams->outputEnd   = VLFFTconfig->outputEnd ? VLFFTconfig->outputEnd : VLFFTconfig->N;
+
+	if( VLFFTparams->radix_1stIter == VLFFT_RADIX_MIXED )
+		genTwiddleMixed (VLFFTparams->pW1, VLFFTparams->N1, VLFFTparams->direction);
+	else
+		tw_gen (VLFFTparams->pW1, VLFFTparams->N1, VLFFTparams->direction);
+	if( VLFFTparams->radix_2ndIter == VLFFT_RADIX_MIXED )
+		genTwiddleMixed (VLFFTparams->pW2, VLFFTparams->N2, VLFFTparams->direction);
+	else
+		tw_gen (VLFFTparams->pW2, VLFFTparams->N2, VLFFTparams->direction);
 
 	VLFFTparams->pTwiddle = pTwiddle;
-	genTwiddle(VLFFTparams->pTwiddle, VLFFTparams->numFFTsPerCore1stIter, coreNum);
+	genTwiddle(VLFFTparams->pTwiddle, VLFFTparams->N, VLFFTparams->numFFTsPerCore1stIter, coreNum, VLFFTparams->direction);
+
+	VLFFTparams->pTwiddleTable     = NULL;
+	VLFFTparams->twiddleAnchorStep = 0;
+	if( pTwiddleTable != NULL && VLFFTconfig->twiddleMode != VLFFT_TWIDDLE_RECURSIVE ) {
+		VLFFTparams->pTwiddleTable     = pTwiddleTable;
+		VLFFTparams->twiddleAnchorStep = VLFFTconfig->twiddleMode == VLFFT_TWIDDLE_TABLE ? 1 : VLFFTconfig->twiddleAnchorStep;
+		genTwiddleTable(pTwiddleTable, VLFFTparams->N, VLFFTparams->N1, VLFFTparams->numFFTsPerCore1stIter, coreNum,
+		                VLFFTparams->twiddleAnchorStep, VLFFTparams->direction);
+	}
 
 }
 
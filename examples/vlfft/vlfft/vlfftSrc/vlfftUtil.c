@@ -5,6 +5,10 @@
  * transpose_2()
  *     Transpose a 8xN matrix into a Nx8 matrix
  *
+ * vlfftColumnFFT()
+ *     One FFT of a block's columns with the kernel its radix and
+ *     direction call for
+ *
  * Copyright (C) {2011} Texas Instruments Incorporated - http://www.ti.com/
  *
  *
@@ -44,9 +48,11 @@
 #include <stdlib.h>
 
 
-#include <xdc/std.h>
 #include <string.h>
 
+#ifndef VLFFT_HOST
+#include <xdc/std.h>
+
 /*  -----------------------------------XDC.RUNTIME module Headers    */
 #include <xdc/runtime/System.h>
 #include <xdc/runtime/IHeap.h>
@@ -64,6 +70,7 @@
 
 /*  ----------------------------------- To get globals from .cfg Header */
 #include <xdc/cfg/global.h>
+#endif
 
 /* vlfft.h */
 #include "../vlfftInc/vlfftDebug.h"
@@ -90,6 +97,22 @@ void transpose_2( float *pIn, float *pOut, Int32 rows, Int32 cols ) {
 
 
 
+/* radix 4 or 2 take the DSPLIB kernels (the inverse one scales), */
+/* VLFFT_RADIX_MIXED the Stockham kernel as a batch of one          */
+void vlfftColumnFFT( Uint32 n, Uint32 radix, Uint32 log4N, Uint32 direction, float scale,
+                     float *pW, float *pIn, float *pOut ) {
+	if( radix == VLFFT_RADIX_MIXED )
+		vlfftBatchMixedFFT( n, 1, pIn, pOut, pW, direction, scale );
+	else if( direction == VLFFT_INVERSE )
+		DSPF_sp_mixedRadix_ifftSPxSP( n, pIn, pW, pOut, scale );
+	else if( radix == 4 )
+		DSPF_sp_radix4_fftSPxSP( n, pIn, pW, pOut, log4N );
+	else
+		DSPF_sp_mixedRadix_fftSPxSP( n, pIn, pW, pOut );
+}
+
+
+
 int compare_float( int N, float *pIn1, float *pIn2) {
 	int i, index=0,flag=0;
 	float diff;
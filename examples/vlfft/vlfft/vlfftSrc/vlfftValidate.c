@@ -0,0 +1,212 @@
+/*
+ * vlfftReferenceFFT()
+ * vlfftCompareReference()
+ * vlfftEnergyCheck()
+ *
+ *    Accuracy checks for the multicore FFT.  vlfftReferenceFFT() is a plain
+ *    recursive mixed radix FFT in double, O(N log N), against which
+ *    vlfftCompareReference() gives the max abs error, RMS error and SNR over
+ *    all bins; it replaces checking a few bins with dft().  vlfftEnergyCheck()
+ *    costs two passes over the data and can run on every frame: Parseval's
+ *    energy and the DC bin of the output against the input's
+ *
+ * Copyright (C) {2011} Texas Instruments Incorporated - http://www.ti.com/
+ *
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *    Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ *    Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the
+ *    distribution.
+ *
+ *    Neither the name of Texas Instruments Incorporated nor the names of
+ *    its contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ *  A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ *  OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *  SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *  LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ *  DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ *  THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ *  (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ *  OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+*/
+
+
+#include <math.h>
+#include <string.h>
+
+#ifndef VLFFT_HOST
+#include <xdc/std.h>
+
+/*  ----------------------------------- IPC module Headers           */
+#include <ti/ipc/MessageQ.h>
+#else
+#include "../vlfftHost/vlfftHostStd.h"
+#endif
+
+/* vlfft.h */
+#include "../vlfftInc/vlfftDebug.h"
+#include "../vlfftInc/vlfftMessgQ.h"
+#include "../vlfftInc/vlfft.h"
+#include "../vlfftInc/vlfftconfig.h"
+
+
+/*********************************************************/
+/*  n-point DFT of the samples stride apart from pIn     */
+/*  (complex float, imaginary first) into pOut (complex  */
+/*  double, imaginary first): the DFTs of the p          */
+/*  interleaved n/p-point sequences, p the smallest      */
+/*  factor of n, then n/p DFTs of size p across them.    */
+/*  pW holds W^k of the full size, W_n^j at j*wStride.   */
+/*  The p outputs of column q go where its p inputs      */
+/*  were, so the combine works in place                  */
+/*********************************************************/
+static void refFFT( const float *pIn, size_t stride, Uint32 n, double *pOut, const double *pW, size_t wStride ) {
+	double t[2*VLFFT_VALIDATE_MAX_RADIX], re, im, wRe, wIm;
+	Uint32 p, m, q, r, s;
+	size_t w;
+
+	if( n == 1 ) {
+		pOut[0] = pIn[0];
+		pOut[1] = pIn[1];
+		return;
+	}
+
+	for( p=2; n%p != 0; p++ )
+		;
+	m = n/p;
+
+	for( r=0; r<p; r++ )
+		refFFT( pIn + 2*r*stride, stride*p, m, pOut + 2*(size_t)r*m, pW, wStride*p );
+
+	for( q=0; q<m; q++ ) {
+		for( r=0; r<p; r++ ) {
+			w   = (size_t)r*q*wStride;
+			im  = pOut[2*((size_t)r*m+q)  ];
+			re  = pOut[2*((size_t)r*m+q)+1];
+			wIm = pW[2*w  ];
+			wRe = pW[2*w+1];
+			t[2*r  ] = re*wIm + im*wRe;
+			t[2*r+1] = re*wRe - im*wIm;
+		}
+		for( s=0; s<p; s++ ) {
+			re = 0.0;
+			im = 0.0;
+			for( r=0; r<p; r++ ) {
+				w   = (size_t)((r*s)%p)*m*wStride;
+				wIm = pW[2*w  ];
+				wRe = pW[2*w+1];
+				im += t[2*r+1]*wIm + t[2*r]*wRe;
+				re += t[2*r+1]*wRe - t[2*r]*wIm;
+			}
+			pOut[2*((size_t)s*m+q)  ] = im;
+			pOut[2*((size_t)s*m+q)+1] = re;
+		}
+	}
+}
+
+
+/*********************************************************/
+/*  N-point DFT of pIn in double, times scale, into      */
+/*  pWork[0 .. 2N-1] in the FFT's layout; pWork holds    */
+/*  VLFFT_REFERENCE_WORK_SIZE(N) doubles, the rest are   */
+/*  the twiddles.  Returns 0, or -1 if N has a prime     */
+/*  factor above VLFFT_VALIDATE_MAX_RADIX                */
+/*********************************************************/
+Int32 vlfftReferenceFFT( Uint32 N, const float *pIn, Uint32 direction, double scale, double *pWork ) {
+	const double PI = 3.14159265358979323846;
+	double *pW = pWork + 2*(size_t)N;
+	double sign;
+	Uint32 n, p, k;
+
+	for( n=N; n>1; n/=p ) {
+		for( p=2; n%p != 0; p++ )
+			;
+		if( p > VLFFT_VALIDATE_MAX_RADIX )
+			return -1;
+	}
+
+	sign = direction == VLFFT_INVERSE ? 1.0 : -1.0;
+	for( k=0; k<N; k++ ) {
+		pW[2*(size_t)k  ] = sign*sin( 2.0*PI*k/N );
+		pW[2*(size_t)k+1] = cos( 2.0*PI*k/N );
+	}
+
+	refFFT( pIn, 1, N, pWork, pW, 1 );
+
+	if( scale != 1.0 )
+		for( k=0; k<2*N; k++ )
+			pWork[k] *= scale;
+
+	return 0;
+}
+
+
+/* max abs error, RMS error and SNR of pOut over all N bins of pRef */
+void vlfftCompareReference( Uint32 N, const float *pOut, const double *pRef, vlfftErrorStats_t *pStats ) {
+	double sig = 0.0, err = 0.0, dRe, dIm, e2, max2 = 0.0;
+	Uint32 k;
+
+	memset( pStats, 0, sizeof(*pStats) );
+
+	for( k=0; k<N; k++ ) {
+		dIm  = pOut[2*(size_t)k  ] - pRef[2*(size_t)k  ];
+		dRe  = pOut[2*(size_t)k+1] - pRef[2*(size_t)k+1];
+		e2   = dRe*dRe + dIm*dIm;
+		err += e2;
+		sig += pRef[2*(size_t)k]*pRef[2*(size_t)k] + pRef[2*(size_t)k+1]*pRef[2*(size_t)k+1];
+		if( e2 > max2 ) {
+			max2 = e2;
+			pStats->maxErrorBin = k;
+		}
+	}
+
+	pStats->maxAbsError = sqrt( max2 );
+	pStats->rmsError    = sqrt( err/N );
+	pStats->snrDb       = err > 0.0 ? 10.0*log10( sig/err ) : VLFFT_VALIDATE_EXACT_DB;
+}
+
+
+/*********************************************************/
+/*  relative error of pOut = FFT(pIn)*scale in energy    */
+/*  (sum |X|^2 = N*scale^2 * sum |x|^2) or in the DC bin */
+/*  (X[0] = scale * sum x, against the RMS bin),         */
+/*  whichever is worse.  Permuted bins keep both, so it  */
+/*  does not replace vlfftCompareReference()             */
+/*********************************************************/
+double vlfftEnergyCheck( Uint32 N, const float *pIn, const float *pOut, double scale ) {
+	double inEnergy = 0.0, outEnergy = 0.0, sumRe = 0.0, sumIm = 0.0;
+	double expect, energyErr, dcErr, dRe, dIm;
+	size_t i;
+
+	for( i=0; i<2*(size_t)N; i+=2 ) {
+		inEnergy  += (double)pIn[i]*pIn[i] + (double)pIn[i+1]*pIn[i+1];
+		sumIm     += pIn[i];
+		sumRe     += pIn[i+1];
+		outEnergy += (double)pOut[i]*pOut[i] + (double)pOut[i+1]*pOut[i+1];
+	}
+
+	expect = N*scale*scale*inEnergy;
+	if( expect == 0.0 )
+		return outEnergy == 0.0 ? 0.0 : 1.0;
+
+	energyErr = fabs( outEnergy - expect )/expect;
+
+	dIm   = pOut[0] - scale*sumIm;
+	dRe   = pOut[1] - scale*sumRe;
+	dcErr = sqrt( (dRe*dRe + dIm*dIm)/(expect/N) );
+
+	return energyErr > dcErr ? energyErr : dcErr;
+}
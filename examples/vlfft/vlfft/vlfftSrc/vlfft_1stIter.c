@@ -94,15 +94,19 @@ void VLFFT_1stIter( float          *pIn,
 	Uint32           stepInSrc, stepInDst, stepOutSrc, stepOutDst;
 
 	Uint32           fftSize, fftSize2, n2_start;
-	float *pW1, *pWorkBuf0Internal, *pOutBufInternal, *pfftOut, *pOutTwiddle, *pTwiddle;
+	float *pW1, *pWorkBuf0Internal, *pOutBufInternal, *pfftOut, *pOutTwiddle, *pTwiddle, *pBatch;
 
 	float            *ptrInDDR, *ptrOutDDR;
 	float            *pInBufInternal;
 	float            wStepRe, wStepIm;
-	int              numFFTs;
+	int              numFFTs, fftIdx;
 
 	hEdma = DMAparams->hEdma;
 
+	// the internal buffers are ping-ponged, deeper rings are host only
+	if( VLFFTparams->bufferDepth != 2 )
+		System_abort( "VLFFT_1stIter: bufferDepth must be 2 on the DSP\n" );
+
 	fftSize = VLFFTparams->N1;
 	fftSize2= VLFFTparams->N1*2;
 	pW1 = VLFFTparams->pW1;
@@ -190,99 +194,46 @@ void VLFFT_1stIter( float          *pIn,
 
 
 		/***********************************************************/
-		/*                         transpose                       */
-		/***********************************************************/
-		transpose_1( &pInBufInternal[(stepOutSrc)*(blkIdx&0x1)>>2],
-		             &VLFFTbuffers->pWorkBuf0Internal[0],
-		             VLFFTparams->N1,
-		             SAMPLES_PER_TRANSFER_BLOCK );
-
-
-		/***********************************************************/
-		/*                         compute FFT                     */
+		/*   compute FFT: the DSPLIB kernels one column at a time  */
+		/*   out of the transposed block, or the batched kernel    */
+		/*   on all of them in place (see vlfftconfig.h)           */
 		/***********************************************************/
 		pfftOut = VLFFTbuffers->pfftOutBuf;
 		pOutTwiddle = &pOutBufInternal[(stepOutSrc*(blkIdx&0x1))>>2];
 		numFFTs = VLFFTparams->numFFTsPerBlock1stIter;
 
-		if( VLFFTparams->radix_1stIter == 4 )
-			DSPF_sp_radix4_fftSPxSP( fftSize, &pWorkBuf0Internal[fftSize2*0], &pW1[0], pfftOut, VLFFTparams->log4N_1stIter );
-		else
-			DSPF_sp_mixedRadix_fftSPxSP( fftSize, &pWorkBuf0Internal[fftSize2*0], &pW1[0], pfftOut );
-
-		wStepRe = pTwiddle[blkIdx*numFFTs*2 + 2*0    ];
-		wStepIm = pTwiddle[blkIdx*numFFTs*2 + 2*0 + 1];
-		multTwiddle_vec_1_sa( pfftOut, wStepRe, wStepIm, fftSize, &pOutTwiddle[fftSize2*0]);
-
-
-		if( VLFFTparams->radix_1stIter == 4 )
-			DSPF_sp_radix4_fftSPxSP( fftSize, &pWorkBuf0Internal[fftSize2*1], &pW1[0], pfftOut, VLFFTparams->log4N_1stIter );
-		else
-			DSPF_sp_mixedRadix_fftSPxSP( fftSize, &pWorkBuf0Internal[fftSize2*1], &pW1[0], pfftOut );
-
-		wStepRe = pTwiddle[blkIdx*numFFTs*2 + 2*1    ];
-		wStepIm = pTwiddle[blkIdx*numFFTs*2 + 2*1 + 1];
-		multTwiddle_vec_1_sa( pfftOut, wStepRe, wStepIm, fftSize, &pOutTwiddle[fftSize2*1]);
-
-
-		if( VLFFTparams->radix_1stIter == 4 )
-			DSPF_sp_radix4_fftSPxSP( fftSize, &pWorkBuf0Internal[fftSize2*2], &pW1[0], pfftOut, VLFFTparams->log4N_1stIter );
-		else
-			DSPF_sp_mixedRadix_fftSPxSP( fftSize, &pWorkBuf0Internal[fftSize2*2], &pW1[0], pfftOut );
-
-		wStepRe = pTwiddle[blkIdx*numFFTs*2 + 2*2  ];
-		wStepIm = pTwiddle[blkIdx*numFFTs*2 + 2*2+1];
-		multTwiddle_vec_1_sa( pfftOut, wStepRe, wStepIm, fftSize, &pOutTwiddle[fftSize2*2]);
-
-
-		if( VLFFTparams->radix_1stIter == 4 )
-			DSPF_sp_radix4_fftSPxSP( fftSize, &pWorkBuf0Internal[fftSize2*3], &pW1[0], pfftOut, VLFFTparams->log4N_1stIter );
-		else
-			DSPF_sp_mixedRadix_fftSPxSP( fftSize, &pWorkBuf0Internal[fftSize2*3], &pW1[0], pfftOut );
-
-		wStepRe = pTwiddle[blkIdx*numFFTs*2 + 2*3  ];
-		wStepIm = pTwiddle[blkIdx*numFFTs*2 + 2*3+1];
-		multTwiddle_vec_1_sa( pfftOut, wStepRe, wStepIm, fftSize, &pOutTwiddle[fftSize2*3]);
-
-
-		if( VLFFTparams->radix_1stIter == 4 )
-			DSPF_sp_radix4_fftSPxSP( fftSize, &pWorkBuf0Internal[fftSize2*4], &pW1[0], pfftOut, VLFFTparams->log4N_1stIter );
-		else
-			DSPF_sp_mixedRadix_fftSPxSP( fftSize, &pWorkBuf0Internal[fftSize2*4], &pW1[0], pfftOut );
-
-		wStepRe = pTwiddle[blkIdx*numFFTs*2 + 2*4  ];
-		wStepIm = pTwiddle[blkIdx*numFFTs*2 + 2*4+1];
-		multTwiddle_vec_1_sa( pfftOut, wStepRe, wStepIm, fftSize, &pOutTwiddle[fftSize2*4]);
-
-
-		if( VLFFTparams->radix_1stIter == 4 )
-			DSPF_sp_radix4_fftSPxSP( fftSize, &pWorkBuf0Internal[fftSize2*5], &pW1[0], pfftOut, VLFFTparams->log4N_1stIter );
-		else
-			DSPF_sp_mixedRadix_fftSPxSP( fftSize, &pWorkBuf0Internal[fftSize2*5], &pW1[0], pfftOut );
-
-		wStepRe = pTwiddle[blkIdx*numFFTs*2 + 2*5  ];
-		wStepIm = pTwiddle[blkIdx*numFFTs*2 + 2*5+1];
-		multTwiddle_vec_1_sa( pfftOut, wStepRe, wStepIm, fftSize, &pOutTwiddle[fftSize2*5]);
-
-
-		if( VLFFTparams->radix_1stIter == 4 )
-			DSPF_sp_radix4_fftSPxSP( fftSize, &pWorkBuf0Internal[fftSize2*6], &pW1[0], pfftOut, VLFFTparams->log4N_1stIter );
-		else
-			DSPF_sp_mixedRadix_fftSPxSP( fftSize, &pWorkBuf0Internal[fftSize2*6], &pW1[0], pfftOut );
-
-		wStepRe = pTwiddle[blkIdx*numFFTs*2 + 2*6  ];
-		wStepIm = pTwiddle[blkIdx*numFFTs*2 + 2*6+1];
-		multTwiddle_vec_1_sa( pfftOut, wStepRe, wStepIm, fftSize, &pOutTwiddle[fftSize2*6]);
-
-
-		if( VLFFTparams->radix_1stIter == 4 )
-			DSPF_sp_radix4_fftSPxSP( fftSize, &pWorkBuf0Internal[fftSize2*7], &pW1[0], pfftOut, VLFFTparams->log4N_1stIter );
-		else
-			DSPF_sp_mixedRadix_fftSPxSP( fftSize, &pWorkBuf0Internal[fftSize2*7], &pW1[0], pfftOut );
-
-		wStepRe = pTwiddle[blkIdx*numFFTs*2 + 2*7  ];
-		wStepIm = pTwiddle[blkIdx*numFFTs*2 + 2*7+1];
-		multTwiddle_vec_1_sa( pfftOut, wStepRe, wStepIm, fftSize, &pOutTwiddle[fftSize2*7]);
+		if( !VLFFT_DSP_BATCH_FFT && VLFFTparams->radix_1stIter != VLFFT_RADIX_MIXED ) {
+			transpose_1( &pInBufInternal[(stepOutSrc)*(blkIdx&0x1)>>2],
+			             &VLFFTbuffers->pWorkBuf0Internal[0],
+			             VLFFTparams->N1,
+			             SAMPLES_PER_TRANSFER_BLOCK );
+
+			for( fftIdx=0; fftIdx<numFFTs; fftIdx++ ) {
+				vlfftColumnFFT( fftSize, VLFFTparams->radix_1stIter, VLFFTparams->log4N_1stIter, VLFFTparams->direction, 1.0f,
+				                pW1, &pWorkBuf0Internal[fftSize2*fftIdx], pfftOut );
+
+				wStepRe = pTwiddle[blkIdx*numFFTs*2 + 2*fftIdx    ];
+				wStepIm = pTwiddle[blkIdx*numFFTs*2 + 2*fftIdx + 1];
+				multTwiddle_vec_1_sa( pfftOut, wStepRe, wStepIm, fftSize, &pOutTwiddle[fftSize2*fftIdx]);
+			}
+		} else {
+			pBatch = &pInBufInternal[(stepOutSrc)*(blkIdx&0x1)>>2];
+			if( VLFFTparams->radix_1stIter == VLFFT_RADIX_MIXED ) {
+				vlfftBatchMixedFFT( fftSize, numFFTs, pBatch, pWorkBuf0Internal, pW1, VLFFTparams->direction, 1.0f );
+				pBatch = pWorkBuf0Internal;
+			} else {
+				vlfftBatchFFTStages( fftSize, numFFTs, pBatch, pW1, VLFFTparams->direction, VLFFTparams->stages_1stIter );
+			}
+
+			// twiddle each FFT into its row
+			for( fftIdx=0; fftIdx<numFFTs; fftIdx++ ) {
+				vlfftBatchFFTColumn( fftSize, numFFTs, pBatch, fftIdx, VLFFTparams->radix_1stIter != VLFFT_RADIX_MIXED, pfftOut );
+
+				wStepRe = pTwiddle[blkIdx*numFFTs*2 + 2*fftIdx    ];
+				wStepIm = pTwiddle[blkIdx*numFFTs*2 + 2*fftIdx + 1];
+				multTwiddle_vec_1_sa( pfftOut, wStepRe, wStepIm, fftSize, &pOutTwiddle[fftSize2*fftIdx]);
+			}
+		}
 
 		n2_start += VLFFTparams->numFFTsPerBlock1stIter;
 
@@ -69,8 +69,6 @@
 
 extern unsigned char brev[];
 
-void transpose_1( float *pIn, float *pOut, Int32 rows, Int32 cols );
-
 #if ENABLE_BENCHMARKING
 extern unsigned long long global_timer_dmaWait_2nd;
 extern unsigned long long global_timer_fft_2nd;
@@ -103,10 +101,14 @@ void VLFFT_2ndIter( float          *pIn,
 	float            *ptrInDDR, *ptrOutDDR;
 	float            *pInBufInternal, *pOutBufInternal, *pWorkBuf0Internal;
 	float            *pfftOut, *pfftIn, *pW2;
-	Uint32           fftSize, fftSize2;
+	Uint32           fftSize, fftSize2, fftIdx;
 
 	hEdma = DMAparams->hEdma;
 
+	// the internal buffers are ping-ponged, deeper rings are host only
+	if( VLFFTparams->bufferDepth != 2 )
+		System_abort( "VLFFT_2ndIter: bufferDepth must be 2 on the DSP\n" );
+
 	pInBufInternal = VLFFTbuffers->pInBufInternal;
 	pOutBufInternal = VLFFTbuffers->pOutBufInternal;
 	pWorkBuf0Internal = VLFFTbuffers->pWorkBuf0Internal;
@@ -183,44 +185,43 @@ void VLFFT_2ndIter( float          *pIn,
 
 
 		/***********************************************************/
-		/*                         transpose                       */
+		/*   compute FFT: the DSPLIB kernels one column at a time  */
+		/*   between transposes, or the batched kernel on all of   */
+		/*   them in place, putting the bit-reversed rows back in  */
+		/*   order for the output (see vlfftconfig.h)              */
 		/***********************************************************/
-		transpose_1( &pInBufInternal[(stepOutSrc)*(blkIdx&0x1)>>2],
-		             &pOutBufInternal[(stepOutSrc*(blkIdx&0x1  ))>>2],
-		             VLFFTparams->N2,
-		             SAMPLES_PER_TRANSFER_BLOCK );
-
-		pfftOut = pWorkBuf0Internal;
-		pfftIn  = &pOutBufInternal[(stepOutSrc*(blkIdx&0x1  ))>>2];
-		if( VLFFTparams->radix_2ndIter == 4 ) {
-			DSPF_sp_radix4_fftSPxSP( fftSize, &pfftIn[fftSize2*0], &pW2[0], &pfftOut[fftSize2*0], VLFFTparams->log4N_2ndIter );
-			DSPF_sp_radix4_fftSPxSP( fftSize, &pfftIn[fftSize2*1], &pW2[0], &pfftOut[fftSize2*1], VLFFTparams->log4N_2ndIter );
-			DSPF_sp_radix4_fftSPxSP( fftSize, &pfftIn[fftSize2*2], &pW2[0], &pfftOut[fftSize2*2], VLFFTparams->log4N_2ndIter );
-			DSPF_sp_radix4_fftSPxSP( fftSize, &pfftIn[fftSize2*3], &pW2[0], &pfftOut[fftSize2*3], VLFFTparams->log4N_2ndIter );
-			DSPF_sp_radix4_fftSPxSP( fftSize, &pfftIn[fftSize2*4], &pW2[0], &pfftOut[fftSize2*4], VLFFTparams->log4N_2ndIter );
-			DSPF_sp_radix4_fftSPxSP( fftSize, &pfftIn[fftSize2*5], &pW2[0], &pfftOut[fftSize2*5], VLFFTparams->log4N_2ndIter );
-			DSPF_sp_radix4_fftSPxSP( fftSize, &pfftIn[fftSize2*6], &pW2[0], &pfftOut[fftSize2*6], VLFFTparams->log4N_2ndIter );
-			DSPF_sp_radix4_fftSPxSP( fftSize, &pfftIn[fftSize2*7], &pW2[0], &pfftOut[fftSize2*7], VLFFTparams->log4N_2ndIter );
+		if( !VLFFT_DSP_BATCH_FFT && VLFFTparams->radix_2ndIter != VLFFT_RADIX_MIXED ) {
+			transpose_1( &pInBufInternal[(stepOutSrc)*(blkIdx&0x1)>>2],
+			             &pOutBufInternal[(stepOutSrc*(blkIdx&0x1  ))>>2],
+			             VLFFTparams->N2,
+			             SAMPLES_PER_TRANSFER_BLOCK );
+
+			pfftOut = pWorkBuf0Internal;
+			pfftIn  = &pOutBufInternal[(stepOutSrc*(blkIdx&0x1  ))>>2];
+			for( fftIdx=0; fftIdx<VLFFTparams->numFFTsPerBlock2ndIter; fftIdx++ )
+				vlfftColumnFFT( fftSize, VLFFTparams->radix_2ndIter, VLFFTparams->log4N_2ndIter, VLFFTparams->direction, VLFFTparams->scale,
+				                pW2, &pfftIn[fftSize2*fftIdx], &pfftOut[fftSize2*fftIdx] );
+
+			/***********************************************************/
+			/*                         transpose                       */
+			/***********************************************************/
+			transpose_2( pWorkBuf0Internal,
+			             &pOutBufInternal[(stepOutSrc*(blkIdx&0x1  ))>>2],
+			             SAMPLES_PER_TRANSFER_BLOCK,
+			             VLFFTparams->N2 );
 		} else {
-			DSPF_sp_mixedRadix_fftSPxSP( fftSize, &pfftIn[fftSize2*0], &pW2[0], &pfftOut[fftSize2*0] );
-			DSPF_sp_mixedRadix_fftSPxSP( fftSize, &pfftIn[fftSize2*1], &pW2[0], &pfftOut[fftSize2*1] );
-			DSPF_sp_mixedRadix_fftSPxSP( fftSize, &pfftIn[fftSize2*2], &pW2[0], &pfftOut[fftSize2*2] );
-			DSPF_sp_mixedRadix_fftSPxSP( fftSize, &pfftIn[fftSize2*3], &pW2[0], &pfftOut[fftSize2*3] );
-			DSPF_sp_mixedRadix_fftSPxSP( fftSize, &pfftIn[fftSize2*4], &pW2[0], &pfftOut[fftSize2*4] );
-			DSPF_sp_mixedRadix_fftSPxSP( fftSize, &pfftIn[fftSize2*5], &pW2[0], &pfftOut[fftSize2*5] );
-			DSPF_sp_mixedRadix_fftSPxSP( fftSize, &pfftIn[fftSize2*6], &pW2[0], &pfftOut[fftSize2*6] );
-			DSPF_sp_mixedRadix_fftSPxSP( fftSize, &pfftIn[fftSize2*7], &pW2[0], &pfftOut[fftSize2*7] );
+			pfftIn  = &pInBufInternal[(stepOutSrc*(blkIdx&0x1))>>2];
+			if( VLFFTparams->radix_2ndIter == VLFFT_RADIX_MIXED ) {
+				vlfftBatchMixedFFT( fftSize, VLFFTparams->numFFTsPerBlock2ndIter, pfftIn,
+				                    &pOutBufInternal[(stepOutSrc*(blkIdx&0x1))>>2], pW2, VLFFTparams->direction, VLFFTparams->scale );
+			} else {
+				vlfftBatchFFTStages( fftSize, VLFFTparams->numFFTsPerBlock2ndIter, pfftIn, pW2, VLFFTparams->direction,
+				                     VLFFTparams->stages_2ndIter );
+				vlfftBatchFFTRows( fftSize, VLFFTparams->numFFTsPerBlock2ndIter, pfftIn,
+				                   &pOutBufInternal[(stepOutSrc*(blkIdx&0x1))>>2], VLFFTparams->scale );
+			}
 		}
 
-
-		/***********************************************************/
-		/*                         transpose                       */
-		/***********************************************************/
-		transpose_2( pWorkBuf0Internal,
-		             &pOutBufInternal[(stepOutSrc*(blkIdx&0x1  ))>>2],
-		             SAMPLES_PER_TRANSFER_BLOCK,
-		             VLFFTparams->N2 );
-
 		edmaPoll(    hEdma, DMAparams->tcc1  );
 
 		inIndex += 1;